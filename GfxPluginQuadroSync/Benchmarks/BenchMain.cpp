@@ -0,0 +1,34 @@
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+// Runs every registered benchmark (or only the ones whose name contains the first command line argument) and
+// reports the average time per iteration.  Second command line argument is the number of iterations.
+int main(int argc, char* argv[])
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    const uint64_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    for (const auto& benchmark: QuadroSyncBench::GetBenchmarks())
+    {
+        if (filter && std::strstr(benchmark.name, filter) == nullptr)
+        {
+            continue;
+        }
+
+        // Small warm-up run before the measured one
+        QuadroSyncBench::State warmupState(iterations / 10 + 1);
+        benchmark.function(warmupState);
+
+        QuadroSyncBench::State state(iterations);
+        benchmark.function(state);
+
+        const auto elapsedNs = std::chrono::duration<double, std::nano>(state.GetElapsed()).count();
+        std::cout << std::left << std::setw(48) << benchmark.name << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(1) << elapsedNs / static_cast<double>(iterations) << " ns/iteration"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/**
+ * \brief Minimal self-registering benchmark harness used by quadrosync_bench.
+ *
+ * Benchmarks are declared with BENCHMARK(Name)(QuadroSyncBench::State& state) { ... } and must execute the measured
+ * operation state.iterations times, between state.Start() and state.Stop().
+ */
+namespace QuadroSyncBench
+{
+    class State
+    {
+    public:
+        explicit State(const uint64_t iterationCount) : iterations(iterationCount) {}
+
+        void Start() { m_Start = std::chrono::steady_clock::now(); }
+        void Stop() { m_Elapsed += std::chrono::steady_clock::now() - m_Start; }
+
+        std::chrono::steady_clock::duration GetElapsed() const { return m_Elapsed; }
+
+        const uint64_t iterations;
+
+    private:
+        std::chrono::steady_clock::time_point m_Start;
+        std::chrono::steady_clock::duration m_Elapsed{0};
+    };
+
+    struct Benchmark
+    {
+        const char* name;
+        void (*function)(State&);
+    };
+
+    inline std::vector<Benchmark>& GetBenchmarks()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(const char* name, void (*function)(State&))
+        {
+            GetBenchmarks().push_back({name, function});
+        }
+    };
+
+    /// Prevents the compiler from optimizing away the computation of \a value.
+    template <class T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define QUADROSYNC_BENCH_CONCAT_INNER(a, b) a##b
+#define QUADROSYNC_BENCH_CONCAT(a, b) QUADROSYNC_BENCH_CONCAT_INNER(a, b)
+
+#define BENCHMARK(name)                                                                                                \
+    static void name(QuadroSyncBench::State& state);                                                                   \
+    static QuadroSyncBench::BenchmarkRegistrar QUADROSYNC_BENCH_CONCAT(s_Registrar, name)(#name, &name);               \
+    static void name
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include "FakeUnknown.h"
+
+#include "ComPtr.h"
+
+#include <memory>
+#include <thread>
+#include <utility>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::FakeUnknown;
+
+namespace
+{
+    /// Copy of the std::shared_ptr based wrapper ComPtr replaced (including its move constructor that copies), to
+    /// compare against.
+    template <class T>
+    class ComSharedPtr final : public std::shared_ptr<T>
+    {
+    public:
+        ComSharedPtr() = default;
+        explicit ComSharedPtr(T* const ptr)
+            : std::shared_ptr<T>(ptr, [](T* const toRelease) { if (toRelease) toRelease->Release(); }) {}
+        ComSharedPtr(const ComSharedPtr& toCopy) : std::shared_ptr<T>(toCopy) {}
+        ComSharedPtr(ComSharedPtr&& toMove) noexcept : std::shared_ptr<T>(toMove) {}
+
+        ComSharedPtr& operator=(const ComSharedPtr& toCopy) noexcept
+        {
+            std::shared_ptr<T>::operator=(toCopy);
+            return *this;
+        }
+
+        ComSharedPtr& operator=(ComSharedPtr&& toMove) noexcept
+        {
+            std::shared_ptr<T>::operator=(std::move(toMove));
+            return *this;
+        }
+    };
+
+    /// libstdc++ uses non atomic reference counts in std::shared_ptr until a second thread is started, which is never
+    /// the case in Unity.
+    void EnsureMultiThreaded()
+    {
+        static const bool s_ThreadStarted = []
+        {
+            std::thread([] {}).join();
+            return true;
+        }();
+        QuadroSyncBench::DoNotOptimize(s_ThreadStarted);
+    }
+
+    template <class T>
+    ComSharedPtr<T> MakeComSharedPtr(T* const object)
+    {
+        EnsureMultiThreaded();
+        object->AddRef();
+        return ComSharedPtr<T>(object);
+    }
+
+    template <class T>
+    ComPtr<T> MakeComPtr(T* const object)
+    {
+        object->AddRef();
+        return ComPtr<T>::Adopt(object);
+    }
+}
+
+// Wrapping a reference returned by a Create / Get method and releasing it (what warmup and device setup do).
+BENCHMARK(ComPtr_AdoptRelease)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        auto ptr = MakeComPtr(&object);
+        QuadroSyncBench::DoNotOptimize(ptr);
+    }
+    state.Stop();
+}
+
+BENCHMARK(ComSharedPtr_AdoptRelease)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        auto ptr = MakeComSharedPtr(&object);
+        QuadroSyncBench::DoNotOptimize(ptr);
+    }
+    state.Stop();
+}
+
+// Moving a pointer back and forth (returning from a helper, growing a vector, ...).
+BENCHMARK(ComPtr_Move)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+    auto first = MakeComPtr(&object);
+    ComPtr<FakeUnknown> second;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        second = std::move(first);
+        first = std::move(second);
+        QuadroSyncBench::DoNotOptimize(first);
+    }
+    state.Stop();
+}
+
+BENCHMARK(ComSharedPtr_Move)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+    auto first = MakeComSharedPtr(&object);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        ComSharedPtr<FakeUnknown> second(std::move(first));
+        first = ComSharedPtr<FakeUnknown>(std::move(second));
+        QuadroSyncBench::DoNotOptimize(first);
+    }
+    state.Stop();
+}
+
+// Copying a pointer (one more reference on the object, explicit with ComPtr).
+BENCHMARK(ComPtr_Copy)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+    auto ptr = MakeComPtr(&object);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        auto copy = ComPtr<FakeUnknown>::Retain(ptr.get());
+        QuadroSyncBench::DoNotOptimize(copy);
+    }
+    state.Stop();
+}
+
+BENCHMARK(ComSharedPtr_Copy)(QuadroSyncBench::State& state)
+{
+    FakeUnknown object;
+    auto ptr = MakeComSharedPtr(&object);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        auto copy = ptr;
+        QuadroSyncBench::DoNotOptimize(copy);
+    }
+    state.Stop();
+}
@@ -0,0 +1,62 @@
+#include "Benchmark.h"
+
+#include "Logger.h"
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    void UNITY_INTERFACE_API IgnoreMessage(int, const char*)
+    {
+    }
+}
+
+// Cost of a CLUSTER_LOG for the thread producing it (messages are delivered by the drain thread).
+BENCHMARK(Logger_ClusterLog)(QuadroSyncBench::State& state)
+{
+    Logger::Instance().SetDeliveryMode(LogDeliveryMode::DrainThread);
+    Logger::Instance().SetManagedCallback(&IgnoreMessage);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        CLUSTER_LOG(Warmup) << "Barrier warmup, repeat " << i << " of frame " << 1234;
+    }
+    state.Stop();
+
+    Logger::Instance().SetManagedCallback(nullptr);
+}
+
+// Same as Logger_ClusterLog but with deferred formatting (and rate limiting disabled).
+BENCHMARK(Logger_ClusterLogF)(QuadroSyncBench::State& state)
+{
+    Logger::Instance().SetDeliveryMode(LogDeliveryMode::DrainThread);
+    Logger::Instance().SetManagedCallback(&IgnoreMessage);
+    Logger::Instance().SetRateLimit(0, LogRateLimiter::k_DefaultPeriodSeconds);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        CLUSTER_LOGF(Warmup, "Barrier warmup, repeat {} of frame {}", i, 1234);
+    }
+    state.Stop();
+
+    Logger::Instance().SetManagedCallback(nullptr);
+    Logger::Instance().SetRateLimit(LogRateLimiter::k_DefaultBurst, LogRateLimiter::k_DefaultPeriodSeconds);
+}
+
+// Cost of a CLUSTER_LOGF suppressed by the rate limiting (a present failing every frame).
+BENCHMARK(Logger_ClusterLogFSuppressed)(QuadroSyncBench::State& state)
+{
+    Logger::Instance().SetDeliveryMode(LogDeliveryMode::DrainThread);
+    Logger::Instance().SetManagedCallback(&IgnoreMessage);
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        CLUSTER_LOGF_ERROR(Present, "NvAPI_D3D1x_Present failed: {}", NVAPI_ERROR);
+    }
+    state.Stop();
+
+    Logger::Instance().SetManagedCallback(nullptr);
+}
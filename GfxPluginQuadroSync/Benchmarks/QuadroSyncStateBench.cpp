@@ -0,0 +1,32 @@
+#include "Benchmark.h"
+
+#include "QuadroSyncState.h"
+
+using namespace GfxQuadroSync;
+
+// Reading the state from the mirror (what managed code does every frame instead of calling GetState).
+BENCHMARK(QuadroSyncStateMirror_Read)(QuadroSyncBench::State& state)
+{
+    QuadroSyncStateMirror mirror;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        const auto read = mirror.Read();
+        QuadroSyncBench::DoNotOptimize(read);
+    }
+    state.Stop();
+}
+
+// Publishing the state (what the plugin does after every present).
+BENCHMARK(QuadroSyncStateMirror_Publish)(QuadroSyncBench::State& state)
+{
+    QuadroSyncStateMirror mirror;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        mirror.Update([i](QuadroSyncState& toModify) { toModify.presentedFramesSuccess = i; });
+    }
+    state.Stop();
+}
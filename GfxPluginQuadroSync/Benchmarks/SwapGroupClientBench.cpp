@@ -0,0 +1,62 @@
+#include "Benchmark.h"
+#include "SimulatedClient.h"
+
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::SimulatedClient;
+
+BENCHMARK(SwapGroupClient_Render)(QuadroSyncBench::State& state)
+{
+    SimulatedClient bench;
+    bench.InitializeAndWarmUp();
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        QuadroSyncBench::DoNotOptimize(bench.client->Render(&bench.device));
+    }
+    state.Stop();
+}
+
+BENCHMARK(SwapGroupClient_QueryFrameCount)(QuadroSyncBench::State& state)
+{
+    SimulatedClient bench;
+    bench.Initialize();
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        QuadroSyncBench::DoNotOptimize(bench.client->QueryFrameCount(bench.device.GetDevice()));
+    }
+    state.Stop();
+}
+
+BENCHMARK(SwapGroupClient_QueryFrameCountEstimate)(QuadroSyncBench::State& state)
+{
+    SimulatedClient bench;
+    bench.Initialize();
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        QuadroSyncBench::DoNotOptimize(bench.client->QueryFrameCountEstimate(bench.device.GetDevice()).frameCount);
+    }
+    state.Stop();
+}
+
+BENCHMARK(PresentTimingRing_Push)(QuadroSyncBench::State& state)
+{
+    auto ring = std::make_unique<PresentTimingRing>();
+    PresentTiming timing;
+
+    state.Start();
+    for (uint64_t i = 0; i < state.iterations; ++i)
+    {
+        timing.presentStartTick = i;
+        ring->Push(timing);
+    }
+    state.Stop();
+    QuadroSyncBench::DoNotOptimize(ring->GetWriteIndex());
+}
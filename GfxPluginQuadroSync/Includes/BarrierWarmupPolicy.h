@@ -0,0 +1,113 @@
+#pragma once
+
+#include "SeqLock.h"
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// Outcome of a barrier warmup done by BarrierWarmupPolicy.
+    enum class BarrierWarmupOutcome : uint32_t
+    {
+        /// No warmup done by the native policy (never started or done by the managed callback).
+        None = 0,
+        /// Presents are being repeated.
+        InProgress = 1,
+        /// Frame counter and present interval stabilized.
+        Converged = 2,
+        /// Maximum number of presents reached without stabilizing (warmup was concluded anyway).
+        GaveUp = 3,
+    };
+
+    /**
+     * \brief Progress and outcome of the last barrier warmup done by BarrierWarmupPolicy.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncBarrierWarmupReport
+     *         in GfxPluginQuadroSyncState.cs.
+     */
+    struct BarrierWarmupReport
+    {
+        /// BarrierWarmupOutcome
+        uint32_t outcome = 0;
+        /// Number of presents done (including the first one, that is not a repeat).
+        uint32_t presentCount = 0;
+        /// Number of consecutive stable presents at the end of the warmup (or so far).
+        uint32_t stablePresentCount = 0;
+        uint32_t padding = 0;
+        /// Performance counter tick at which the first present returned.
+        uint64_t startTick = 0;
+        /// Performance counter tick at which the last present returned.
+        uint64_t endTick = 0;
+        /// Average present interval (in performance counter ticks) of the stable presents (0 if none).
+        double presentIntervalTicks = 0;
+    };
+
+    /// Lock-free publication of BarrierWarmupReport.
+    typedef SeqLock<BarrierWarmupReport> BarrierWarmupReportMirror;
+
+    /**
+     * \brief Decides when the swap barrier is warmed up from the presents themselves, without asking managed code.
+     *
+     * Once the barrier is up, every present is paced by it: the hardware frame counter advances by one frame per
+     * present and presents return at a steady interval.  Presents are repeated until that is the case for a number of
+     * consecutive presents (within configurable tolerances) or until a maximum number of presents is reached.
+     *
+     * \remark Not thread safe, expected to be used from the thread presenting frames (the rendering thread).
+     */
+    class BarrierWarmupPolicy final
+    {
+    public:
+        /**
+         * \brief Tolerances of the policy.
+         *
+         * \remark Any change to this struct must be matched in
+         *         Unity.ClusterDisplay.GfxPluginQuadroSyncBarrierWarmupSettings in GfxPluginQuadroSyncState.cs.
+         */
+        struct Settings
+        {
+            /// Number of consecutive stable presents after which the barrier is warmed up.
+            uint32_t stablePresents = 8;
+            /// Number of presents after which we give up (and conclude the warmup anyway).
+            uint32_t maxPresents = 600;
+            /// Maximum deviation of a present interval from the average interval of the stable presents (as a
+            /// fraction of the average).
+            double intervalTolerance = 0.1;
+            /// Maximum deviation of the number of frames between two presents from one frame.
+            uint32_t frameCountTolerance = 0;
+            uint32_t padding = 0;
+        };
+
+        enum class Decision
+        {
+            RepeatPresent,
+            Converged,
+            GaveUp,
+        };
+
+        /// Starts a new warmup.
+        void Start(const Settings& settings);
+
+        /**
+         * Processes the result of a present.
+         *
+         * \param[in] presentEndTick Performance counter tick at which the present returned.
+         * \param[in] hasFrameCount Was the hardware frame counter sampled after the present (frames are not checked
+         *                          otherwise).
+         * \param[in] frameCount Hardware frame counter sampled after the present.
+         *
+         * \return What to do next.
+         */
+        Decision OnPresent(uint64_t presentEndTick, bool hasFrameCount, uint64_t frameCount);
+
+        const BarrierWarmupReport& GetReport() const { return m_Report; }
+
+    private:
+        Settings m_Settings;
+        BarrierWarmupReport m_Report;
+        uint64_t m_PreviousPresentEndTick = 0;
+        bool m_HasPreviousFrameCount = false;
+        uint64_t m_PreviousFrameCount = 0;
+        /// Sum of the intervals of the current stable presents.
+        uint64_t m_StableIntervalsTicks = 0;
+    };
+}
@@ -2,66 +2,10 @@
 
 #include <Windows.h>
 
-#include <functional>
-#include <memory>
-
-struct IUnknown;
+#include <utility>
 
 namespace GfxQuadroSync
 {
-    /**
-     * \brief Helper to make management of COM objects (IUnknown) easier.
-     *
-     * \remark Constructor from raw T* and reset method will "adopt" the pointer, in other words it will not call
-     *         AddRef on it.  Caller must manually call AddRef on the raw T* if it keep on using it (and eventually 
-     *         call Release on it).
-     */
-    template <class T>
-    class ComSharedPtr final : public std::shared_ptr<T>
-    {
-    public:
-        ComSharedPtr() = default;
-        explicit ComSharedPtr(T* const ptr)
-            : std::shared_ptr<T>(ptr, [](T* const toRelease) { if (toRelease) toRelease->Release(); }) {}
-        ComSharedPtr(const ComSharedPtr& toCopy) : std::shared_ptr<T>(toCopy) {}
-        ComSharedPtr(ComSharedPtr&& toMove) noexcept : std::shared_ptr<T>(toMove) {}
-
-        ComSharedPtr& operator=(const ComSharedPtr& toCopy) noexcept
-        {
-            std::shared_ptr<T>::operator=(toCopy);
-            return *this;
-        }
-
-        template <class T2, std::enable_if_t<std::_SP_pointer_compatible<T2, T>::value, int> = 0>
-        ComSharedPtr& operator=(const shared_ptr<T2>& toCopy) noexcept
-        {
-            std::shared_ptr<T>::operator=(toCopy);
-            return *this;
-        }
-
-        ComSharedPtr& operator=(ComSharedPtr&& toMove) noexcept
-        {
-            std::shared_ptr<T>::operator=(std::move(toMove));
-            return *this;
-        }
-
-        template <class T2, std::enable_if_t<std::_SP_pointer_compatible<T2, T>::value, int> = 0>
-        shared_ptr& operator=(shared_ptr<T2>&& toMove) noexcept
-        {
-            std::shared_ptr<T>::operator=(std::move(toMove));
-            return *this;
-        }
-
-        void reset()
-        {
-            std::shared_ptr<T>::reset();
-        }
-        void reset(T* const ptr)
-        {
-            ComSharedPtr(ptr).swap(*this);
-        }
-    };
-
     /**
      * \brief Helper class that automatically release a Win32 HANDLE.
      *
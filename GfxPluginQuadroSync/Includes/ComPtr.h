@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Smart pointer to a COM object (anything with AddRef and Release methods) holding one reference on it.
+     *
+     * Intrusive: only uses the reference count of the object itself (no allocation, no extra atomic operations).
+     * Move-only: moving transfers the reference, adding one has to be explicit (Retain(other.get())).
+     *
+     * \remark Raw pointers are never converted implicitly, the reference is either adopted (Adopt, Attach: the caller
+     *         gives its reference, typically one returned by a Create or Get method) or added (Retain: the caller keeps
+     *         its reference).
+     */
+    template <class T>
+    class ComPtr final
+    {
+    public:
+        ComPtr() = default;
+        ComPtr(std::nullptr_t) noexcept {}
+        ComPtr(const ComPtr&) = delete;
+        ComPtr(ComPtr&& toMove) noexcept : m_Ptr(toMove.m_Ptr) { toMove.m_Ptr = nullptr; }
+
+        ~ComPtr()
+        {
+            InternalRelease();
+        }
+
+        ComPtr& operator=(const ComPtr&) = delete;
+
+        ComPtr& operator=(ComPtr&& toMove) noexcept
+        {
+            ComPtr(std::move(toMove)).swap(*this);
+            return *this;
+        }
+
+        ComPtr& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        /// Returns a ComPtr taking ownership of the caller's reference on \a ptr (no AddRef).
+        static ComPtr Adopt(T* const ptr) noexcept
+        {
+            ComPtr adopted;
+            adopted.m_Ptr = ptr;
+            return adopted;
+        }
+
+        /// Returns a ComPtr adding its own reference on \a ptr (the caller keeps its reference).
+        static ComPtr Retain(T* const ptr) noexcept
+        {
+            ComPtr retained;
+            retained.m_Ptr = ptr;
+            retained.InternalAddRef();
+            return retained;
+        }
+
+        /// Releases the current object and takes ownership of the caller's reference on \a ptr (no AddRef).
+        void Attach(T* const ptr) noexcept
+        {
+            InternalRelease();
+            m_Ptr = ptr;
+        }
+
+        /// Gives the reference to the caller (that becomes responsible of calling Release) and becomes empty.
+        T* Detach() noexcept
+        {
+            T* const ptr = m_Ptr;
+            m_Ptr = nullptr;
+            return ptr;
+        }
+
+        /// Releases the current object and returns the address of the pointer, for methods returning a new reference
+        /// through a T** (or void**) out parameter.
+        T** ReleaseAndGetAddressOf() noexcept
+        {
+            reset();
+            return &m_Ptr;
+        }
+
+        void reset() noexcept
+        {
+            InternalRelease();
+            m_Ptr = nullptr;
+        }
+
+        void swap(ComPtr& other) noexcept { std::swap(m_Ptr, other.m_Ptr); }
+
+        T* get() const noexcept { return m_Ptr; }
+        T* operator->() const noexcept { return m_Ptr; }
+        T& operator*() const noexcept { return *m_Ptr; }
+        explicit operator bool() const noexcept { return m_Ptr != nullptr; }
+
+        bool operator==(const ComPtr& other) const noexcept { return m_Ptr == other.m_Ptr; }
+        bool operator!=(const ComPtr& other) const noexcept { return m_Ptr != other.m_Ptr; }
+        bool operator==(std::nullptr_t) const noexcept { return m_Ptr == nullptr; }
+        bool operator!=(std::nullptr_t) const noexcept { return m_Ptr != nullptr; }
+
+    private:
+        void InternalAddRef() const noexcept
+        {
+            if (m_Ptr)
+            {
+                m_Ptr->AddRef();
+            }
+        }
+
+        void InternalRelease() noexcept
+        {
+            if (m_Ptr)
+            {
+                m_Ptr->Release();
+            }
+        }
+
+        T* m_Ptr = nullptr;
+    };
+}
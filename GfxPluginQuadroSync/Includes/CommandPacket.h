@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace GfxQuadroSync
+{
+    /// Status of a QuadroSyncCommand (written once the command packet is executed).
+    enum class CommandStatus : uint32_t
+    {
+        /// Not executed yet.
+        Pending = 0,
+        Succeeded = 1,
+        Failed = 2,
+        /// Command identifier unknown to the plugin (or not allowed in a command packet).
+        UnknownCommand = 3,
+        /// Not executed because a previous command failed (with CommandPacketFlags::StopOnFailure).
+        Skipped = 4,
+    };
+
+    /// Flags of a command packet (combined in CommandPacketHeader::flags).
+    enum class CommandPacketFlags : uint32_t
+    {
+        None = 0,
+        /// Skip the commands following a failed command.
+        StopOnFailure = 1 << 0,
+    };
+
+    /**
+     * \brief One command of a command packet.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.QuadroSyncCommandPacket in
+     *         QuadroSyncCommandPacket.cs.
+     */
+    struct QuadroSyncCommand
+    {
+        /// Identifier of the command (EQuadroSyncRenderEvent).
+        uint32_t id;
+        /// CommandStatus (not using CommandStatus for safer interop with managed code).
+        uint32_t status;
+        /// Argument of the command (boolean commands: 0 for false, anything else for true).
+        uint64_t argument;
+        /// Result of the command (for commands producing one, like QuadroSyncQueryFrameCount).
+        int64_t result;
+    };
+    static_assert(sizeof(QuadroSyncCommand) == 24, "QuadroSyncCommand is shared with managed code");
+
+    /**
+     * \brief Header of a command packet: a contiguous buffer made of this header immediately followed by commandCount
+     *        QuadroSyncCommand, executed in order in a single render event.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.QuadroSyncCommandPacket in
+     *         QuadroSyncCommandPacket.cs.
+     */
+    struct CommandPacketHeader
+    {
+        /// Current version of the command packet format.
+        static constexpr uint32_t k_Version = 1;
+        /// Maximum number of commands in a packet.
+        static constexpr uint32_t k_MaxCommandCount = 1024;
+        /// Value of processedCount while the packet has not been processed.
+        static constexpr uint32_t k_NotProcessed = ~uint32_t(0);
+
+        /// Version of the command packet format.
+        uint32_t version;
+        /// Combination of CommandPacketFlags.
+        uint32_t flags;
+        /// Number of QuadroSyncCommand following the header.
+        uint32_t commandCount;
+        /// Set to k_NotProcessed by the owner of the packet before sending it, set by the plugin to the number of
+        /// commands processed once every command has its status (0 if the packet is invalid).
+        std::atomic<uint32_t> processedCount;
+
+        QuadroSyncCommand* GetCommands() { return reinterpret_cast<QuadroSyncCommand*>(this + 1); }
+    };
+    static_assert(sizeof(CommandPacketHeader) == 16, "CommandPacketHeader is shared with managed code");
+
+    /// Function executing one command of a command packet.
+    typedef std::function<CommandStatus(uint32_t id, uint64_t argument, int64_t& result)> CommandHandler;
+
+    /**
+     * Executes the commands of a packet in order, storing their status and result.
+     *
+     * \param[in,out] packet Packet to execute.
+     * \param[in] handler Function executing each command.
+     *
+     * \return False if the packet is invalid (unsupported version or too many commands), no command is then executed.
+     */
+    bool ExecuteCommandPacket(CommandPacketHeader* packet, const CommandHandler& handler);
+}
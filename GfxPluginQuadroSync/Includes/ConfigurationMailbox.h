@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Lock-free mailbox in which any thread posts changes to boolean settings, to be applied later by the thread
+     *        owning them.
+     *
+     * Changes are merged in a single 64 bits word: the epoch of the last post in the high 32 bits and 2 bits per
+     * setting in the low 32 bits (high bit: setting changed, low bit: new value).  A setting changed by multiple posts
+     * before being applied takes the value of the last post.  The owner takes every pending change at once (applying
+     * them in the order of its choice), then marks the epoch it took as applied, so that posters can know when their
+     * change (or a later one superseding it) is in effect.
+     *
+     * \remark Post and Take are a few atomic operations, without any lock.
+     */
+    class ConfigurationMailbox final
+    {
+    public:
+        /// Maximum number of settings.
+        static constexpr uint32_t k_MaxSettings = 16;
+
+        /// Returns the changes to pass to Post to set setting \a index (< k_MaxSettings) to \a value.
+        static uint32_t Change(const uint32_t index, const bool value)
+        {
+            return (value ? 3u : 2u) << (index * 2);
+        }
+
+        /**
+         * Gets the value of a setting in changes returned by Take.
+         *
+         * \return False if the setting is not part of the changes (\a value is then left untouched).
+         */
+        static bool GetChange(const uint32_t changes, const uint32_t index, bool& value)
+        {
+            const auto settingBits = (changes >> (index * 2)) & 3u;
+            if ((settingBits & 2u) == 0)
+            {
+                return false;
+            }
+            value = (settingBits & 1u) != 0;
+            return true;
+        }
+
+        /**
+         * Posts changes (combination of values returned by Change).
+         *
+         * \return Epoch of the post (compare it with GetAppliedEpoch to know when the changes are applied).
+         */
+        uint32_t Post(uint32_t changes);
+
+        /// Are there changes posted that have not yet been taken.
+        bool HasPending() const
+        {
+            return (m_Pending.load(std::memory_order_relaxed) & k_ChangesMask) != 0;
+        }
+
+        /**
+         * Takes every pending change (to be called by the thread owning the settings).
+         *
+         * \param[out] epoch Epoch of the last post included in the returned changes (to be passed to SetAppliedEpoch
+         *                   once they are applied).
+         *
+         * \return Changes to apply (0 if none).
+         */
+        uint32_t Take(uint32_t& epoch);
+
+        /// Marks every change up to \a epoch as applied.
+        void SetAppliedEpoch(const uint32_t epoch) { m_AppliedEpoch.store(epoch, std::memory_order_release); }
+
+        /// Epoch of the last post.
+        uint32_t GetPostedEpoch() const
+        {
+            return static_cast<uint32_t>(m_Pending.load(std::memory_order_acquire) >> 32);
+        }
+
+        /// Epoch up to which every post is applied.
+        uint32_t GetAppliedEpoch() const { return m_AppliedEpoch.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr uint64_t k_ChangesMask = 0xFFFFFFFF;
+
+        /// Epoch of the last post (high 32 bits) and changes not yet taken (low 32 bits).
+        std::atomic<uint64_t> m_Pending{0};
+        std::atomic<uint32_t> m_AppliedEpoch{0};
+    };
+}
@@ -3,7 +3,7 @@
 #include "d3d11.h"
 #include "dxgi.h"
 #include "IGraphicsDevice.h"
-#include "ComHelpers.h"
+#include "ComPtr.h"
 
 namespace GfxQuadroSync
 {
@@ -22,25 +22,60 @@ namespace GfxQuadroSync
 
         IUnknown*       GetDevice() const override { return m_D3D11Device; }
         IDXGISwapChain* GetSwapChain() const override { return m_SwapChain; }
-        UINT32          GetSyncInterval() const override { return m_SyncInterval; }
-        UINT            GetPresentFlags() const override { return m_PresentFlags; }
+        uint32_t        GetSyncInterval() const override { return m_SyncInterval; }
+        uint32_t        GetPresentFlags() const override { return m_PresentFlags; }
 
-        void SetDevice(IUnknown* const device) override { m_D3D11Device = static_cast<ID3D11Device*>(device); }
+        void SetDevice(IUnknown* const device) override;
         void SetSwapChain(IDXGISwapChain* const swapChain) override { m_SwapChain = swapChain; }
 
+        int32_t GetDeviceRemovedReason() const override;
+
         void InitiatePresentRepeats() override;
         void PrepareSinglePresentRepeat() override;
         void ConcludePresentRepeats() override;
 
     private:
+        /**
+         * \brief Description of the back buffer the cached repeat resources have been created for.
+         */
+        struct RepeatCacheKey
+        {
+            DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+            UINT width = 0;
+            UINT height = 0;
+            UINT arraySize = 0;
+            DXGI_SAMPLE_DESC sampleDesc = {0, 0};
+
+            bool operator==(const RepeatCacheKey& other) const
+            {
+                return format == other.format && width == other.width && height == other.height &&
+                    arraySize == other.arraySize && sampleDesc.Count == other.sampleDesc.Count &&
+                    sampleDesc.Quality == other.sampleDesc.Quality;
+            }
+            bool operator!=(const RepeatCacheKey& other) const { return !(*this == other); }
+        };
+
+        void BuildRepeatCache(const RepeatCacheKey& key);
+        void RecordRepeatCommandList();
+        void ReleaseBackBuffer();
+        void FreeResources();
+
         ID3D11Device* m_D3D11Device;
         IDXGISwapChain* m_SwapChain;
         UINT32 m_SyncInterval;
         UINT m_PresentFlags;
 
-        ComSharedPtr<ID3D11Texture2D> m_BackBufferTexture;
-        ComSharedPtr<ID3D11RenderTargetView> m_BackBufferRenderTargetView;
-        ComSharedPtr<ID3D11Texture2D> m_SavedToPresent;
-        ComSharedPtr<ID3D11DeviceContext> m_DeviceContext;
+        /// Back buffer and what references it (only kept during warmups so that we never prevent resizing the swap
+        /// chain).
+        ComPtr<ID3D11Texture2D> m_BackBufferTexture;
+        ComPtr<ID3D11DeviceContext> m_DeviceContext;
+        /// Copies m_SavedToPresent to the back buffer (recorded once per warmup, executed by every repeat).
+        ComPtr<ID3D11CommandList> m_RepeatCommandList;
+        /// Cached resources, kept between warmups until the back buffer description or the device changes.
+        RepeatCacheKey m_RepeatCacheKey;
+        ComPtr<ID3D11Texture2D> m_SavedToPresent;
+        /// Null if the device does not support deferred contexts (repeats are then copied on the immediate context).
+        ComPtr<ID3D11DeviceContext> m_DeferredContext;
+        bool m_IsRepeating = false;
     };
 }
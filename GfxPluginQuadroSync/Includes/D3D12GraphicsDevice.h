@@ -4,6 +4,7 @@
 #include "dxgi.h"
 #include "IGraphicsDevice.h"
 #include "ComHelpers.h"
+#include "ComPtr.h"
 
 #include <vector>
 
@@ -21,43 +22,89 @@ namespace GfxQuadroSync
             UINT32 interval,
             UINT presentFlags);
 
-        virtual ~D3D12GraphicsDevice() = default;
+        virtual ~D3D12GraphicsDevice();
 
         GraphicsDeviceType GetDeviceType() const override { return GraphicsDeviceType::GRAPHICS_DEVICE_D3D12; }
 
         IUnknown*       GetDevice() const override { return m_D3D12Device.get(); }
         IDXGISwapChain* GetSwapChain() const override;
-        UINT32          GetSyncInterval() const override { return m_SyncInterval; }
-        UINT            GetPresentFlags() const override { return m_PresentFlags; }
+        uint32_t        GetSyncInterval() const override { return m_SyncInterval; }
+        uint32_t        GetPresentFlags() const override { return m_PresentFlags; }
 
         void SetDevice(IUnknown* const device) override;
         void SetSwapChain(IDXGISwapChain* const swapChain) override;
 
+        int32_t GetDeviceRemovedReason() const override;
+
         void InitiatePresentRepeats() override;
         void PrepareSinglePresentRepeat() override;
         void ConcludePresentRepeats() override;
 
     private:
+        /**
+         * \brief Description of the swap chain the cached repeat resources have been created for.
+         */
+        struct RepeatCacheKey
+        {
+            DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+            UINT width = 0;
+            UINT height = 0;
+            UINT bufferCount = 0;
+
+            bool operator==(const RepeatCacheKey& other) const
+            {
+                return format == other.format && width == other.width && height == other.height &&
+                    bufferCount == other.bufferCount;
+            }
+            bool operator!=(const RepeatCacheKey& other) const { return !(*this == other); }
+        };
+
+        /**
+         * \brief Resources used to capture and repeat the saved texture in one of the back buffers.
+         *
+         * \remark There is one slot per back buffer so that repeating in a back buffer only has to wait for the
+         *         previous repeat of that same back buffer (the other ones can still be in flight).
+         * \remark Command lists are recorded once when the cache is built and executed again at every warmup.
+         */
+        struct RepeatSlot
+        {
+            ComPtr<ID3D12CommandAllocator> commandAllocator;
+            /// Copies the back buffer to m_SavedTexture.
+            ComPtr<ID3D12GraphicsCommandList> captureCommandList;
+            /// Copies m_SavedTexture to the back buffer.
+            ComPtr<ID3D12GraphicsCommandList> repeatCommandList;
+            /// Value of m_CommandExecutionDoneFence signaled once the last commands of the slot are executed.
+            UINT64 fenceValue = 0;
+        };
+
         bool IsFenceCreated() const { return m_CommandExecutionDoneFence != nullptr; }
         void EnsureFenceCreated();
-        void QueueUpdateFence();
+        UINT64 QueueUpdateFence();
         void WaitForFence();
+        void WaitForFenceValue(UINT64 value);
+        bool IsRepeatCacheValid(const RepeatCacheKey& key);
+        bool BuildRepeatCache(const RepeatCacheKey& key);
+        void ExecuteSlotCommandList(RepeatSlot& slot, ID3D12GraphicsCommandList* commandList);
         void FreeResources();
 
-        ComSharedPtr<ID3D12Device> m_D3D12Device;
-        ComSharedPtr<IDXGISwapChain3> m_SwapChain;
-        ComSharedPtr<ID3D12CommandQueue> m_CommandQueue;
+        ComPtr<ID3D12Device> m_D3D12Device;
+        ComPtr<IDXGISwapChain3> m_SwapChain;
+        ComPtr<ID3D12CommandQueue> m_CommandQueue;
         UINT32 m_SyncInterval;
         UINT m_PresentFlags;
 
-        ComSharedPtr<ID3D12Fence> m_CommandExecutionDoneFence;
+        ComPtr<ID3D12Fence> m_CommandExecutionDoneFence;
         UINT64 m_CommandExecutionDoneFenceNextValue = 1;
         HandleWrapper m_BarrierReachedEvent;
 
-        std::vector<ComSharedPtr<ID3D12Resource>> m_BackBuffers;
-        ComSharedPtr<ID3D12CommandAllocator> m_CommandAllocator;
-        ComSharedPtr<ID3D12GraphicsCommandList> m_CommandList;
-        ComSharedPtr<ID3D12Resource> m_SavedTexture;
+        /// Back buffers of the swap chain (only kept during warmups so that we never prevent resizing the swap chain).
+        std::vector<ComPtr<ID3D12Resource>> m_BackBuffers;
+        /// Cached resources, kept between warmups until the swap chain changes.
+        RepeatCacheKey m_RepeatCacheKey;
+        UINT64 m_RepeatCacheGeneration = 0;
+        std::vector<RepeatSlot> m_RepeatSlots;
+        ComPtr<ID3D12Resource> m_SavedTexture;
+        bool m_IsRepeating = false;
         UINT m_FirstRepeatBackBufferIndex = -1;
     };
 }
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../External/NvAPI/nvapi_lite_common.h"
+#include "SeqLock.h"
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// How a failed present affects the swap group membership.
+    enum class PresentFailureKind : uint32_t
+    {
+        /// Presenting the next frame is likely to work (swap group membership is still valid).
+        Transient = 0,
+        /// Device was removed (or reset), the swap chain is no longer usable or the swap group membership was lost:
+        /// swap group and barrier have to be joined again once Unity provides a usable device.
+        Fatal = 1,
+    };
+
+    /// State of DeviceRecovery.
+    enum class DeviceRecoveryState : uint32_t
+    {
+        /// Presents are succeeding.
+        Healthy = 0,
+        /// Last presents failed with transient failures (like a barrier waiting on a node that left the cluster).
+        Degraded = 1,
+        /// Waiting for a usable device to join the swap group and barrier again.
+        Lost = 2,
+        /// Swap group and barrier joined again, waiting for the barrier to be warmed up.
+        WarmingUp = 3,
+    };
+
+    /**
+     * \brief Progress of the recovery from failed presents and how long recoveries took.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncDeviceRecoveryReport
+     *         in GfxPluginQuadroSyncState.cs.
+     */
+    struct DeviceRecoveryReport
+    {
+        /// DeviceRecoveryState
+        uint32_t state = 0;
+        /// Number of completed recoveries.
+        uint32_t recoveryCount = 0;
+        /// Number of presents that failed in a row.
+        uint32_t consecutiveFailures = 0;
+        /// NvAPI_Status of the last failed present.
+        int32_t lastFailureStatus = 0;
+        /// HRESULT returned by GetDeviceRemovedReason after the last failed present (0 if the device was usable).
+        int32_t lastDeviceRemovedReason = 0;
+        /// PresentFailureKind of the last failed present.
+        uint32_t lastFailureKind = 0;
+        /// Performance counter tick at which the last recovery started.
+        uint64_t lostTick = 0;
+        /// Performance counter tick at which the last recovery completed (0 if not yet).
+        uint64_t recoveredTick = 0;
+        /// Performance counter ticks the last recovery took (0 if not completed yet).
+        uint64_t lastRecoveryTicks = 0;
+        /// Performance counter ticks all the completed recoveries took.
+        uint64_t totalRecoveryTicks = 0;
+    };
+
+    /// Lock-free publication of DeviceRecoveryReport.
+    typedef SeqLock<DeviceRecoveryReport> DeviceRecoveryReportMirror;
+
+    /**
+     * \brief Decides, from failed presents, when the swap group and barrier have to be joined again and measures how
+     *        long it takes.
+     *
+     * Fatal failures start a recovery right away while transient ones only degrade the state: a barrier failing because
+     * another node left the cluster is not something joining the swap group again would fix.  Once too many transient
+     * failures happened in a row the swap group membership has to be checked (see MembershipCheckDue), a recovery is
+     * only started if it was lost.  A recovery goes through Lost (until the swap group and barrier are joined again)
+     * and WarmingUp (until the barrier is warmed up again).
+     *
+     * \remark Not thread safe, expected to be used from the rendering thread.
+     */
+    class DeviceRecovery final
+    {
+    public:
+        /// Number of transient failures in a row between checks of the swap group membership.
+        static constexpr uint32_t k_TransientFailuresBetweenMembershipChecks = 60;
+
+        /**
+         * Classifies a failed present.
+         *
+         * \param[in] status Status returned by NvAPI_D3D1x_Present.
+         * \param[in] deviceRemovedReason HRESULT returned by GetDeviceRemovedReason of the device that presented.
+         */
+        static PresentFailureKind Classify(NvAPI_Status status, int32_t deviceRemovedReason);
+
+        /**
+         * Processes a failed present.
+         *
+         * \return Must the swap group and barrier be joined again (the state is then Lost).
+         */
+        bool OnPresentFailed(NvAPI_Status status, int32_t deviceRemovedReason, uint64_t tick);
+
+        /// Should the swap group membership be checked (after a run of k_TransientFailuresBetweenMembershipChecks
+        /// transient failures)?
+        bool MembershipCheckDue() const;
+
+        /// Starts a recovery because the swap group membership was lost (the state is then Lost).
+        void MembershipLost(uint64_t tick);
+
+        /// Processes a successful present (ends a Degraded state).
+        void OnPresentSucceeded();
+
+        /// Sets the state to WarmingUp once the swap group and barrier are joined again.
+        void Rejoined();
+
+        /// Completes the recovery (does nothing if not Lost or WarmingUp).
+        void Recovered(uint64_t tick);
+
+        DeviceRecoveryState GetState() const { return static_cast<DeviceRecoveryState>(m_Report.state); }
+        bool IsRecovering() const
+        {
+            return GetState() == DeviceRecoveryState::Lost || GetState() == DeviceRecoveryState::WarmingUp;
+        }
+        const DeviceRecoveryReport& GetReport() const { return m_Report; }
+
+    private:
+        void SetState(DeviceRecoveryState state) { m_Report.state = static_cast<uint32_t>(state); }
+        bool OnFailure(PresentFailureKind kind, int32_t status, int32_t deviceRemovedReason, uint64_t tick);
+        void StartRecovery(uint64_t tick);
+
+        DeviceRecoveryReport m_Report;
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// How much an estimate returned by FrameCountService can be trusted.
+    enum class FrameCountConfidence : uint32_t
+    {
+        /// We never managed to sample the hardware counter, frameCount is meaningless.
+        None = 0,
+        /// Value of the last sample, but we do not know the refresh period yet so we cannot extrapolate.
+        Stale = 1,
+        /// Extrapolated from the last sample using the measured refresh period.
+        Extrapolated = 2,
+        /// Value directly sampled from the hardware counter.
+        Sampled = 3,
+    };
+
+    /// Result of FrameCountService::Estimate.
+    struct FrameCountEstimate
+    {
+        /// Estimated value of the hardware frame counter.
+        uint64_t frameCount = 0;
+        /// Time (in nanoseconds of the performance counter) at which frameCount is valid.
+        uint64_t timestampNs = 0;
+        /// Time (in nanoseconds) elapsed since the hardware counter was last sampled.
+        uint64_t sampleAgeNs = 0;
+        /// Measured refresh period in nanoseconds (0 if not yet measured).
+        uint64_t refreshPeriodNs = 0;
+        /// How much frameCount can be trusted.
+        FrameCountConfidence confidence = FrameCountConfidence::None;
+    };
+
+    /**
+     * \brief Keeps track of the hardware frame counter without querying it every time we need its value.
+     *
+     * Querying the hardware frame counter (NvAPI_D3D1x_QueryFrameCount) is a costly round trip to the driver.  This
+     * class decides when the hardware needs to be sampled (every time for the first few queries and then on a throttled
+     * schedule) and extrapolates the value in between using the performance counter and the refresh period measured
+     * from the samples.
+     *
+     * Typical usage:
+     * \code
+     * const auto now = GetCurrentPerformanceCounterTick();
+     * if (service.ShouldSample(now))
+     * {
+     *     // Query the hardware counter and call AddSample or SampleFailed
+     * }
+     * const auto estimate = service.Estimate(now);
+     * \endcode
+     *
+     * \remark Not thread safe, expected to be used from the thread calling NvAPI (the rendering thread).
+     */
+    class FrameCountService final
+    {
+    public:
+        /// Number of queries that will sample the hardware counter before throttling starts.
+        static constexpr uint32_t k_DefaultSamplesBeforeThrottle = 60; // This is one second at 60 fps...
+        /// Delay (in seconds) between samples once we are throttled.
+        static constexpr uint32_t k_DefaultSecondsBetweenSamples = 1;  // Let's check every second once we are throttled...
+
+        /**
+         * Constructor
+         *
+         * \param[in] ticksPerSecond Frequency of the performance counter used for the ticks given to the other methods.
+         */
+        explicit FrameCountService(uint64_t ticksPerSecond);
+
+        /**
+         * Modify the throttling of the hardware counter sampling.
+         *
+         * \param[in] samplesBeforeThrottle Number of queries that will sample the hardware counter (after construction
+         *                                  or Reset) before throttling starts.
+         * \param[in] ticksBetweenSamples Minimum number of ticks between samples once we are throttled.
+         */
+        void SetThrottling(uint32_t samplesBeforeThrottle, uint64_t ticksBetweenSamples);
+
+        /// Forget everything we know about the hardware counter (to be called when it is reset).
+        void Reset();
+
+        /// Returns if the hardware frame counter should be sampled to answer a query made at \a nowTick.
+        bool ShouldSample(uint64_t nowTick) const;
+
+        /**
+         * Adds a sample of the hardware counter.
+         *
+         * \param[in] beforeTick Performance counter tick just before the hardware counter was queried.
+         * \param[in] afterTick Performance counter tick just after the hardware counter was queried.
+         * \param[in] frameCount Value returned by the hardware.
+         */
+        void AddSample(uint64_t beforeTick, uint64_t afterTick, uint32_t frameCount);
+
+        /// Indicate that sampling the hardware counter failed (so that we do not try again immediately).
+        void SampleFailed(uint64_t tick);
+
+        /// Returns the best estimate we have of the hardware counter at \a nowTick.
+        FrameCountEstimate Estimate(uint64_t nowTick) const;
+
+        /**
+         * Returns what Estimate extrapolates from (so that it can be done later, from another thread).
+         *
+         * \param[out] tick Performance counter tick of the last sample.
+         * \param[out] frameCount Frame count (wrap around corrected) of the last sample.
+         * \param[out] ticksPerFrame Measured refresh period (0 if not yet measured).
+         *
+         * \return False if there is no sample (other parameters are then left untouched).
+         */
+        bool GetLastSample(uint64_t& tick, uint64_t& frameCount, double& ticksPerFrame) const;
+
+    private:
+        uint64_t TicksToNanoseconds(uint64_t ticks) const;
+        double GetTicksPerFrame() const;
+
+        const uint64_t m_TicksPerSecond;
+        uint32_t m_SamplesBeforeThrottle = k_DefaultSamplesBeforeThrottle;
+        uint64_t m_TicksBetweenSamples;
+
+        /// Number of sampling attempts since the last Reset.
+        uint32_t m_SampleAttempts = 0;
+        /// Tick of the last sampling attempt.
+        uint64_t m_LastAttemptTick = 0;
+
+        /// Do we have a valid m_Anchor* and m_Last*?
+        bool m_HasSample = false;
+        /// First sample since last Reset (or since the counter went backward).  Using it with the last sample gives us
+        /// the longest possible baseline to measure the refresh period.
+        uint64_t m_AnchorTick = 0;
+        uint64_t m_AnchorFrameCount = 0;
+        /// Last sample
+        uint64_t m_LastTick = 0;
+        uint64_t m_LastFrameCount = 0;
+        /// Hardware counter is 32 bits, this is what we add to it to produce a 64 bits value when it wraps around.
+        uint64_t m_WrapOffset = 0;
+        uint32_t m_LastHardwareFrameCount = 0;
+    };
+}
@@ -4,6 +4,8 @@
 
 namespace GfxQuadroSync {
 
+    struct CommandPacketHeader;
+
     // Enum defining system callbacks
     enum class EQuadroSyncRenderEvent
     {
@@ -15,7 +17,9 @@ namespace GfxQuadroSync {
         QuadroSyncEnableSwapGroup,
         QuadroSyncEnableSwapBarrier,
         QuadroSyncEnableSyncCounter,
-        QuadroSyncSkipSyncForNextFrame
+        QuadroSyncSkipSyncForNextFrame,
+        QuadroSyncExecuteCommandPacket,
+        QuadroSyncReconfigure
     };
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -68,6 +72,25 @@ namespace GfxQuadroSync {
 
 
 
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  InitializeGraphicsDevice
+    //
+    //! DESCRIPTION:   Create the graphics device (D3D11 or D3D12) wrapping the
+    //!                device and swap chain of Unity (if not already created).
+    //!
+    //! WHEN TO USE:   Use it internally, before initializing the system or after
+    //!                Unity recreated its device (TDR).
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    //! \retval ::true          The graphics device exists
+    //! \retval ::false         The graphic API is not supported
+    ///////////////////////////////////////////////////////////////////////////////
+    bool InitializeGraphicsDevice();
+
+
+
     ///////////////////////////////////////////////////////////////////////////////
     //
     // FUNCTION NAME:  QuadroSyncQueryFrameCount
@@ -216,4 +239,64 @@ namespace GfxQuadroSync {
     ///////////////////////////////////////////////////////////////////////////////
     void QuadroSyncSkipSyncForNextFrame();
 
-}
+
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncExecuteCommandPacket
+    //
+    //! DESCRIPTION:   Execute, in order, every command of a command packet (any
+    //!                other EQuadroSyncRenderEvent with its argument), storing the
+    //!                status and the result of each command in the packet.
+    //!
+    //! WHEN TO USE:   To execute a sequence of commands (for example a
+    //!                reconfiguration) in a single render event.
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    //! \param [in]    packet  Command packet (see CommandPacketHeader), must stay
+    //!                        valid until processedCount is set.
+    ///////////////////////////////////////////////////////////////////////////////
+    void QuadroSyncExecuteCommandPacket(CommandPacketHeader* packet);
+
+
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  QuadroSyncReconfigure
+    //
+    //! DESCRIPTION:   Change the Swap Group and Barrier membership and the frame
+    //!                counter used with as few NvAPI calls as possible, rolling
+    //!                back on failure (see PluginCSwapGroupClient::Reconfigure).
+    //!
+    //! WHEN TO USE:   After the system has been initialized, to change more than
+    //!                one of the Swap Group, Swap Barrier or frame counter at once.
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    //! \param [in]    configuration  Packed SwapGroupConfiguration (see
+    //!                               SwapGroupConfiguration::Unpack).
+    //!
+    //! \retval ::true          The new configuration is in effect
+    //! \retval ::false         Reconfiguration failed (or the context is invalid)
+    ///////////////////////////////////////////////////////////////////////////////
+    bool QuadroSyncReconfigure(uint64_t configuration);
+
+
+
+    ///////////////////////////////////////////////////////////////////////////////
+    //
+    // FUNCTION NAME:  PublishQuadroSyncState
+    //
+    //! DESCRIPTION:   Update the QuadroSyncStateMirror (and the telemetry shared
+    //!                memory, if enabled) with the current state of the plugin.
+    //!
+    //! WHEN TO USE:   Use it internally, after anything changing the state (can be
+    //!                called from any thread).
+    //!
+    //  SUPPORTED GFX: D3D11 & D3D12
+    //!
+    ///////////////////////////////////////////////////////////////////////////////
+    void PublishQuadroSyncState();
+
+}
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstdint>
+
+struct IUnknown;
+struct IDXGISwapChain;
+
 namespace GfxQuadroSync
 {
     enum class GraphicsDeviceType
@@ -21,12 +26,18 @@ namespace GfxQuadroSync
 
         virtual IUnknown* GetDevice() const = 0;
         virtual IDXGISwapChain* GetSwapChain() const = 0;
-        virtual UINT32 GetSyncInterval() const = 0;
-        virtual UINT GetPresentFlags() const = 0;
+        virtual uint32_t GetSyncInterval() const = 0;
+        virtual uint32_t GetPresentFlags() const = 0;
 
         virtual void SetDevice(IUnknown* const device) = 0;
         virtual void SetSwapChain(IDXGISwapChain* const swapChain) = 0;
 
+        /**
+         * HRESULT returned by the GetDeviceRemovedReason method of the device (S_OK (0) while the device is usable,
+         * DXGI_ERROR_DEVICE_REMOVED, DXGI_ERROR_DEVICE_HUNG, ... after a TDR).
+         */
+        virtual int32_t GetDeviceRemovedReason() const = 0;
+
         /**
          * Called before starting a sequence of "additional present" required to warm up the quadro sync barrier.
          */
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../External/NvAPI/nvapi_lite_common.h"
+
+struct IUnknown;
+struct IDXGISwapChain;
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Subset of NvAPI used by PluginCSwapGroupClient to manage swap groups and barriers.
+     *
+     * Every method has the same semantic as the NvAPI function of the same name (NvAPI_D3D1x_JoinSwapGroup for
+     * JoinSwapGroup, ...).  NvApiSwapGroupApi forwards everything to the real NvAPI while SimulatedSwapGroupApi
+     * allows to exercise PluginCSwapGroupClient without Quadro Sync hardware.
+     */
+    class INvSwapGroupApi
+    {
+    public:
+        INvSwapGroupApi() {}
+        virtual ~INvSwapGroupApi() {}
+
+        virtual NvAPI_Status Initialize() = 0;
+
+        virtual NvAPI_Status EnumPhysicalGPUs(NvPhysicalGpuHandle gpuHandles[NVAPI_MAX_PHYSICAL_GPUS],
+            NvU32* gpuCount) = 0;
+        /**
+         * Request (or stop requesting) the use of workstation swap group resources in the driver for a GPU (through
+         * NvAPI_GPU_WorkstationFeatureSetup).
+         */
+        virtual NvAPI_Status SetupWorkstationSwapGroupFeature(NvPhysicalGpuHandle gpuHandle, bool enable) = 0;
+
+        virtual NvAPI_Status QueryMaxSwapGroup(IUnknown* device, NvU32* maxGroups, NvU32* maxBarriers) = 0;
+        virtual NvAPI_Status JoinSwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32 group,
+            bool blocking) = 0;
+        virtual NvAPI_Status BindSwapBarrier(IUnknown* device, NvU32 group, NvU32 barrier) = 0;
+        virtual NvAPI_Status QuerySwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32* group,
+            NvU32* barrier) = 0;
+
+        virtual NvAPI_Status QueryFrameCount(IUnknown* device, NvU32* frameCount) = 0;
+        virtual NvAPI_Status ResetFrameCount(IUnknown* device) = 0;
+
+        virtual NvAPI_Status Present(IUnknown* device, IDXGISwapChain* swapChain, NvU32 syncInterval,
+            NvU32 flags) = 0;
+    };
+}
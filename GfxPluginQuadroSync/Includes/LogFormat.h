@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../External/NvAPI/nvapi_lite_common.h"
+
+namespace GfxQuadroSync
+{
+    /// Type of logging messages (matches managed UnityEngine.LogType)
+    enum class LogType
+    {
+        Error = 0,      ///< Used for Errors.
+        Assert = 1,     ///< Used for Asserts.
+        Warning = 2,    ///< Used for Warnings.
+        Log = 3,        ///< Used for regular log messages.
+        Exception = 4,  ///< Used for Exceptions.
+    };
+
+    /// Severity of log messages.
+    enum class LogLevel : uint32_t
+    {
+        Debug = 0,      ///< Detailed messages only useful when investigating a problem.
+        Info = 1,       ///< Regular log messages.
+        Warning = 2,    ///< Something unexpected that the plugin recovered from.
+        Error = 3,      ///< Something failed.
+        None = 4,       ///< Used as minimum level to disable every message.
+    };
+
+    /// LogType used to deliver messages of the given level.
+    constexpr LogType ToLogType(const LogLevel level)
+    {
+        return level >= LogLevel::Error ? LogType::Error : level == LogLevel::Warning ? LogType::Warning : LogType::Log;
+    }
+
+    /// Subsystem producing log messages (bit of the mask set through Logger::SetCategoryMask).
+    enum class LogCategory : uint32_t
+    {
+        Init = 1 << 0,      ///< Initialization, joining / leaving swap groups and barriers and shutdown.
+        Present = 1 << 1,   ///< Presenting frames.
+        Warmup = 1 << 2,    ///< Swap barrier warmup.
+        Device = 1 << 3,    ///< Graphics device and swap chain.
+        NvApi = 1 << 4,     ///< Result of NvAPI calls.
+        All = (1 << 5) - 1,
+    };
+
+/// Minimum level of log messages compiled in the plugin (see LogLevel), messages with a lower level are stripped.
+#ifndef QUADROSYNC_LOG_MIN_LEVEL
+#define QUADROSYNC_LOG_MIN_LEVEL 0
+#endif
+
+    /// Returns if log messages of the given level are compiled in the plugin (see QUADROSYNC_LOG_MIN_LEVEL).
+    constexpr bool IsLogLevelCompiled(const LogLevel level)
+    {
+        return static_cast<uint32_t>(level) >= QUADROSYNC_LOG_MIN_LEVEL;
+    }
+
+    /**
+     * \brief Static description of a deferred formatting log message (see CLUSTER_LOGF).
+     *
+     * One instance exists for every call site, its address identifies the message in the log records.
+     */
+    struct LogFormat
+    {
+        /// Type of log message.
+        LogType logType;
+        /// Text of the message where every "{}" is replaced by an argument.
+        const char* format;
+        /// Number of "{}" in format.
+        uint32_t argumentCount;
+    };
+
+    /// Type of value stored in a LogArgument (decides how it is formatted).
+    enum class LogArgumentKind : uint32_t
+    {
+        Int,
+        UInt,
+        Double,
+        Bool,
+        HResult,
+        NvApiStatus,
+        /// Pointer to a string that stays valid for the lifetime of the process (normally a string literal).
+        StaticString,
+    };
+
+    /// Raw value of an argument of a deferred formatting log message.
+    struct LogArgument
+    {
+        LogArgumentKind kind;
+        union
+        {
+            int64_t intValue;
+            uint64_t uintValue;
+            double doubleValue;
+            const char* stringValue;
+        };
+    };
+
+    /// Wraps an HRESULT so that it is logged as such (HRESULT is a typedef of long).
+    struct LogHResult
+    {
+        explicit LogHResult(const int32_t hr) : value(hr) {}
+        int32_t value;
+    };
+
+    /// Maximum number of arguments of a deferred formatting log message.
+    constexpr uint32_t k_MaxLogArguments = 8;
+
+    /// Returns the number of "{}" placeholders in \a format.
+    constexpr uint32_t CountLogPlaceholders(const char* format)
+    {
+        uint32_t count = 0;
+        for (; *format != 0; ++format)
+        {
+            if (format[0] == '{' && format[1] == '}')
+            {
+                ++count;
+                ++format;
+            }
+        }
+        return count;
+    }
+
+    inline LogArgument MakeLogArgument(const bool value)
+    {
+        LogArgument argument;
+        argument.kind = LogArgumentKind::Bool;
+        argument.uintValue = value ? 1 : 0;
+        return argument;
+    }
+
+    inline LogArgument MakeLogArgument(const double value)
+    {
+        LogArgument argument;
+        argument.kind = LogArgumentKind::Double;
+        argument.doubleValue = value;
+        return argument;
+    }
+
+    inline LogArgument MakeLogArgument(const NvAPI_Status value)
+    {
+        LogArgument argument;
+        argument.kind = LogArgumentKind::NvApiStatus;
+        argument.intValue = value;
+        return argument;
+    }
+
+    inline LogArgument MakeLogArgument(const LogHResult value)
+    {
+        LogArgument argument;
+        argument.kind = LogArgumentKind::HResult;
+        argument.intValue = value.value;
+        return argument;
+    }
+
+    /// \remark The string must stay valid for the lifetime of the process (it is only read when formatting).
+    inline LogArgument MakeLogArgument(const char* const value)
+    {
+        LogArgument argument;
+        argument.kind = LogArgumentKind::StaticString;
+        argument.stringValue = value;
+        return argument;
+    }
+
+    /// Type used to decide if an integer (or enum) argument is signed.
+    template <class T, bool IsEnum = std::is_enum<T>::value>
+    struct LogIntegerType { using type = T; };
+    template <class T>
+    struct LogIntegerType<T, true> { using type = std::underlying_type_t<T>; };
+
+    /// Integers and other enums.
+    template <class T, std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value, int> = 0>
+    LogArgument MakeLogArgument(const T value)
+    {
+        LogArgument argument;
+        if (std::is_signed<typename LogIntegerType<T>::type>::value)
+        {
+            argument.kind = LogArgumentKind::Int;
+            argument.intValue = static_cast<int64_t>(value);
+        }
+        else
+        {
+            argument.kind = LogArgumentKind::UInt;
+            argument.uintValue = static_cast<uint64_t>(value);
+        }
+        return argument;
+    }
+
+    /// Function producing the description of a NvAPI_Status (same signature as NvAPI_GetErrorMessage).
+    typedef NvAPI_Status(*StatusMessageFunction)(NvAPI_Status, NvAPI_ShortString);
+
+    /**
+     * Produce the text of a deferred formatting log message.
+     *
+     * \param[in] format Description of the message.
+     * \param[in] arguments Values of the "{}" of the message (format.argumentCount of them).
+     * \param[in] statusMessageFunction Function producing the description of NvAPI_Status arguments (can be null).
+     * \param[out] buffer Where to write the null terminated text.
+     * \param[in] capacity Size of \a buffer (the text is truncated if too long).
+     *
+     * \return Length of the text written in \a buffer.
+     */
+    size_t FormatLogMessage(const LogFormat& format, const LogArgument* arguments,
+        StatusMessageFunction statusMessageFunction, char* buffer, size_t capacity);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "LogFormat.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Bounded lock-free multiple producers / single consumer queue of log messages.
+     *
+     * All the records are allocated when the queue is constructed, pushing a message only copies it in a free record
+     * (so logging never allocates memory or block the caller).  Messages pushed while the queue is full are dropped
+     * (and counted).
+     *
+     * \remark Based on Dmitry Vyukov's bounded MPMC queue: every record has a sequence number telling if it is ready
+     *         to be written to or read from for a given position.
+     */
+    class LogQueue final
+    {
+    public:
+        /// Number of records in the queue (must be a power of 2).
+        static constexpr uint32_t k_Capacity = 256;
+        /// Maximum length of a message (longer messages are truncated).
+        static constexpr uint32_t k_MaxMessageLength = 500;
+
+        /**
+         * A log message in the queue.
+         *
+         * Either text (when format is null) or a deferred formatting message (format and its arguments) that is
+         * turned into text only once removed from the queue.
+         */
+        struct Record
+        {
+            LogType logType = LogType::Log;
+            /// Description of a deferred formatting message (null for text messages).
+            const LogFormat* format = nullptr;
+            /// Arguments of the deferred formatting message (format->argumentCount of them).
+            LogArgument arguments[k_MaxLogArguments];
+            /// Length of message (for text messages).
+            uint32_t length = 0;
+            /// Text of the message (always null terminated, for text messages).
+            char message[k_MaxMessageLength + 1];
+        };
+
+        LogQueue();
+        LogQueue(const LogQueue&) = delete;
+        LogQueue& operator=(const LogQueue&) = delete;
+
+        /**
+         * Add a message to the queue.
+         *
+         * \param[in] logType Type of log message.
+         * \param[in] message Text of the message (does not need to be null terminated).
+         * \param[in] length Length of \a message (truncated to k_MaxMessageLength).
+         *
+         * \return Was the message added (false if the queue was full).
+         * \remark Can be called from any thread.
+         */
+        bool TryPush(LogType logType, const char* message, size_t length);
+
+        /**
+         * Add a deferred formatting message to the queue.
+         *
+         * \param[in] format Description of the message (must stay valid until the message is removed from the queue).
+         * \param[in] arguments Values of the arguments of the message (format.argumentCount of them).
+         *
+         * \return Was the message added (false if the queue was full).
+         * \remark Can be called from any thread.
+         */
+        bool TryPush(const LogFormat& format, const LogArgument* arguments);
+
+        /**
+         * Remove the oldest message of the queue.
+         *
+         * \param[out] record Receives the message.
+         *
+         * \return Was a message removed (false if the queue was empty).
+         * \remark Only one thread at a time can call this method.
+         */
+        bool TryPop(Record& record);
+
+        /// Number of messages dropped because the queue was full (since construction).
+        uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr uint32_t k_IndexMask = k_Capacity - 1;
+        static_assert((k_Capacity & k_IndexMask) == 0, "k_Capacity must be a power of 2");
+
+        struct alignas(64) Cell
+        {
+            /// Position at which the record can be written (== position) or read (== position + 1).
+            std::atomic<uint64_t> sequence;
+            Record record;
+        };
+
+        /// Reserve the cell at the next enqueue position (null if the queue is full).
+        Cell* ClaimCell(uint64_t& position);
+
+        const std::unique_ptr<Cell[]> m_Cells;
+        alignas(64) std::atomic<uint64_t> m_EnqueuePosition{0};
+        alignas(64) uint64_t m_DequeuePosition = 0;
+        std::atomic<uint64_t> m_DroppedCount{0};
+    };
+}
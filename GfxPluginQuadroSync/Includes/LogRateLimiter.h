@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "LogFormat.h"
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Limits the rate of deferred formatting log messages repeated by the same call site.
+     *
+     * Messages are grouped by call site (their LogFormat) and status (their first NvAPI_Status or HRESULT argument).
+     * The first occurrences of every group are let through and the following ones are suppressed until the consumer of
+     * the messages collects a summary of the suppressed occurrences (once per period), which opens a new period.
+     *
+     * \remark ShouldLog is lock-free and can be called from any thread, CollectSummaries must only be called by one
+     *         thread at a time.
+     * \remark Groups are never forgotten, once the table is full messages of new groups are not limited anymore.
+     */
+    class LogRateLimiter final
+    {
+    public:
+        /// Maximum number of groups of messages that can be tracked.
+        static constexpr uint32_t k_TableSize = 64;
+        /// Default number of occurrences of a group let through every period.
+        static constexpr uint32_t k_DefaultBurst = 5;
+        /// Default length of a period.
+        static constexpr uint32_t k_DefaultPeriodSeconds = 10;
+
+        /// Suppressed occurrences of a group of messages during a period.
+        struct Summary
+        {
+            /// Description of the messages.
+            const LogFormat* format;
+            /// Status shared by the messages (kind is StaticString with a null stringValue if they had no status).
+            LogArgument status;
+            /// Number of suppressed occurrences.
+            uint64_t suppressedCount;
+            /// Length of the period during which they were suppressed.
+            uint64_t periodTicks;
+        };
+
+        /**
+         * Constructor
+         *
+         * \param[in] ticksPerSecond Frequency of the ticks passed to the other methods.
+         */
+        explicit LogRateLimiter(uint64_t ticksPerSecond);
+        LogRateLimiter(const LogRateLimiter&) = delete;
+        LogRateLimiter& operator=(const LogRateLimiter&) = delete;
+
+        /**
+         * Changes the limits.
+         *
+         * \param[in] burst Number of occurrences of a group let through every period (0 to disable rate limiting).
+         * \param[in] periodSeconds Length of a period.
+         */
+        void Configure(uint32_t burst, uint32_t periodSeconds);
+
+        /**
+         * Returns if a message should be logged or suppressed.
+         *
+         * \param[in] format Description of the message.
+         * \param[in] arguments Arguments of the message.
+         *
+         * \remark Does not need the current time, periods of new groups start on the next call to CollectSummaries.
+         */
+        bool ShouldLog(const LogFormat& format, const LogArgument* arguments);
+
+        /**
+         * Collects the suppressed occurrences of the groups whose period is over (and starts a new period for them).
+         *
+         * \param[in] nowTick Current time (must not be 0).
+         * \param[out] summaries Receives the summaries.
+         * \param[in] capacity Number of summaries \a summaries can receive (remaining summaries will be returned by the
+         *                     next call).
+         *
+         * \return Number of summaries stored in \a summaries.
+         */
+        uint32_t CollectSummaries(uint64_t nowTick, Summary* summaries, uint32_t capacity);
+
+        /// Total number of messages suppressed (since construction).
+        uint64_t GetSuppressedCount() const { return m_SuppressedCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Entry
+        {
+            /// Hash of the format and status (0 for unused entries).
+            std::atomic<uint64_t> key{0};
+            /// Set (after everything else) by the thread that claimed the entry.
+            std::atomic<const LogFormat*> format{nullptr};
+            LogArgument status;
+            /// Start of the current period (0 until the first call to CollectSummaries after the entry is claimed).
+            std::atomic<uint64_t> periodStartTick{0};
+            std::atomic<uint32_t> countInPeriod{0};
+            std::atomic<uint64_t> suppressedInPeriod{0};
+        };
+
+        /// Returns the entry of the group of the message (null if the table is full).
+        Entry* FindOrClaimEntry(const LogFormat& format, const LogArgument& status);
+
+        const uint64_t m_TicksPerSecond;
+        std::atomic<uint32_t> m_Burst{k_DefaultBurst};
+        std::atomic<uint64_t> m_PeriodTicks;
+        std::atomic<uint64_t> m_SuppressedCount{0};
+        Entry m_Entries[k_TableSize];
+    };
+}
@@ -1,26 +1,37 @@
 #pragma once
 
-#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include "LogQueue.h"
+#include "LogRateLimiter.h"
 
 #include "../External/NvAPI/nvapi_lite_common.h"
 #include "../Unity/IUnityInterface.h"
 
 namespace GfxQuadroSync
 {
-    /// Type of logging messages (matches managed UnityEngine.LogType)
-    enum class LogType
+    /// How log messages are delivered to the managed callback.
+    enum class LogDeliveryMode : uint32_t
     {
-        Error = 0,      ///< Used for Errors.
-        Assert = 1,     ///< Used for Asserts.
-        Warning = 2,    ///< Used for Warnings.
-        Log = 3,        ///< Used for regular log messages.
-        Exception = 4,  ///< Used for Exceptions.
+        /// A background thread delivers the queued messages every few milliseconds.
+        DrainThread = 0,
+        /// Queued messages are only delivered when Logger::Flush is called (FlushLogs polled by managed code).
+        Polled = 1,
     };
 
     /**
      * \brief Helper class performing work to process logs.
      *
-     * \remark Sending actual log messages is done using the CLUSTER_LOG, CLUSTER_LOG_WARNING and CLUSTER_LOG_ERROR macros.
+     * Log messages are added to a preallocated lock-free queue by the thread producing them and delivered later to the
+     * managed callback (by a background thread or by Flush depending on the LogDeliveryMode).  This keeps the cost of
+     * logging from the render thread to formatting the message in a stack buffer and copying it in the queue.
+     *
+     * \remark Sending actual log messages is done using the CLUSTER_LOG* and CLUSTER_LOGF* macros.
      */
     class Logger final
     {
@@ -39,95 +50,303 @@ namespace GfxQuadroSync
         /// Type of callback to managed function that receive the log messages
         typedef void(UNITY_INTERFACE_API* ManagedCallback)(int, const char*);
 
-        /// Sets the function to be called for every logging message we receive.
+        /**
+         * Sets the function to be called for every logging message we receive.
+         *
+         * \remark Messages queued for the previous callback are delivered to it before returning.
+         */
         void SetManagedCallback(ManagedCallback managedCallback);
 
         /// Returns if we need to spend time producing the message (because there is someone interested in them).
-        bool AreMessagesUseful() const { return m_ManagedCallback != nullptr; }
+        bool AreMessagesUseful() const { return m_ManagedCallback.load(std::memory_order_relaxed) != nullptr; }
+
+        /**
+         * Returns if a message of the given level and category would be delivered to the managed callback.
+         *
+         * \remark Inline to help performances as it is called by every log macro every time.
+         */
+        bool IsEnabled(const LogLevel level, const LogCategory category) const
+        {
+            return static_cast<uint32_t>(level) >= m_MinLevel.load(std::memory_order_relaxed) &&
+                (m_CategoryMask.load(std::memory_order_relaxed) & static_cast<uint32_t>(category)) != 0 &&
+                AreMessagesUseful();
+        }
+
+        /// Sets the minimum level of the messages to deliver (messages with a lower level are not even produced).
+        void SetMinLevel(LogLevel level) { m_MinLevel.store(static_cast<uint32_t>(level), std::memory_order_relaxed); }
+
+        /// Returns the minimum level of the messages to deliver.
+        LogLevel GetMinLevel() const { return static_cast<LogLevel>(m_MinLevel.load(std::memory_order_relaxed)); }
+
+        /// Sets the mask of LogCategory of the messages to deliver.
+        void SetCategoryMask(uint32_t mask) { m_CategoryMask.store(mask, std::memory_order_relaxed); }
+
+        /// Returns the mask of LogCategory of the messages to deliver.
+        uint32_t GetCategoryMask() const { return m_CategoryMask.load(std::memory_order_relaxed); }
+
+        /// Sets how messages are delivered to the managed callback.
+        void SetDeliveryMode(LogDeliveryMode deliveryMode);
+
+        /// Returns how messages are delivered to the managed callback.
+        LogDeliveryMode GetDeliveryMode() const { return m_DeliveryMode; }
+
+        /**
+         * Deliver the queued messages to the managed callback (from the calling thread).
+         *
+         * \return Number of messages delivered.
+         */
+        uint32_t Flush();
+
+        /**
+         * Stops the drain thread and deliver the queued messages.
+         *
+         * \remark To be called when the plugin is unloaded (the drain thread cannot be joined from static destructors
+         *         as they are executed while holding the loader lock).
+         */
+        void Shutdown();
+
+        /**
+         * Sets the function used to get the description of a NvAPI_Status when writing it in a log message.
+         *
+         * \remark Without it NvAPI_Status are only logged as a number.  Allows the logger to be used in code that is
+         *         not linked to NvAPI.
+         */
+        void SetStatusMessageFunction(StatusMessageFunction statusMessageFunction);
+
+        /// Returns the function set by SetStatusMessageFunction.
+        StatusMessageFunction GetStatusMessageFunction() const { return m_StatusMessageFunction; }
 
         /**
          * Method called by LoggingStream to send a logging message.
          *
          * \param[in] logType Type of log message.
-         * \param[in] message The actual log message text.
+         * \param[in] message The actual log message text (does not need to be null terminated).
+         * \param[in] length Length of \a message.
+         *
+         * \remark Can be called from any thread, never blocks.
+         */
+        void LogMessage(LogType logType, const char* message, size_t length);
+
+        /**
+         * Method called by CLUSTER_LOGF to send a deferred formatting message.
+         *
+         * \param[in] format Description of the message (static, one per call site).
+         * \param[in] arguments Values of the arguments of the message (format.argumentCount of them).
+         *
+         * \remark Can be called from any thread, never blocks.  The text is only produced when the message is
+         *         delivered to the managed callback.
          */
-        void LogMessage(LogType logType, const std::string& message);
+        void LogMessage(const LogFormat& format, const LogArgument* arguments);
+
+        /// Number of messages dropped because they were produced faster than they were delivered.
+        uint64_t GetDroppedMessageCount() const { return m_Queue.GetDroppedCount(); }
+
+        /**
+         * Changes the limits of the rate at which a CLUSTER_LOGF call site can log messages with the same status (see
+         * LogRateLimiter).
+         *
+         * \param[in] burst Number of messages let through every period (0 to disable rate limiting).
+         * \param[in] periodSeconds Length of a period (a summary of the suppressed messages is logged at the end of
+         *                          every period).
+         */
+        void SetRateLimit(uint32_t burst, uint32_t periodSeconds) { m_RateLimiter.Configure(burst, periodSeconds); }
+
+        /// Number of messages suppressed by the rate limiting.
+        uint64_t GetSuppressedMessageCount() const { return m_RateLimiter.GetSuppressedCount(); }
 
     private:
         // Private constructor and destructor to enforce singleton usage
-        Logger() = default;
-        ~Logger() = default;
+        Logger();
+        ~Logger();
+
+        /// Starts the drain thread if the delivery mode and callback require it.  Must be called with m_ControlLock held.
+        void UpdateDrainThread();
+        /// Stops the drain thread (if running).  Must be called with m_ControlLock held.
+        void StopDrainThread();
+        /// Method executed by m_DrainThread.
+        void DrainThreadLoop();
+
+        /// Deliver the summaries of the messages suppressed by m_RateLimiter.  Must be called with m_FlushLock held.
+        uint32_t DeliverSuppressedSummaries(ManagedCallback managedCallback);
+
+        /// Interval at which the drain thread delivers queued messages.
+        static constexpr std::chrono::milliseconds k_DrainPeriod{10};
 
         // Member variables
-        ManagedCallback m_ManagedCallback = nullptr;
+        std::atomic<ManagedCallback> m_ManagedCallback{nullptr};
+        std::atomic<uint32_t> m_MinLevel{static_cast<uint32_t>(LogLevel::Debug)};
+        std::atomic<uint32_t> m_CategoryMask{static_cast<uint32_t>(LogCategory::All)};
+        StatusMessageFunction m_StatusMessageFunction = nullptr;
+        LogQueue m_Queue;
+        LogRateLimiter m_RateLimiter;
+
+        /// Serialize changes to the callback, delivery mode and drain thread.
+        std::mutex m_ControlLock;
+        LogDeliveryMode m_DeliveryMode = LogDeliveryMode::DrainThread;
+
+        /// Serialize consumers of m_Queue (Flush can be called from the drain thread and from managed code).
+        std::mutex m_FlushLock;
+        /// Dropped message count we already informed the managed callback about.
+        uint64_t m_ReportedDroppedCount = 0;
+
+        std::thread m_DrainThread;
+        std::mutex m_DrainThreadLock;
+        std::condition_variable m_DrainThreadCondition;
+        bool m_StopDrainThread = false;
     };
 
     /**
      * Internal mechanic class, no need to manually use it.
      *
-     * \remark Used by CLUSTER_LOG, CLUSTER_LOG_WARNING and CLUSTER_LOG_ERROR macros.
+     * Stream buffer writing in a fixed size buffer (to avoid any memory allocation), content exceeding the buffer is
+     * truncated.
      */
-    class LoggingStream final : public std::ostringstream
+    class LogMessageBuffer : public std::streambuf
     {
     public:
-        LoggingStream(LogType logType)
-            : m_LogType(logType)
+        LogMessageBuffer() { setp(m_Text, m_Text + LogQueue::k_MaxMessageLength); }
+
+        /// Text of the message (not null terminated).
+        const char* GetText() const { return pbase(); }
+
+        /// Length of the text of the message.
+        size_t GetLength() const { return pptr() - pbase(); }
+
+        /// Was the message truncated because it was too long.
+        bool IsTruncated() const { return m_Truncated; }
+
+    protected:
+        int_type overflow(int_type) override
         {
-            *this << "QuadroSync: ";
+            m_Truncated = true;
+            return traits_type::eof();
         }
 
-        ~LoggingStream()
+    private:
+        char m_Text[LogQueue::k_MaxMessageLength];
+        bool m_Truncated = false;
+    };
+
+    /**
+     * Internal mechanic class, no need to manually use it.
+     *
+     * \remark Used by the CLUSTER_LOG* macros.
+     */
+    class LoggingStream final : private LogMessageBuffer, public std::ostream
+    {
+    public:
+        LoggingStream(LogType logType)
+            : std::ostream(static_cast<LogMessageBuffer*>(this))
+            , m_LogType(logType)
         {
-            Logger::Instance().LogMessage(m_LogType, str());
+            *this << "QuadroSync: ";
         }
 
+        ~LoggingStream();
+
     private:
         const LogType m_LogType;
     };
 
+    /**
+     * Internal mechanic function, no need to manually use it.
+     *
+     * \remark Used by the CLUSTER_LOGF* macros.
+     */
+    template <uint32_t PlaceholderCount, class... Args>
+    void LogDeferred(const LogFormat& format, const Args&... args)
+    {
+        static_assert(PlaceholderCount == sizeof...(Args),
+            "The number of {} in the log message must match the number of arguments");
+        static_assert(sizeof...(Args) <= k_MaxLogArguments, "Too many arguments for a log message");
+        const LogArgument arguments[sizeof...(Args) > 0 ? sizeof...(Args) : 1] = {MakeLogArgument(args)...};
+        Logger::Instance().LogMessage(format, arguments);
+    }
+
     /**
      * operator<< for NvAPI_Status that will write it to the stream as a number and a string (string returned by
-     * NvAPI_GetErrorMessage).  Ideal to conclude a message about a call to NvAPI that failed.
+     * the function set through Logger::SetStatusMessageFunction, normally NvAPI_GetErrorMessage).  Ideal to conclude
+     * a message about a call to NvAPI that failed.
      */
     std::ostream& operator<<(std::ostream& os, NvAPI_Status status);
 }
 
 /**
- * \brief Macro to be used to log error messages.
+ * \brief Internal mechanic macro for CLUSTER_LOG_DEBUG, CLUSTER_LOG, CLUSTER_LOG_WARNING and CLUSTER_LOG_ERROR.
  *
- * Use this macro to log error messages as you would use a std::ostringstream.  As a bonus, processing will be limited
- * to a simple if in the event where logging is not enabled.
+ * Messages with a level lower than QUADROSYNC_LOG_MIN_LEVEL are discarded at compile time, other messages cost a
+ * simple if when their level or category is not enabled (or when logging is not enabled).
  *
  * \remark Inverting the condition in the if and putting everything in the else might look strange but this is to avoid
  *         problems in cases where someone would do something like:
- *         if ( condition ) CLUSTER_LOG_ERROR << "Hello"; else somethingElse();
- *         Without that somethingElse would be executed when !AreMessagesUseful() as opposed as when !condition.
+ *         if ( condition ) CLUSTER_LOG_ERROR(Init) << "Hello"; else somethingElse();
+ *         Without that somethingElse would be executed when the message is not enabled as opposed as when !condition.
+ */
+#define CLUSTER_LOG_IMPL(level, category)                                                                              \
+    if constexpr (!GfxQuadroSync::IsLogLevelCompiled(level)) ;                                                         \
+    else if ( !GfxQuadroSync::Logger::Instance().IsEnabled(level, GfxQuadroSync::LogCategory::category) ) ;           \
+    else GfxQuadroSync::LoggingStream(GfxQuadroSync::ToLogType(level))
+
+/**
+ * \brief Macro to be used to log error messages.
+ *
+ * Use this macro to log error messages as you would use a std::ostringstream, for example:
+ * CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
+ * The argument is the LogCategory of the message.  As a bonus, processing will be limited to a simple if in the event
+ * where logging is not enabled.
  */
-#define CLUSTER_LOG_ERROR if ( !GfxQuadroSync::Logger::Instance().AreMessagesUseful() ) ; else LoggingStream(GfxQuadroSync::LogType::Error)
-
- /**
-  * \brief Macro to be used to log warning messages.
-  *
-  * Use this macro to log error messages as you would use a std::ostringstream.  As a bonus, processing will be limited
-  * to a simple if in the event where logging is not enabled.
-  *
-  * \remark Inverting the condition in the if and putting everything in the else might look strange but this is to avoid
-  *         problems in cases where someone would do something like:
-  *         if ( condition ) CLUSTER_LOG_ERROR << "Hello"; else somethingElse();
-  *         Without that somethingElse would be executed when !AreMessagesUseful() as opposed as when !condition.
-  */
-#define CLUSTER_LOG_WARNING if ( !GfxQuadroSync::Logger::Instance().AreMessagesUseful() ) ; else LoggingStream(GfxQuadroSync::LogType::Warning)
+#define CLUSTER_LOG_ERROR(category) CLUSTER_LOG_IMPL(GfxQuadroSync::LogLevel::Error, category)
+
+/// \brief Macro to be used to log warning messages (see CLUSTER_LOG_ERROR).
+#define CLUSTER_LOG_WARNING(category) CLUSTER_LOG_IMPL(GfxQuadroSync::LogLevel::Warning, category)
+
+/// \brief Macro to be used to log messages (see CLUSTER_LOG_ERROR).
+#define CLUSTER_LOG(category) CLUSTER_LOG_IMPL(GfxQuadroSync::LogLevel::Info, category)
+
+/// \brief Macro to be used to log debug messages (see CLUSTER_LOG_ERROR).
+#define CLUSTER_LOG_DEBUG(category) CLUSTER_LOG_IMPL(GfxQuadroSync::LogLevel::Debug, category)
 
 /**
- * \brief Macro to be used to log messages.
+ * \brief Internal mechanic macro for the CLUSTER_LOGF* macros.
  *
- * Use this macro to log error messages as you would use a std::ostringstream.  As a bonus, processing will be limited
- * to a simple if in the event where logging is not enabled.
+ * Creates the static description of the message (whose address identifies the call site) and checks at compile time
+ * that the number of {} in the format matches the number of arguments.
+ */
+#define CLUSTER_LOGF_IMPL(level, category, format, ...)                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (GfxQuadroSync::IsLogLevelCompiled(level))                                                        \
+        {                                                                                                              \
+            if (GfxQuadroSync::Logger::Instance().IsEnabled(level, GfxQuadroSync::LogCategory::category))             \
+            {                                                                                                          \
+                static constexpr GfxQuadroSync::LogFormat s_ClusterLogFormat{GfxQuadroSync::ToLogType(level), format,  \
+                    GfxQuadroSync::CountLogPlaceholders(format)};                                                      \
+                GfxQuadroSync::LogDeferred<GfxQuadroSync::CountLogPlaceholders(format)>(s_ClusterLogFormat,            \
+                    ##__VA_ARGS__);                                                                                    \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+/**
+ * \brief Macro to be used to log error messages with deferred formatting.
  *
- * 
- * \remark Inverting the condition in the if and putting everything in the else might look strange but this is to avoid
- *         problems in cases where someone would do something like:
- *         if ( condition ) CLUSTER_LOG_ERROR << "Hello"; else somethingElse();
- *         Without that somethingElse would be executed when !AreMessagesUseful() as opposed as when !condition.
+ * Usage: CLUSTER_LOGF_ERROR(Present, "NvAPI_D3D1x_Present failed: {}", status);  The first argument is the LogCategory
+ * of the message.  Every {} of the format (that must be a string literal) is replaced by the matching argument.
+ * Arguments can be integers, enums, bool, double, NvAPI_Status, LogHResult and static strings.  Only the raw value of
+ * the arguments is captured, producing the text is done when the message is delivered (outside of the thread logging
+ * it), making it affordable to log from the present path.
  */
-#define CLUSTER_LOG if ( !GfxQuadroSync::Logger::Instance().AreMessagesUseful() ) ; else LoggingStream(GfxQuadroSync::LogType::Log)
+#define CLUSTER_LOGF_ERROR(category, format, ...)                                                                      \
+    CLUSTER_LOGF_IMPL(GfxQuadroSync::LogLevel::Error, category, format, ##__VA_ARGS__)
+
+/// \brief Macro to be used to log warning messages with deferred formatting (see CLUSTER_LOGF_ERROR).
+#define CLUSTER_LOGF_WARNING(category, format, ...)                                                                    \
+    CLUSTER_LOGF_IMPL(GfxQuadroSync::LogLevel::Warning, category, format, ##__VA_ARGS__)
+
+/// \brief Macro to be used to log messages with deferred formatting (see CLUSTER_LOGF_ERROR).
+#define CLUSTER_LOGF(category, format, ...)                                                                            \
+    CLUSTER_LOGF_IMPL(GfxQuadroSync::LogLevel::Info, category, format, ##__VA_ARGS__)
+
+/// \brief Macro to be used to log debug messages with deferred formatting (see CLUSTER_LOGF_ERROR).
+#define CLUSTER_LOGF_DEBUG(category, format, ...)                                                                      \
+    CLUSTER_LOGF_IMPL(GfxQuadroSync::LogLevel::Debug, category, format, ##__VA_ARGS__)
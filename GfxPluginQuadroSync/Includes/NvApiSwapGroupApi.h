@@ -0,0 +1,28 @@
+#pragma once
+
+#include "INvSwapGroupApi.h"
+
+namespace GfxQuadroSync
+{
+    /// Implementation of INvSwapGroupApi forwarding everything to the real NvAPI.
+    class NvApiSwapGroupApi final : public INvSwapGroupApi
+    {
+    public:
+        NvAPI_Status Initialize() override;
+
+        NvAPI_Status EnumPhysicalGPUs(NvPhysicalGpuHandle gpuHandles[NVAPI_MAX_PHYSICAL_GPUS],
+            NvU32* gpuCount) override;
+        NvAPI_Status SetupWorkstationSwapGroupFeature(NvPhysicalGpuHandle gpuHandle, bool enable) override;
+
+        NvAPI_Status QueryMaxSwapGroup(IUnknown* device, NvU32* maxGroups, NvU32* maxBarriers) override;
+        NvAPI_Status JoinSwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32 group, bool blocking) override;
+        NvAPI_Status BindSwapBarrier(IUnknown* device, NvU32 group, NvU32 barrier) override;
+        NvAPI_Status QuerySwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32* group,
+            NvU32* barrier) override;
+
+        NvAPI_Status QueryFrameCount(IUnknown* device, NvU32* frameCount) override;
+        NvAPI_Status ResetFrameCount(IUnknown* device) override;
+
+        NvAPI_Status Present(IUnknown* device, IDXGISwapChain* swapChain, NvU32 syncInterval, NvU32 flags) override;
+    };
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /**
+     * Returns the current value of the high resolution performance counter (QueryPerformanceCounter, same time base
+     * as System.Diagnostics.Stopwatch on the managed side).
+     */
+    uint64_t GetCurrentPerformanceCounterTick();
+
+    /// Returns the number of performance counter ticks per second.
+    uint64_t GetPerformanceCounterFrequency();
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// Flags describing the context in which a present was done (stored in PresentTiming::flags).
+    enum class PresentTimingFlags : uint32_t
+    {
+        None = 0,
+        /// Present was done while the swap barrier was being warmed up.
+        BarrierWarmup = 1 << 0,
+        /// Present of a repeated frame (additional present done to warm up the swap barrier).
+        RepeatedPresent = 1 << 1,
+        /// Synchronized present was skipped for that frame (Unity did a normal present).
+        SkippedSynchronization = 1 << 2,
+        /// Present was blocked for longer than the stall watchdog threshold.
+        Stalled = 1 << 3,
+    };
+
+    inline PresentTimingFlags operator|(const PresentTimingFlags a, const PresentTimingFlags b)
+    {
+        return static_cast<PresentTimingFlags>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+    }
+
+    /**
+     * Timing information about a single present done by PluginCSwapGroupClient::Render.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncPresentTiming in
+     *         GfxPluginQuadroSyncPresentTiming.cs.
+     */
+    struct PresentTiming
+    {
+        /// Index of the present (incremented for every present, including repeats done to warm up the barrier).
+        uint64_t presentIndex = 0;
+        /// Performance counter tick just before calling present.
+        uint64_t presentStartTick = 0;
+        /// Performance counter tick just after present returned.
+        uint64_t presentEndTick = 0;
+        /// NvAPI_Status returned by present (not using NvAPI_Status for safer interop with managed code).
+        int32_t status = 0;
+        /// Combination of PresentTimingFlags.
+        uint32_t flags = 0;
+    };
+
+    /**
+     * \brief Fixed size ring of PresentTiming.
+     *
+     * Designed to be filled by a single producer (the thread presenting) without any lock or allocation and to be
+     * read by any number of consumers, each one of them keeping track of what it has read through its own cursor.
+     * When consumers are not fast enough the oldest entries are overwritten (and counted as dropped by the consumer
+     * reading them).
+     *
+     * \remark Each slot works like a small seqlock: the sequence number of the slot is invalidated before being
+     *         modified and set to the index of the entry once the entry is completely written.  Consumers validate
+     *         the sequence number before and after having copied the entry to detect an entry being overwritten
+     *         while being copied.
+     */
+    class PresentTimingRing final
+    {
+    public:
+        /// Number of entries in the ring (must be a power of 2).
+        static constexpr uint32_t k_Capacity = 512;
+
+        /**
+         * Adds a new entry to the ring, overwriting the oldest one if the ring is full.
+         *
+         * \param[in] timing Timing to add (presentIndex is ignored and filled by the ring).
+         *
+         * \remark Must always be called from the same thread (or at least never concurrently).
+         */
+        void Push(const PresentTiming& timing)
+        {
+            const auto index = m_WriteIndex.load(std::memory_order_relaxed);
+            auto& slot = m_Slots[index & (k_Capacity - 1)];
+
+            slot.sequence.store(k_InvalidSequence, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.presentStartTick.store(timing.presentStartTick, std::memory_order_relaxed);
+            slot.presentEndTick.store(timing.presentEndTick, std::memory_order_relaxed);
+            slot.statusAndFlags.store(PackStatusAndFlags(timing.status, timing.flags), std::memory_order_relaxed);
+            slot.sequence.store(index, std::memory_order_release);
+
+            m_WriteIndex.store(index + 1, std::memory_order_release);
+        }
+
+        /**
+         * Copy entries that were not yet read by the consumer owning \a cursor.
+         *
+         * \param[in,out] cursor Index of the next entry to be read by the consumer, updated to the index following the
+         *                       last entry read (or skipped).  Should be initialized to 0 before the first call.
+         * \param[out] buffer Where to store the entries.
+         * \param[in] capacity Number of entries that can be stored in \a buffer.
+         * \param[out] dropped Incremented by the number of entries that were overwritten before they could be read.
+         *
+         * \return Number of entries stored in \a buffer.
+         */
+        uint32_t Read(uint64_t& cursor, PresentTiming* const buffer, const uint32_t capacity, uint64_t& dropped) const
+        {
+            const auto writeIndex = m_WriteIndex.load(std::memory_order_acquire);
+            if (writeIndex - cursor > k_Capacity)
+            {
+                dropped += writeIndex - k_Capacity - cursor;
+                cursor = writeIndex - k_Capacity;
+            }
+
+            uint32_t readCount = 0;
+            for (; cursor < writeIndex && readCount < capacity; ++cursor)
+            {
+                const auto& slot = m_Slots[cursor & (k_Capacity - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != cursor)
+                {
+                    ++dropped;
+                    continue;
+                }
+
+                PresentTiming timing;
+                timing.presentIndex = cursor;
+                timing.presentStartTick = slot.presentStartTick.load(std::memory_order_relaxed);
+                timing.presentEndTick = slot.presentEndTick.load(std::memory_order_relaxed);
+                const auto statusAndFlags = slot.statusAndFlags.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != cursor)
+                {
+                    ++dropped;
+                    continue;
+                }
+
+                timing.status = static_cast<int32_t>(statusAndFlags & 0xFFFFFFFF);
+                timing.flags = static_cast<uint32_t>(statusAndFlags >> 32);
+                buffer[readCount++] = timing;
+            }
+            return readCount;
+        }
+
+        /// Returns the index that will be given to the next entry pushed in the ring.
+        uint64_t GetWriteIndex() const { return m_WriteIndex.load(std::memory_order_acquire); }
+
+    private:
+        static_assert((k_Capacity & (k_Capacity - 1)) == 0, "k_Capacity must be a power of 2");
+        static constexpr uint64_t k_InvalidSequence = ~uint64_t(0);
+
+        static uint64_t PackStatusAndFlags(const int32_t status, const uint32_t flags)
+        {
+            return (static_cast<uint64_t>(flags) << 32) | static_cast<uint32_t>(status);
+        }
+
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence{k_InvalidSequence};
+            std::atomic<uint64_t> presentStartTick{0};
+            std::atomic<uint64_t> presentEndTick{0};
+            std::atomic<uint64_t> statusAndFlags{0};
+        };
+
+        Slot m_Slots[k_Capacity];
+        std::atomic<uint64_t> m_WriteIndex{0};
+    };
+}
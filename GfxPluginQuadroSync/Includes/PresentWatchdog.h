@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Detects presents blocked for too long (typically a node that dropped off the swap barrier).
+     *
+     * The thread presenting marks the beginning and the end of every present, a background thread checks a few times
+     * per threshold if the present in progress started more than threshold ago.  Every stalled present is reported
+     * once (counted and passed to the stall callback) while it is still blocked, its duration is known once it ends.
+     *
+     * \remark PresentStarted and PresentEnded are lock-free (one atomic operation each).
+     */
+    class PresentWatchdog final
+    {
+    public:
+        /// Function called from the watchdog thread when a stalled present is detected.
+        typedef std::function<void()> StallCallback;
+
+        /**
+         * Constructor
+         *
+         * \param[in] ticksPerSecond Frequency of the ticks passed to the other methods.
+         */
+        explicit PresentWatchdog(uint64_t ticksPerSecond);
+        ~PresentWatchdog();
+        PresentWatchdog(const PresentWatchdog&) = delete;
+        PresentWatchdog& operator=(const PresentWatchdog&) = delete;
+
+        /**
+         * Starts (or restarts) the watchdog thread.
+         *
+         * \param[in] thresholdMs Presents blocked for longer than this are stalled (0 to stop the watchdog).
+         * \param[in] stallCallback Called (from the watchdog thread) every time a stalled present is detected.
+         */
+        void Start(uint32_t thresholdMs, StallCallback stallCallback);
+
+        /// Stops the watchdog thread (if running).
+        void Stop();
+
+        /// Is the watchdog thread running.
+        bool IsRunning() const { return m_ThresholdTicks.load(std::memory_order_relaxed) != 0; }
+
+        /// To be called by the thread presenting just before presenting.
+        void PresentStarted(const uint64_t startTick)
+        {
+            m_PresentInProgress.store(startTick, std::memory_order_release);
+        }
+
+        /**
+         * To be called by the thread presenting once the present returned.
+         *
+         * \return Was the present detected as stalled.
+         */
+        bool PresentEnded(uint64_t endTick);
+
+        /**
+         * Checks if the present in progress is stalled (what the watchdog thread does periodically).
+         *
+         * \param[in] nowTick Current time.
+         *
+         * \return Was a new stalled present detected.
+         */
+        bool Check(uint64_t nowTick);
+
+        /// Number of stalled presents detected (since construction).
+        uint64_t GetStallCount() const { return m_StallCount.load(std::memory_order_relaxed); }
+
+        /// Is the present in progress stalled.
+        bool IsStalled() const { return (m_PresentInProgress.load(std::memory_order_relaxed) & k_StalledFlag) != 0; }
+
+        /// Duration (in ticks) of the last stalled present that ended.
+        uint64_t GetLastStallTicks() const { return m_LastStallTicks.load(std::memory_order_relaxed); }
+
+    private:
+        /// Bit of m_PresentInProgress set when the present is detected as stalled (the performance counter never
+        /// reaches it).
+        static constexpr uint64_t k_StalledFlag = 1ull << 63;
+
+        /// Method executed by m_Thread.
+        void WatchdogLoop(StallCallback stallCallback);
+
+        const uint64_t m_TicksPerSecond;
+
+        /// Start tick of the present in progress (0 when not presenting), with k_StalledFlag once detected as stalled.
+        std::atomic<uint64_t> m_PresentInProgress{0};
+        std::atomic<uint64_t> m_ThresholdTicks{0};
+        std::atomic<uint64_t> m_StallCount{0};
+        std::atomic<uint64_t> m_LastStallTicks{0};
+
+        /// Serialize Start and Stop.
+        std::mutex m_ControlLock;
+        std::thread m_Thread;
+        std::mutex m_ThreadLock;
+        std::condition_variable m_ThreadCondition;
+        bool m_StopThread = false;
+    };
+}
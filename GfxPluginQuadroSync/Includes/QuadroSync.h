@@ -1,22 +1,54 @@
 #pragma once
 
-#include "../External/NvAPI/nvapi.h"
+#include "../External/NvAPI/nvapi_lite_common.h"
 #include "../Unity/IUnityInterface.h"
+#include "BarrierWarmupPolicy.h"
+#include "ConfigurationMailbox.h"
+#include "DeviceRecovery.h"
+#include "FrameCountService.h"
+#include "INvSwapGroupApi.h"
+#include "PresentTimings.h"
+#include "PresentWatchdog.h"
+#include "SwapChainMonitor.h"
+#include "SwapGroupSnapshot.h"
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 
-class ID3D11Device;
-class IDXGISwapChain;
+struct IUnknown;
+struct IDXGISwapChain;
 
 namespace GfxQuadroSync
 {
     class IGraphicsDevice;
 
+    /// Swap group and barrier membership (and frame counter) targeted by PluginCSwapGroupClient::Reconfigure.
+    struct SwapGroupConfiguration
+    {
+        /// Swap group to join (0 to leave the swap group).
+        NvU32 swapGroupId = 0;
+        /// Swap barrier to bind the swap group to (0 to unbind, must be 0 if swapGroupId is 0).
+        NvU32 swapBarrierId = 0;
+        /// Use the hardware frame counter (as opposed to the custom frame counter).
+        bool hardwareFrameCounter = false;
+
+        /// Unpacks a configuration packed in the 64 bits argument of a render event or command (bits 0 to 15: swap
+        /// group, bits 16 to 31: swap barrier, bit 32: hardware frame counter).
+        static SwapGroupConfiguration Unpack(const uint64_t packed)
+        {
+            SwapGroupConfiguration configuration;
+            configuration.swapGroupId = static_cast<NvU32>(packed & 0xFFFF);
+            configuration.swapBarrierId = static_cast<NvU32>((packed >> 16) & 0xFFFF);
+            configuration.hardwareFrameCounter = ((packed >> 32) & 1) != 0;
+            return configuration;
+        }
+    };
+
     class PluginCSwapGroupClient
     {
     public:
-        PluginCSwapGroupClient();
+        explicit PluginCSwapGroupClient(std::unique_ptr<INvSwapGroupApi> swapGroupApi);
         ~PluginCSwapGroupClient();
 
         enum class InitializeStatus
@@ -39,19 +71,173 @@ namespace GfxQuadroSync
         void DisposeWorkStation();
 
         bool Render(IGraphicsDevice* pGraphicsDevice);
-        void SkipSynchronizedPresentOfNextFrame() { m_SkipSynchronizedPresentOfNextFrame = true; }
+        void SkipSynchronizedPresentOfNextFrame()
+        {
+            m_SkipSynchronizedPresentOfNextFrame.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * Starts (or stops) watching for presents blocked in the swap barrier for too long.
+         *
+         * \param[in] thresholdMs Presents blocked for longer than this are stalled (0 to stop watching).
+         * \param[in] skipSynchronizationOnStall Skip the synchronized present of the frame following a stalled present
+         *                                       (so that Unity presents it itself, without waiting on the barrier).
+         * \param[in] stallCallback (Optional) Called (from the watchdog thread) every time a stall is detected.
+         */
+        void EnableStallWatchdog(uint32_t thresholdMs, bool skipSynchronizationOnStall,
+            PresentWatchdog::StallCallback stallCallback = nullptr);
+        const PresentWatchdog& GetStallWatchdog() const { return m_StallWatchdog; }
+
+        /// Does the next Render have to warm up the barrier (repeating presents until it is warmed up).
+        bool NeedsBarrierWarmup() const { return m_NeedToWarmUpBarrier; }
         void ResetFrameCount(IUnknown* pDevice);
+        /// Frame count sampled from the hardware counter at every call (or counted by the plugin when there is none).
         NvU32 QueryFrameCount(IUnknown* pDevice);
+        /// Estimate of the hardware frame count, only sampled on a throttled schedule and extrapolated in between.
+        FrameCountEstimate QueryFrameCountEstimate(IUnknown* pDevice);
+
+        /// Settings that can be changed through PostConfigurationChange.
+        enum class ConfigurationSetting : uint32_t
+        {
+            /// EnableSystem
+            System = 0,
+            /// EnableSwapGroup
+            SwapGroup = 1,
+            /// EnableSwapBarrier
+            SwapBarrier = 2,
+            /// Hardware frame counter (SwapGroupConfiguration::hardwareFrameCounter)
+            SyncCounter = 3,
+        };
+
+        /**
+         * Posts a change of configuration to be applied by the next ApplyPendingConfiguration.
+         *
+         * \return Epoch of the change (applied once GetAppliedConfigurationEpoch reaches it).
+         *
+         * \remark Lock-free and can be called from any thread.  Changes are applied in the order they were posted (a
+         *         setting changed multiple times before being applied only takes its last value).
+         */
+        uint32_t PostConfigurationChange(ConfigurationSetting setting, bool value);
+        bool HasPendingConfiguration() const { return m_ConfigurationMailbox.HasPending(); }
+        uint32_t GetAppliedConfigurationEpoch() const { return m_ConfigurationMailbox.GetAppliedEpoch(); }
+
+        /**
+         * Applies the configuration changes posted since the last call.
+         *
+         * \return Was any change applied.
+         *
+         * \remark Like Reconfigure (that it calls), must be called between frames, from the rendering thread.
+         */
+        bool ApplyPendingConfiguration(IUnknown* pDevice, IDXGISwapChain* pSwapChain);
+
+        enum class ReconfigureStatus
+        {
+            Success,
+            InvalidConfiguration,
+            FailedToJoinSwapGroup,
+            FailedToBindSwapBarrier,
+            /// Reconfiguration failed and the previous membership could not be restored.
+            RollbackFailed,
+        };
+
+        /**
+         * Changes the swap group and barrier membership (and the frame counter used) with as few driver calls as
+         * possible.
+         *
+         * The live membership is queried from the driver and only the calls needed to go from it to \a target are
+         * made: unbinding the barrier (before changing swap group), joining the swap group and binding the barrier
+         * (once the swap group is joined).  If any of them fails, the ones already made are undone.  The barrier is
+         * warmed up again only if it was bound by the call.
+         *
+         * \return Status (membership is unchanged if not Success, unless RollbackFailed).
+         */
+        ReconfigureStatus Reconfigure(IUnknown* pDevice, IDXGISwapChain* pSwapChain,
+            const SwapGroupConfiguration& target);
+        /// Membership and frame counter as of the last change.
+        SwapGroupConfiguration GetConfiguration() const;
+
+        /**
+         * Selects the swap group and barrier joined by Initialize, EnableSystem, EnableSwapGroup and EnableSwapBarrier
+         * (1 and 1 by default), so that independent walls driven from the same sync chain can use different barriers.
+         *
+         * \param[in] swapGroupId Swap group to join (> 0).
+         * \param[in] swapBarrierId Swap barrier to bind the swap group to (0 to only join the swap group).
+         *
+         * \return False (and previous selection kept) if the ids are out of range (compared to the maximums returned
+         *         by NvAPI_D3D1x_QueryMaxSwapGroup once initialized).
+         *
+         * \remark Can be called from any thread.  Does not change the current membership (see Reconfigure).
+         */
+        bool SetSwapGroupIds(NvU32 swapGroupId, NvU32 swapBarrierId);
+        NvU32 GetSelectedSwapGroupId() const { return m_SelectedIds.load(std::memory_order_relaxed) & 0xFFFF; }
+        NvU32 GetSelectedSwapBarrierId() const { return m_SelectedIds.load(std::memory_order_relaxed) >> 16; }
+
+        /**
+         * Is \a identity different from the swap chain seen by the last OnSwapChainChanged (cheap enough to be called
+         * every frame).
+         */
+        bool HasSwapChainChanged(const SwapChainIdentity& identity) const
+        {
+            return m_SwapChainMonitor.HasChanged(identity);
+        }
+
+        /**
+         * Switches \a pGraphicsDevice to the swap chain presented by Unity and, if it was recreated or resized,
+         * rejoins the swap group and barrier that were joined (through Reconfigure, so the barrier is warmed up again
+         * if it had to be bound again).
+         *
+         * \return What changed (None the first time, there is nothing to rejoin).
+         *
+         * \remark Must be called between frames, from the rendering thread.
+         */
+        SwapChainChange OnSwapChainChanged(IGraphicsDevice* pGraphicsDevice, const SwapChainIdentity& identity);
+
+        /// Swap chain changes and how long the node was out of sync because of them (lock-free, from any thread).
+        SwapChainChangeReport GetSwapChainChangeReport() const { return m_SwapChainChangeReport.Read(); }
+
+        /// Delay between attempts of RecoverDevice to join the swap group and barrier again.
+        static constexpr uint32_t k_RejoinRetryIntervalMs = 500;
+
+        /**
+         * Do the swap group and barrier have to be joined again because of failed presents (see RecoverDevice)?
+         * Render returns false without presenting until they are.
+         *
+         * \remark Cheap enough to be called every frame.
+         */
+        bool NeedsDeviceRecovery() const { return m_NeedDeviceRecovery; }
+
+        /**
+         * Joins the swap group and barrier that were joined before presents failed (see NeedsDeviceRecovery) once
+         * \a pGraphicsDevice is usable again (Unity creates a new device after a TDR).  The barrier is then warmed up
+         * again (by the BarrierWarmupPolicy if nothing else decides of warmups).
+         *
+         * \return Were the swap group and barrier joined again (false while the device is still removed or if joining
+         *         failed, in which case it is attempted again after k_RejoinRetryIntervalMs).
+         *
+         * \remark Must be called between frames, from the rendering thread.
+         */
+        bool RecoverDevice(IGraphicsDevice* pGraphicsDevice);
+
+        /// Progress of the recovery from failed presents and how long recoveries took (lock-free, from any thread).
+        DeviceRecoveryReport GetDeviceRecoveryReport() const { return m_DeviceRecoveryReport.Read(); }
 
         void EnableSystem(IUnknown* pDevice, IDXGISwapChain* pSwapChain, bool value);
         void EnableSwapGroup(IUnknown* pDevice, IDXGISwapChain* pSwapChain, bool value);
         NvU32 GetSwapGroupId() const { return m_GroupId.load(std::memory_order_relaxed); }
-        void EnableSwapBarrier(IUnknown* pDevice, bool value);
+        void EnableSwapBarrier(IUnknown* pDevice, IDXGISwapChain* pSwapChain, bool value);
         NvU32 GetSwapBarrierId() const { return m_BarrierId.load(std::memory_order_relaxed); }
-        void EnableSyncCounter(const bool value);
 
         uint64_t GetPresentSuccessCount() const { return m_PresentSuccessCount.load(std::memory_order_relaxed); }
         uint64_t GetPresentFailureCount() const { return m_PresentFailureCount.load(std::memory_order_relaxed); }
+        const PresentTimingRing& GetPresentTimings() const { return m_PresentTimings; }
+
+        /**
+         * Consistent copy of the frame count, swap group and barrier membership and last present result, as they were
+         * after the last call changing them.
+         *
+         * \remark Lock-free and can be called from any thread (does not call NvAPI).
+         */
+        SwapGroupSnapshot GetSnapshot() const { return m_Snapshot.Read(); }
 
         enum class BarrierWarmupAction
         {
@@ -68,26 +254,144 @@ namespace GfxQuadroSync
             m_BarrierWarmupCallback = callback ? callback : &EmptyBarrierWarmupCallback;
         }
 
+        /**
+         * Selects what decides when the swap barrier is warmed up: the callback set by SetBarrierWarmupCallback (the
+         * default) or a BarrierWarmupPolicy, that repeats presents until they are paced by the barrier without calling
+         * managed code.
+         *
+         * \param[in] settings Settings of the BarrierWarmupPolicy (nullptr to use the callback again).
+         *
+         * \remark Can be called from any thread, used by the next warmup.
+         */
+        void SetBarrierWarmupPolicy(const BarrierWarmupPolicy::Settings* settings);
+
+        /// Progress and outcome of the last warmup done by the BarrierWarmupPolicy (lock-free, from any thread).
+        BarrierWarmupReport GetBarrierWarmupReport() const { return m_BarrierWarmupReport.Read(); }
+
+        /**
+         * Selects whether warmup decisions are read from the action slot filled by PostBarrierWarmupAction instead of
+         * asking the callback set by SetBarrierWarmupCallback, so that the thread presenting frames never waits on
+         * managed code (and whatever it waits on) during the warmup.
+         *
+         * \remark Ignored while a BarrierWarmupPolicy is set.  Can be called from any thread, used from the next
+         *         warmup present.
+         */
+        void SetBarrierWarmupActionSlotEnabled(bool enabled);
+
+        /**
+         * Posts what to do after the next warmup presents (read without blocking after each of them).
+         *
+         * RepeatPresent and ContinueToNextFrame stay posted until replaced while BarrierWarmedUp is consumed by the
+         * warmup it concludes.  Warmup presents continue to the next frame as long as nothing is posted.
+         *
+         * \remark Lock-free and can be called from any thread.
+         */
+        void PostBarrierWarmupAction(BarrierWarmupAction action);
+
+        /// Number of warmup presents done so far (published before reading the action slot after each of them), can
+        /// be read from any thread to follow the progress of the warmup.
+        uint64_t GetBarrierWarmupPresentSequence() const
+        {
+            return m_BarrierWarmupPresentSequence.load(std::memory_order_acquire);
+        }
+
     private:
         static BarrierWarmupAction EmptyBarrierWarmupCallback() { return BarrierWarmupAction::ContinueToNextFrame; }
 
+        InitializeStatus InitializeSwapGroupAndBarrier(IUnknown* pDevice, IDXGISwapChain* pSwapChain);
+        /// Swap group to join when enabling it (0 if NvAPI reported no swap group).
+        NvU32 GetEnabledSwapGroupId() const { return m_GSyncSwapGroups > 0 ? GetSelectedSwapGroupId() : 0; }
+        /// Swap barrier to bind when enabling it (0 if NvAPI reported no swap barrier).
+        NvU32 GetEnabledSwapBarrierId() const { return m_GSyncBarriers > 0 ? GetSelectedSwapBarrierId() : 0; }
+        void RecordSkippedPresent();
+        /// The node is synchronized again after a swap chain change (if it was not already).
+        void SwapChainResynchronized();
+        /// Feeds a failed present to m_DeviceRecovery (and starts a recovery if needed).
+        void OnPresentFailed(IGraphicsDevice* pGraphicsDevice, NvAPI_Status status, uint64_t tick);
+        /// Stops presenting through NvAPI until RecoverDevice joined the swap group and barrier again.
+        void StartDeviceRecovery(IGraphicsDevice* pGraphicsDevice, bool wasRecovering);
+        /// Completes the recovery started by OnPresentFailed (if any).
+        void DeviceRecovered();
+        void PublishDeviceRecoveryReport();
+        /// Feeds the present that just ended to m_BarrierWarmupPolicy (and publishes its report).
+        BarrierWarmupAction ApplyBarrierWarmupPolicy(IUnknown* pDevice, uint64_t presentEndTick);
+        /// Reads the action posted by PostBarrierWarmupAction (consuming BarrierWarmedUp).
+        BarrierWarmupAction TakePostedBarrierWarmupAction();
+
+        /**
+         * Publishes a new SwapGroupSnapshot (always refreshing the swap group and barrier membership).
+         *
+         * \param[in] modify Function receiving the snapshot to update the other fields.
+         */
+        template <class Modify>
+        void PublishSnapshot(Modify&& modify)
+        {
+            m_Snapshot.Update([this, &modify](SwapGroupSnapshot& snapshot)
+            {
+                snapshot.swapGroupId = m_GroupId.load(std::memory_order_relaxed);
+                snapshot.swapBarrierId = m_BarrierId.load(std::memory_order_relaxed);
+                modify(snapshot);
+            });
+        }
+        void PublishSnapshot() { PublishSnapshot([](SwapGroupSnapshot&) {}); }
+        void PublishFrameCountSnapshot(uint64_t nowTick);
+
+        const std::unique_ptr<INvSwapGroupApi> m_SwapGroupApi;
+
         // Remarks: Some variables are atomic because they can be accessed from the rendering thread or the game loop
         // thread for the implementation of the GetState function.  There is no need for a strong correlation between
         // each of the variables since the GetState function is only for reporting the state, so using atomic is enough
         // (and faster than a mutex).
         std::atomic<NvU32> m_GroupId = 1;
         std::atomic<NvU32> m_BarrierId = 1;
+        // Swap group (low 16 bits) and barrier (high 16 bits) selected by SetSwapGroupIds.
+        std::atomic<uint32_t> m_SelectedIds = 1 | (1 << 16);
         NvU32 m_FrameCount = 0;
-        NvU32 m_GSyncSwapGroups = 0;
-        NvU32 m_GSyncBarriers = 0;
+        // Atomic since they are read by SetSwapGroupIds to validate the ids.
+        std::atomic<NvU32> m_GSyncSwapGroups = 0;
+        std::atomic<NvU32> m_GSyncBarriers = 0;
         bool m_GSyncMaster = true;
+        // Only written by the rendering thread, between frames (Initialize, ApplyPendingConfiguration, Reconfigure and
+        // the Enable* methods), so they are not atomic.  Other threads change them through PostConfigurationChange and
+        // read them through GetSnapshot.
         bool m_GSyncCounter = false;
         bool m_IsActive = false;
         bool m_NeedToWarmUpBarrier = false;
-        bool m_SkipSynchronizedPresentOfNextFrame = false;
+        // Atomic since it can also be set by the stall watchdog thread.
+        std::atomic<bool> m_SkipSynchronizedPresentOfNextFrame = false;
         std::atomic<uint64_t> m_PresentSuccessCount = 0;
         std::atomic<uint64_t> m_PresentFailureCount = 0;
         BarrierWarmupCallback m_BarrierWarmupCallback = &EmptyBarrierWarmupCallback;
+        // Settings are written before the flag, so they are complete when it is seen set.
+        std::atomic<bool> m_UseBarrierWarmupPolicy = false;
+        SeqLock<BarrierWarmupPolicy::Settings> m_BarrierWarmupSettings;
+        BarrierWarmupPolicy m_BarrierWarmupPolicy;
+        BarrierWarmupReportMirror m_BarrierWarmupReport;
+        std::atomic<bool> m_UseBarrierWarmupActionSlot = false;
+        // BarrierWarmupAction + 1 posted by PostBarrierWarmupAction (0 when nothing is posted).
+        std::atomic<uint32_t> m_PostedBarrierWarmupAction = 0;
+        std::atomic<uint64_t> m_BarrierWarmupPresentSequence = 0;
+        // Only used by the thread presenting frames, so that warmups spanning multiple frames initiate present repeats
+        // only once.
+        bool m_PresentRepeatsInitiated = false;
+        // Written only from the rendering thread, can be read from any thread.
+        PresentTimingRing m_PresentTimings;
+        FrameCountService m_FrameCountService;
+        PresentWatchdog m_StallWatchdog;
+        SwapGroupSnapshotMirror m_Snapshot;
+        ConfigurationMailbox m_ConfigurationMailbox;
+        // Only used by the rendering thread.
+        SwapChainMonitor m_SwapChainMonitor;
+        SwapChainChangeReportMirror m_SwapChainChangeReport;
+        // The following are only used by the rendering thread.
+        bool m_NeedDeviceRecovery = false;
+        SwapGroupConfiguration m_DeviceRecoveryTarget;
+        uint64_t m_NextRejoinAttemptTick = 0;
+        // The barrier warmup follows a rejoin done on our own (after a swap chain change or a recovery) so it is
+        // decided by the BarrierWarmupPolicy if nothing else decides of warmups.
+        bool m_AutomaticBarrierWarmup = false;
+        DeviceRecovery m_DeviceRecovery;
+        DeviceRecoveryReportMirror m_DeviceRecoveryReport;
     };
 
 }
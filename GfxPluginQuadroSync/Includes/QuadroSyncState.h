@@ -0,0 +1,102 @@
+#pragma once
+
+#include "SeqLock.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace GfxQuadroSync
+{
+    /// Groups of fields of QuadroSyncState filled by the plugin (combined in QuadroSyncState::capabilities).
+    enum class QuadroSyncStateCapabilities : uint64_t
+    {
+        None = 0,
+        /// initializationState, swapGroupId, swapBarrierId, presentedFramesSuccess and presentedFramesFailed.
+        PresentCounters = 1 << 0,
+        /// suppressedLogMessages and droppedLogMessages.
+        LogCounters = 1 << 1,
+        /// presentStallCount, lastPresentStallDurationNs and presentStalled.
+        PresentStallWatchdog = 1 << 2,
+    };
+
+    inline QuadroSyncStateCapabilities operator|(const QuadroSyncStateCapabilities a,
+        const QuadroSyncStateCapabilities b)
+    {
+        return static_cast<QuadroSyncStateCapabilities>(static_cast<uint64_t>(a) | static_cast<uint64_t>(b));
+    }
+
+    /**
+     * \brief Status of the QuadroSync plugin as returned by GetState and published in the state mirror.
+     *
+     * The struct starts with its size, its version and the fields it contains (capabilities), so that new fields can
+     * be added without breaking older readers: new fields are only ever appended (with a new capability bit and a new
+     * version), readers only look at the fields they know of and that are within size.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncState in
+     *         GfxPluginQuadroSyncState.cs.
+     */
+    struct QuadroSyncState
+    {
+        /// Current version of the struct.
+        static constexpr uint32_t k_Version = 1;
+
+        /// Size of the struct (in bytes).
+        uint32_t size = sizeof(QuadroSyncState);
+        /// Version of the struct.
+        uint32_t version = k_Version;
+        /// Combination of QuadroSyncStateCapabilities telling which fields are filled.
+        uint64_t capabilities = 0;
+
+        /// Initialization status of the QuadroSync system (not using QuadroSyncInitializationStatus for safer interop
+        /// with managed code)
+        uint32_t initializationState = 0;
+        /// Swap Group ID
+        uint32_t swapGroupId = 0;
+        /// Swap Barrier ID
+        uint32_t swapBarrierId = 0;
+        /// Is the present in progress stalled (1) or not (0)
+        uint32_t presentStalled = 0;
+        /// Number of frames successfully presented using QuadroSync's present call
+        uint64_t presentedFramesSuccess = 0;
+        /// Number of frames that failed to be presented using QuadroSync's present call
+        uint64_t presentedFramesFailed = 0;
+        /// Number of log messages suppressed because they were repeated too often
+        uint64_t suppressedLogMessages = 0;
+        /// Number of log messages dropped because they were produced faster than they were delivered
+        uint64_t droppedLogMessages = 0;
+        /// Number of presents blocked for longer than the stall watchdog threshold
+        uint64_t presentStallCount = 0;
+        /// Duration (in nanoseconds) of the last stalled present that completed
+        uint64_t lastPresentStallDurationNs = 0;
+    };
+
+    /// Size of the fields common to every version of QuadroSyncState (size, version and capabilities).
+    constexpr uint32_t k_QuadroSyncStateHeaderSize = offsetof(QuadroSyncState, initializationState);
+
+    /// Lock-free mirror of the QuadroSyncState, readable without calling into the plugin.
+    typedef SeqLock<QuadroSyncState> QuadroSyncStateMirror;
+
+    /**
+     * Copies \a source into the caller's struct, truncated to the size the caller put in destination->size.
+     *
+     * \param[in] source Complete state.
+     * \param[in,out] destination Caller's struct, its size field is set to the number of bytes filled.
+     *
+     * \return False if destination->size is too small to even receive the header of the struct.
+     */
+    inline bool CopyQuadroSyncState(const QuadroSyncState& source, QuadroSyncState* const destination)
+    {
+        const uint32_t destinationSize = destination->size;
+        if (destinationSize < k_QuadroSyncStateHeaderSize)
+        {
+            return false;
+        }
+
+        const auto copySize = std::min(destinationSize, static_cast<uint32_t>(sizeof(QuadroSyncState)));
+        std::memcpy(reinterpret_cast<char*>(destination), &source, copySize);
+        destination->size = copySize;
+        return true;
+    }
+}
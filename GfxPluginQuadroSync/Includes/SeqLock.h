@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Value of type T that can be read from any thread (or process mapping its memory) without any lock.
+     *
+     * The sequence number is odd while the value is being modified.  Readers copy the value and validate the sequence
+     * number did not change (and was even) during the copy, retrying otherwise.  Writers never wait on readers.
+     *
+     * \remark The memory layout is part of the interface (readers in managed code access it directly): a 64 bits
+     *         sequence number immediately followed by the value.
+     * \remark Writes from multiple threads are serialized (a writer spins while another one is modifying the value).
+     */
+    template <class T>
+    class SeqLock final
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock value must be trivially copyable");
+        static_assert(sizeof(T) % sizeof(uint64_t) == 0, "SeqLock value size must be a multiple of 8 bytes");
+
+    public:
+        SeqLock() { StoreWords(T()); }
+        explicit SeqLock(const T& initialValue) { StoreWords(initialValue); }
+        SeqLock(const SeqLock&) = delete;
+        SeqLock& operator=(const SeqLock&) = delete;
+
+        /**
+         * Modifies the value.
+         *
+         * \param[in] modify Function receiving a reference to a copy of the current value to modify (executed while
+         *                   holding the write side of the lock, so it should be short).
+         */
+        template <class Modify>
+        void Update(Modify&& modify)
+        {
+            auto sequence = m_Sequence.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if ((sequence & 1) == 0 &&
+                    m_Sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+                        std::memory_order_relaxed))
+                {
+                    break;
+                }
+                if ((sequence & 1) != 0)
+                {
+                    std::this_thread::yield();
+                    sequence = m_Sequence.load(std::memory_order_relaxed);
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+
+            T value;
+            LoadWords(value);
+            modify(value);
+            StoreWords(value);
+
+            m_Sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /// Replaces the value.
+        void Write(const T& value)
+        {
+            Update([&value](T& toModify) { toModify = value; });
+        }
+
+        /**
+         * Tries to get a consistent copy of the value.
+         *
+         * \return False if the value was being modified (\a value is then garbage).
+         */
+        bool TryRead(T& value) const
+        {
+            const auto sequence = m_Sequence.load(std::memory_order_acquire);
+            if ((sequence & 1) != 0)
+            {
+                return false;
+            }
+            LoadWords(value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return m_Sequence.load(std::memory_order_relaxed) == sequence;
+        }
+
+        /// Returns a consistent copy of the value (retrying while it is being modified).
+        T Read() const
+        {
+            T value;
+            while (!TryRead(value))
+            {
+                std::this_thread::yield();
+            }
+            return value;
+        }
+
+        /// Sequence number, incremented by 2 for every modification.
+        uint64_t GetSequence() const { return m_Sequence.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr size_t k_WordCount = sizeof(T) / sizeof(uint64_t);
+
+        void LoadWords(T& value) const
+        {
+            uint64_t words[k_WordCount];
+            for (size_t i = 0; i < k_WordCount; ++i)
+            {
+                words[i] = m_Words[i].load(std::memory_order_relaxed);
+            }
+            std::memcpy(&value, words, sizeof(T));
+        }
+
+        void StoreWords(const T& value)
+        {
+            uint64_t words[k_WordCount];
+            std::memcpy(words, &value, sizeof(T));
+            for (size_t i = 0; i < k_WordCount; ++i)
+            {
+                m_Words[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<uint64_t> m_Sequence{0};
+        std::atomic<uint64_t> m_Words[k_WordCount];
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Named memory region shared between processes (file mapping backed by the paging file on Windows, POSIX
+     *        shared memory object elsewhere).
+     */
+    class SharedMemory final
+    {
+    public:
+        SharedMemory() = default;
+        ~SharedMemory();
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        /**
+         * Creates the named region (or opens it if it already exists) and maps it in read / write.
+         *
+         * \param[in] name Name of the region (on POSIX a '/' is prepended if missing).
+         * \param[in] size Size of the region (in bytes).
+         *
+         * \return Success (the previous region, if any, is closed in any case).
+         */
+        bool Create(const std::string& name, size_t size);
+
+        /**
+         * Opens an existing named region and maps it in read only.
+         *
+         * \param[in] name Name of the region.
+         * \param[in] size Size of the region to map (in bytes).
+         *
+         * \return Success (the previous region, if any, is closed in any case).
+         */
+        bool OpenReadOnly(const std::string& name, size_t size);
+
+        /// Unmaps the region (and removes its name if it was created by us on POSIX, Windows does it automatically
+        /// once every process closed it).
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        void* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        bool Map(const std::string& name, size_t size, bool create);
+
+        void* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void* m_MappingHandle = nullptr;
+#else
+        std::string m_UnlinkName;
+#endif
+    };
+}
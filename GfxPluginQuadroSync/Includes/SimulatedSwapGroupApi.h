@@ -0,0 +1,118 @@
+#pragma once
+
+#include "INvSwapGroupApi.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Implementation of INvSwapGroupApi simulating Quadro Sync hardware.
+     *
+     * Simulates a configurable number of swap groups and barriers, a vertical blank clock at a chosen refresh rate
+     * (driving the frame counter and blocking presents of swap chains that joined a swap group), an additional present
+     * latency and the injection of failures in any of the calls.  Allows to exercise and benchmark
+     * PluginCSwapGroupClient on machines without the hardware (or without any GPU at all).
+     *
+     * \remark Device and swap chain pointers are never dereferenced, any non null value is accepted.
+     * \remark Thread safe.
+     */
+    class SimulatedSwapGroupApi final : public INvSwapGroupApi
+    {
+    public:
+        /// Configuration of the simulated hardware.
+        struct Config
+        {
+            /// Number of swap groups reported by QueryMaxSwapGroup.
+            NvU32 maxSwapGroups = 1;
+            /// Number of swap barriers reported by QueryMaxSwapGroup.
+            NvU32 maxSwapBarriers = 1;
+            /// Number of physical GPUs reported by EnumPhysicalGPUs.
+            NvU32 gpuCount = 1;
+            /// Refresh rate of the simulated vertical blank clock (0 to disable waiting for vertical blank).
+            double refreshRateHz = 60.0;
+            /// Time spent in Present in addition to the wait for the vertical blank.
+            std::chrono::nanoseconds presentLatency{0};
+        };
+
+        /// Identifies the methods of the class (for failure injection and call counts).
+        enum class Call
+        {
+            Initialize,
+            EnumPhysicalGPUs,
+            SetupWorkstationSwapGroupFeature,
+            QueryMaxSwapGroup,
+            JoinSwapGroup,
+            BindSwapBarrier,
+            QuerySwapGroup,
+            QueryFrameCount,
+            ResetFrameCount,
+            Present,
+            Count
+        };
+
+        SimulatedSwapGroupApi() : SimulatedSwapGroupApi(Config()) {}
+        explicit SimulatedSwapGroupApi(const Config& config);
+
+        /**
+         * Make the next \a count calls to \a call fail with \a status (without changing the simulated state).
+         *
+         * \remark Calling it again for the same call replaces the previous injection.
+         */
+        void InjectFailure(Call call, NvAPI_Status status, uint32_t count = 1);
+
+        /// Returns how many times \a call has been called (including calls that failed).
+        uint64_t GetCallCount(Call call) const;
+
+        /// Returns the simulated frame counter (number of vertical blanks since creation or last ResetFrameCount).
+        NvU32 GetFrameCount() const;
+
+        NvAPI_Status Initialize() override;
+
+        NvAPI_Status EnumPhysicalGPUs(NvPhysicalGpuHandle gpuHandles[NVAPI_MAX_PHYSICAL_GPUS],
+            NvU32* gpuCount) override;
+        NvAPI_Status SetupWorkstationSwapGroupFeature(NvPhysicalGpuHandle gpuHandle, bool enable) override;
+
+        NvAPI_Status QueryMaxSwapGroup(IUnknown* device, NvU32* maxGroups, NvU32* maxBarriers) override;
+        NvAPI_Status JoinSwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32 group, bool blocking) override;
+        NvAPI_Status BindSwapBarrier(IUnknown* device, NvU32 group, NvU32 barrier) override;
+        NvAPI_Status QuerySwapGroup(IUnknown* device, IDXGISwapChain* swapChain, NvU32* group,
+            NvU32* barrier) override;
+
+        NvAPI_Status QueryFrameCount(IUnknown* device, NvU32* frameCount) override;
+        NvAPI_Status ResetFrameCount(IUnknown* device) override;
+
+        NvAPI_Status Present(IUnknown* device, IDXGISwapChain* swapChain, NvU32 syncInterval, NvU32 flags) override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /// Count the call and returns the injected failure for it (NVAPI_OK if none).  Must be called with m_Lock held.
+        NvAPI_Status BeginCall(Call call);
+        /// Number of vertical blanks since m_VblankOrigin.  Must be called with m_Lock held.
+        uint64_t VblanksSinceOrigin(Clock::time_point now) const;
+
+        const Config m_Config;
+        const Clock::duration m_RefreshPeriod;
+
+        mutable std::mutex m_Lock;
+        bool m_Initialized = false;
+        bool m_WorkstationFeatureEnabled = false;
+        NvU32 m_GroupId = 0;
+        NvU32 m_BarrierId = 0;
+        /// Swap chain that joined m_GroupId (other swap chains are not members of any swap group).
+        IDXGISwapChain* m_SwapChain = nullptr;
+        Clock::time_point m_VblankOrigin;
+        uint64_t m_FrameCountOffset = 0;
+
+        struct InjectedFailure
+        {
+            NvAPI_Status status = NVAPI_OK;
+            uint32_t remaining = 0;
+        };
+        InjectedFailure m_InjectedFailures[static_cast<int>(Call::Count)];
+        uint64_t m_CallCounts[static_cast<int>(Call::Count)] = {};
+    };
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "SeqLock.h"
+
+#include <cstdint>
+
+struct IDXGISwapChain;
+
+namespace GfxQuadroSync
+{
+    /// What makes a swap chain presented by Unity different from the previous one (checked every frame).
+    struct SwapChainIdentity
+    {
+        /// Swap chain as returned by Unity (recreated on some resolution or fullscreen changes).
+        IDXGISwapChain* swapChain = nullptr;
+        /// Fields of DXGI_SWAP_CHAIN_DESC changed by IDXGISwapChain::ResizeBuffers or fullscreen transitions.
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;
+        uint32_t bufferCount = 0;
+        uint32_t flags = 0;
+        uint32_t windowed = 0;
+
+        bool operator==(const SwapChainIdentity& other) const
+        {
+            return swapChain == other.swapChain && width == other.width && height == other.height &&
+                format == other.format && bufferCount == other.bufferCount && flags == other.flags &&
+                windowed == other.windowed;
+        }
+        bool operator!=(const SwapChainIdentity& other) const { return !(*this == other); }
+    };
+
+    /// Flags of SwapChainChangeReport::lastChange.
+    enum class SwapChainChange : uint32_t
+    {
+        None = 0,
+        /// Unity presents through a new swap chain.
+        Recreated = 1 << 0,
+        /// Description of the swap chain changed (resolution, format, fullscreen, ...).
+        Resized = 1 << 1,
+    };
+
+    /**
+     * \brief Swap chain changes detected by SwapChainMonitor and how long the node was out of sync because of them.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncSwapChainReport
+     *         in GfxPluginQuadroSyncState.cs.
+     */
+    struct SwapChainChangeReport
+    {
+        /// Number of swap chain changes detected.
+        uint32_t changeCount = 0;
+        /// Combination of SwapChainChange of the last change.
+        uint32_t lastChange = 0;
+        /// PluginCSwapGroupClient::ReconfigureStatus of the rejoin that followed the last change (0 is Success).
+        uint32_t lastRejoinStatus = 0;
+        /// Is the node out of sync (rejoining the swap group and barrier or warming up the barrier again).
+        uint32_t outOfSync = 0;
+        /// Performance counter tick at which the node got out of sync (first change detected since it was last
+        /// synchronized).
+        uint64_t lastChangeTick = 0;
+        /// Performance counter tick at which the node was synchronized again after the last change (0 if not yet).
+        uint64_t lastResynchronizedTick = 0;
+        /// Performance counter ticks the node was out of sync after the last change (0 if still out of sync).
+        uint64_t lastOutOfSyncTicks = 0;
+        /// Performance counter ticks the node was out of sync after all the changes (not counting the current one).
+        uint64_t totalOutOfSyncTicks = 0;
+    };
+
+    /// Lock-free publication of SwapChainChangeReport.
+    typedef SeqLock<SwapChainChangeReport> SwapChainChangeReportMirror;
+
+    /**
+     * \brief Detects swap chains recreated or resized by Unity (that silently leave the swap group) and measures how
+     *        long it takes to be synchronized again.
+     *
+     * \remark Not thread safe, expected to be used from the rendering thread.
+     */
+    class SwapChainMonitor final
+    {
+    public:
+        /// Is \a identity different from the one of the last call to Observe (cheap enough to be checked every frame).
+        bool HasChanged(const SwapChainIdentity& identity) const { return identity != m_Identity; }
+
+        /**
+         * Remembers the swap chain presented by Unity.
+         *
+         * \param[in] identity Swap chain presented by Unity.
+         * \param[in] tick Performance counter tick at which it was detected.
+         *
+         * \return What changed since the last call (always None for the first call, there is nothing to rejoin).
+         */
+        SwapChainChange Observe(const SwapChainIdentity& identity, uint64_t tick);
+
+        /// Sets SwapChainChangeReport::lastRejoinStatus.
+        void SetRejoinStatus(uint32_t status) { m_Report.lastRejoinStatus = status; }
+
+        /// The node is synchronized again (does nothing if it was not out of sync).
+        void Resynchronized(uint64_t tick);
+
+        bool IsOutOfSync() const { return m_Report.outOfSync != 0; }
+        const SwapChainChangeReport& GetReport() const { return m_Report; }
+
+    private:
+        bool m_HasIdentity = false;
+        SwapChainIdentity m_Identity;
+        SwapChainChangeReport m_Report;
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FrameCountService.h"
+#include "SeqLock.h"
+
+#include <cstdint>
+
+namespace GfxQuadroSync
+{
+    /// Flags of SwapGroupSnapshot::flags.
+    enum class SwapGroupSnapshotFlags : uint32_t
+    {
+        None = 0,
+        /// frameCount is the hardware frame counter (shared by every node of the swap group) as opposed to the custom
+        /// frame counter (incremented by every QueryFrameCount).
+        HardwareFrameCounter = 1 << 0,
+        /// At least one frame was presented through NvAPI (the lastPresent* fields are meaningful).
+        HasPresented = 1 << 1,
+    };
+
+    /**
+     * \brief State of a PluginCSwapGroupClient published after every change so that it can be queried from any
+     *        thread without waiting on the rendering thread.
+     *
+     * \remark Any change to this struct must be matched in Unity.ClusterDisplay.GfxPluginQuadroSyncSnapshot in
+     *         GfxPluginQuadroSyncState.cs.
+     */
+    struct SwapGroupSnapshot
+    {
+        /// Frame count at frameCountTick (hardware counter is wrap around corrected, truncate it to 32 bits to get
+        /// the value returned by QuadroSyncQueryFrameCount).
+        uint64_t frameCount = 0;
+        /// Performance counter tick at which frameCount was valid.
+        uint64_t frameCountTick = 0;
+        /// Measured refresh period (in performance counter ticks) to extrapolate frameCount (0 if unknown or if
+        /// frameCount is not the hardware frame counter).
+        double refreshPeriodTicks = 0;
+        /// Number of presents done through NvAPI (successful or not) since the client was created.
+        uint64_t presentCount = 0;
+        /// Performance counter tick at which the last present through NvAPI returned.
+        uint64_t lastPresentEndTick = 0;
+        /// NvAPI_Status returned by the last present through NvAPI.
+        int32_t lastPresentStatus = 0;
+        /// Swap group joined (0 if none).
+        uint32_t swapGroupId = 0;
+        /// Swap barrier bound (0 if none).
+        uint32_t swapBarrierId = 0;
+        /// Combination of SwapGroupSnapshotFlags.
+        uint32_t flags = 0;
+        /// How much frameCount can be trusted at frameCountTick (FrameCountConfidence, None or Sampled).
+        uint32_t frameCountConfidence = 0;
+        uint32_t padding = 0;
+    };
+
+    /// Lock-free publication of SwapGroupSnapshot.
+    typedef SeqLock<SwapGroupSnapshot> SwapGroupSnapshotMirror;
+
+    /**
+     * Extrapolates the frame count of a snapshot to another time (the same way FrameCountService::Estimate does).
+     *
+     * \param[in] snapshot Snapshot to extrapolate.
+     * \param[in] nowTick Performance counter tick for which we want the frame count.
+     * \param[out] confidence (Optional) How much the returned value can be trusted.
+     *
+     * \return Frame count at \a nowTick.
+     */
+    inline uint64_t ExtrapolateFrameCount(const SwapGroupSnapshot& snapshot, const uint64_t nowTick,
+        FrameCountConfidence* const confidence = nullptr)
+    {
+        auto resultConfidence = static_cast<FrameCountConfidence>(snapshot.frameCountConfidence);
+        auto frameCount = snapshot.frameCount;
+        // The custom frame counter only changes when queried, so it does not get stale.
+        if (resultConfidence != FrameCountConfidence::None && nowTick > snapshot.frameCountTick &&
+            (snapshot.flags & static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter)) != 0)
+        {
+            if (snapshot.refreshPeriodTicks > 0)
+            {
+                frameCount += static_cast<uint64_t>((nowTick - snapshot.frameCountTick) /
+                    snapshot.refreshPeriodTicks);
+                resultConfidence = FrameCountConfidence::Extrapolated;
+            }
+            else
+            {
+                resultConfidence = FrameCountConfidence::Stale;
+            }
+        }
+        if (confidence)
+        {
+            *confidence = resultConfidence;
+        }
+        return frameCount;
+    }
+}
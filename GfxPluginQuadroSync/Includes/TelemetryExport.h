@@ -0,0 +1,109 @@
+#pragma once
+
+#include "PresentTimings.h"
+#include "QuadroSyncState.h"
+#include "SharedMemory.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace GfxQuadroSync
+{
+    /**
+     * \brief Header at the beginning of the telemetry shared memory.
+     *
+     * Layout of the shared memory (little endian, every field naturally aligned, offsets in bytes):
+     * - TelemetryHeader (64 bytes).
+     * - At stateOffset: QuadroSyncStateMirror, a uint64 sequence number immediately followed by a QuadroSyncState.
+     *   The sequence number is odd while the state is being modified, readers copy the state and validate the sequence
+     *   number is even and did not change during the copy.
+     * - At timingsOffset: the present timings ring, timingsCapacity slots of 4 uint64 (sequence, presentStartTick,
+     *   presentEndTick, statusAndFlags: status in the low 32 bits and PresentTimingFlags in the high 32 bits) followed
+     *   by a uint64 write index (index of the next entry).  Entry i is in slot i % timingsCapacity and is valid if the
+     *   sequence of the slot is i before and after copying it.
+     *
+     * \remark magic is written last, readers must ignore the memory until it is k_Magic.
+     */
+    struct TelemetryHeader
+    {
+        /// Value of magic once the shared memory is initialized ("QSTM").
+        static constexpr uint32_t k_Magic = 0x4D545351;
+        /// Version of the layout described above.
+        static constexpr uint32_t k_LayoutVersion = 1;
+
+        std::atomic<uint32_t> magic;
+        uint32_t layoutVersion;
+        /// Size of the whole shared memory.
+        uint32_t totalSize;
+        /// Identifier of the process publishing.
+        uint32_t processId;
+        /// Frequency of the ticks of the present timings.
+        uint64_t performanceCounterFrequency;
+        uint32_t stateOffset;
+        uint32_t timingsOffset;
+        uint32_t timingsCapacity;
+        uint32_t reserved[7];
+    };
+    static_assert(sizeof(TelemetryHeader) == 64, "TelemetryHeader is part of the documented layout");
+
+    /// Content of the telemetry shared memory.
+    struct TelemetryBlock
+    {
+        TelemetryHeader header;
+        QuadroSyncStateMirror state;
+        PresentTimingRing timings;
+    };
+
+    /**
+     * \brief Publishes the state of the plugin and its present timings in a named shared memory, so that monitoring
+     *        processes on the same computer can follow it without involving the Unity process.
+     *
+     * \remark Publish is non-blocking: when called concurrently from multiple threads only one of them publishes (the
+     *         other one's changes will be published by the next call).
+     */
+    class TelemetryExport final
+    {
+    public:
+        TelemetryExport() = default;
+        TelemetryExport(const TelemetryExport&) = delete;
+        TelemetryExport& operator=(const TelemetryExport&) = delete;
+
+        /**
+         * Starts publishing in the shared memory with the given name (stopping publishing in the previous one).
+         *
+         * \param[in] name Name of the shared memory (empty to stop publishing).
+         *
+         * \return Success.
+         */
+        bool Open(const std::string& name);
+
+        /// Stops publishing.
+        void Close() { Open(std::string()); }
+
+        /// Is publishing.
+        bool IsOpen() const { return m_Block.load(std::memory_order_relaxed) != nullptr; }
+
+        /**
+         * Publishes the state and the present timings added to \a timings since the previous call.
+         *
+         * \remark Present indexes in the shared memory start at 0 when opened (the presentIndex of \a timings are not
+         *         preserved).
+         */
+        void Publish(const QuadroSyncState& state, const PresentTimingRing& timings);
+
+        /**
+         * Validates the content of a shared memory (for readers).
+         *
+         * \return The TelemetryBlock or nullptr if \a memory does not contain a TelemetryBlock of the expected layout.
+         */
+        static const TelemetryBlock* Validate(const void* memory, size_t size);
+
+    private:
+        std::mutex m_Lock;
+        SharedMemory m_SharedMemory;
+        std::atomic<TelemetryBlock*> m_Block{nullptr};
+        uint64_t m_TimingsReadCursor = 0;
+    };
+}
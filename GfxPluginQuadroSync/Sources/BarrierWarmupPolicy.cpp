@@ -0,0 +1,76 @@
+#include "BarrierWarmupPolicy.h"
+
+namespace GfxQuadroSync
+{
+    void BarrierWarmupPolicy::Start(const Settings& settings)
+    {
+        m_Settings = settings;
+        m_Report = BarrierWarmupReport();
+        m_Report.outcome = static_cast<uint32_t>(BarrierWarmupOutcome::InProgress);
+        m_PreviousPresentEndTick = 0;
+        m_HasPreviousFrameCount = false;
+        m_PreviousFrameCount = 0;
+        m_StableIntervalsTicks = 0;
+    }
+
+    BarrierWarmupPolicy::Decision BarrierWarmupPolicy::OnPresent(const uint64_t presentEndTick,
+        const bool hasFrameCount, const uint64_t frameCount)
+    {
+        ++m_Report.presentCount;
+        if (m_Report.presentCount == 1)
+        {
+            // Nothing to compare the first present with
+            m_Report.startTick = presentEndTick;
+        }
+        else
+        {
+            const uint64_t interval = presentEndTick > m_PreviousPresentEndTick ?
+                presentEndTick - m_PreviousPresentEndTick : 0;
+            bool isStable = true;
+            if (m_Report.stablePresentCount > 0)
+            {
+                const double averageInterval =
+                    static_cast<double>(m_StableIntervalsTicks) / m_Report.stablePresentCount;
+                const double deviation = static_cast<double>(interval) - averageInterval;
+                isStable = (deviation < 0 ? -deviation : deviation) <= averageInterval * m_Settings.intervalTolerance;
+            }
+            if (hasFrameCount && m_HasPreviousFrameCount)
+            {
+                const auto frames = static_cast<int64_t>(frameCount - m_PreviousFrameCount);
+                const auto frameDeviation = frames > 1 ? frames - 1 : 1 - frames;
+                isStable = isStable && frameDeviation <= static_cast<int64_t>(m_Settings.frameCountTolerance);
+            }
+
+            if (isStable)
+            {
+                ++m_Report.stablePresentCount;
+                m_StableIntervalsTicks += interval;
+            }
+            else
+            {
+                // Start a new run of stable presents (after this one)
+                m_Report.stablePresentCount = 0;
+                m_StableIntervalsTicks = 0;
+            }
+        }
+
+        m_PreviousPresentEndTick = presentEndTick;
+        m_HasPreviousFrameCount = hasFrameCount;
+        m_PreviousFrameCount = frameCount;
+        m_Report.endTick = presentEndTick;
+        m_Report.presentIntervalTicks = m_Report.stablePresentCount > 0 ?
+            static_cast<double>(m_StableIntervalsTicks) / m_Report.stablePresentCount : 0;
+
+        if (m_Report.stablePresentCount >= m_Settings.stablePresents)
+        {
+            m_Report.outcome = static_cast<uint32_t>(BarrierWarmupOutcome::Converged);
+            return Decision::Converged;
+        }
+        if (m_Report.presentCount >= m_Settings.maxPresents)
+        {
+            m_Report.outcome = static_cast<uint32_t>(BarrierWarmupOutcome::GaveUp);
+            return Decision::GaveUp;
+        }
+        return Decision::RepeatPresent;
+    }
+}
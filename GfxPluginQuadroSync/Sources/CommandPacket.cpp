@@ -0,0 +1,47 @@
+#include "CommandPacket.h"
+#include "Logger.h"
+
+namespace GfxQuadroSync
+{
+    bool ExecuteCommandPacket(CommandPacketHeader* const packet, const CommandHandler& handler)
+    {
+        if (packet == nullptr)
+        {
+            CLUSTER_LOGF_ERROR(Init, "Command packet is null");
+            return false;
+        }
+        if (packet->version != CommandPacketHeader::k_Version ||
+            packet->commandCount > CommandPacketHeader::k_MaxCommandCount)
+        {
+            CLUSTER_LOGF_ERROR(Init, "Invalid command packet (version {}, {} commands)", packet->version,
+                packet->commandCount);
+            packet->processedCount.store(0, std::memory_order_release);
+            return false;
+        }
+
+        const bool stopOnFailure = (packet->flags & static_cast<uint32_t>(CommandPacketFlags::StopOnFailure)) != 0;
+        bool failed = false;
+        const auto commands = packet->GetCommands();
+        for (uint32_t i = 0; i < packet->commandCount; ++i)
+        {
+            auto& command = commands[i];
+            command.result = 0;
+            if (failed && stopOnFailure)
+            {
+                command.status = static_cast<uint32_t>(CommandStatus::Skipped);
+                continue;
+            }
+
+            const auto status = handler(command.id, command.argument, command.result);
+            command.status = static_cast<uint32_t>(status);
+            if (status != CommandStatus::Succeeded)
+            {
+                CLUSTER_LOGF_WARNING(Init, "Command {} ({}) of command packet failed: {}", i, command.id, status);
+                failed = true;
+            }
+        }
+
+        packet->processedCount.store(packet->commandCount, std::memory_order_release);
+        return true;
+    }
+}
@@ -0,0 +1,28 @@
+#include "ConfigurationMailbox.h"
+
+namespace GfxQuadroSync
+{
+    uint32_t ConfigurationMailbox::Post(const uint32_t changes)
+    {
+        // Both bits of every setting in changes are replaced.
+        const uint32_t changed = changes & 0xAAAAAAAAu;
+        const uint64_t replacedMask = changed | (changed >> 1);
+
+        auto pending = m_Pending.load(std::memory_order_relaxed);
+        uint64_t newPending;
+        do
+        {
+            const auto epoch = static_cast<uint32_t>(pending >> 32) + 1;
+            newPending = (static_cast<uint64_t>(epoch) << 32) | (pending & k_ChangesMask & ~replacedMask) | changes;
+        } while (!m_Pending.compare_exchange_weak(pending, newPending, std::memory_order_acq_rel,
+            std::memory_order_relaxed));
+        return static_cast<uint32_t>(newPending >> 32);
+    }
+
+    uint32_t ConfigurationMailbox::Take(uint32_t& epoch)
+    {
+        const auto pending = m_Pending.fetch_and(~k_ChangesMask, std::memory_order_acq_rel);
+        epoch = static_cast<uint32_t>(pending >> 32);
+        return static_cast<uint32_t>(pending & k_ChangesMask);
+    }
+}
@@ -3,33 +3,20 @@
 
 namespace GfxQuadroSync
 {
-    ComSharedPtr<ID3D11Texture2D> GetBackBufferTexture(IDXGISwapChain* const swapChain)
+    ComPtr<ID3D11Texture2D> GetBackBufferTexture(IDXGISwapChain* const swapChain)
     {
         ID3D11Texture2D* backBufferTexture;
         auto hr = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&backBufferTexture));
         if (FAILED(hr))
         {
-            CLUSTER_LOG_ERROR << "SaveToPresent failed to get swap chain buffer 0: " << hr;
+            CLUSTER_LOG_ERROR(Device) << "SaveToPresent failed to get swap chain buffer 0: " << hr;
             throw std::exception();
         }
-        return ComSharedPtr<ID3D11Texture2D>(backBufferTexture);
+        return ComPtr<ID3D11Texture2D>::Adopt(backBufferTexture);
     }
 
-    ComSharedPtr<ID3D11RenderTargetView> CreateRenderTargetView(ID3D11Device* const device,
-        const ComSharedPtr<ID3D11Texture2D>& texture)
-    {
-        ID3D11RenderTargetView* backBufferRenderTargetView;
-        auto hr = device->CreateRenderTargetView(texture.get(), nullptr, &backBufferRenderTargetView);
-        if (FAILED(hr))
-        {
-            CLUSTER_LOG_ERROR << "SaveToPresent failed to create RenderTargetView: " << hr;
-            throw std::exception();
-        }
-        return ComSharedPtr<ID3D11RenderTargetView>(backBufferRenderTargetView);
-    }
-
-    ComSharedPtr<ID3D11Texture2D> CreateCompatibleTexture(ID3D11Device* const device,
-        const ComSharedPtr<ID3D11Texture2D>& compatibleWith)
+    ComPtr<ID3D11Texture2D> CreateCompatibleTexture(ID3D11Device* const device,
+        const ComPtr<ID3D11Texture2D>& compatibleWith)
     {
         D3D11_TEXTURE2D_DESC backBufferCopyDesc;
         compatibleWith->GetDesc(&backBufferCopyDesc);
@@ -39,10 +26,10 @@ namespace GfxQuadroSync
         auto hr = device->CreateTexture2D(&backBufferCopyDesc, nullptr, &compatibleTexture);
         if (FAILED(hr))
         {
-            CLUSTER_LOG_ERROR << "SaveToPresent failed to allocate copy of back buffer: " << hr;
+            CLUSTER_LOG_ERROR(Device) << "SaveToPresent failed to allocate copy of back buffer: " << hr;
             throw std::exception();
         }
-        return ComSharedPtr<ID3D11Texture2D>(compatibleTexture);
+        return ComPtr<ID3D11Texture2D>::Adopt(compatibleTexture);
     }
 
     D3D11GraphicsDevice::D3D11GraphicsDevice(
@@ -57,32 +44,78 @@ namespace GfxQuadroSync
     {
     }
 
+    void D3D11GraphicsDevice::SetDevice(IUnknown* const device)
+    {
+        if (device != m_D3D11Device)
+        {
+            // Cached resources belong to the previous device.
+            FreeResources();
+        }
+        m_D3D11Device = static_cast<ID3D11Device*>(device);
+    }
+
+    int32_t D3D11GraphicsDevice::GetDeviceRemovedReason() const
+    {
+        return m_D3D11Device ? m_D3D11Device->GetDeviceRemovedReason() : S_OK;
+    }
+
     void D3D11GraphicsDevice::InitiatePresentRepeats()
     {
-        if (m_BackBufferTexture || m_BackBufferRenderTargetView || m_DeviceContext || m_SavedToPresent)
+        if (!m_SwapChain || !m_D3D11Device)
         {
-            CLUSTER_LOG_ERROR << "SaveToPresent called multiple times without calling FreeSavedToPresent";
             return;
         }
 
-        m_BackBufferTexture = GetBackBufferTexture(m_SwapChain);
-        m_BackBufferRenderTargetView = CreateRenderTargetView(m_D3D11Device, m_BackBufferTexture);
-        m_SavedToPresent = CreateCompatibleTexture(m_D3D11Device, m_BackBufferTexture);
+        if (m_IsRepeating)
+        {
+            CLUSTER_LOG_ERROR(Device) << "SaveToPresent called multiple times without calling FreeSavedToPresent";
+            return;
+        }
+
+        // Get the back buffer and (re)create the cached resources if they are not compatible with it anymore
+        try
+        {
+            m_BackBufferTexture = GetBackBufferTexture(m_SwapChain);
 
+            D3D11_TEXTURE2D_DESC backBufferDesc;
+            m_BackBufferTexture->GetDesc(&backBufferDesc);
+            RepeatCacheKey cacheKey;
+            cacheKey.format = backBufferDesc.Format;
+            cacheKey.width = backBufferDesc.Width;
+            cacheKey.height = backBufferDesc.Height;
+            cacheKey.arraySize = backBufferDesc.ArraySize;
+            cacheKey.sampleDesc = backBufferDesc.SampleDesc;
+            if (!m_SavedToPresent || cacheKey != m_RepeatCacheKey)
+            {
+                BuildRepeatCache(cacheKey);
+            }
+        }
+        catch (const std::exception&)
         {
-            ID3D11DeviceContext* deviceContext;
-            m_D3D11Device->GetImmediateContext(&deviceContext);
-            m_DeviceContext.reset(deviceContext);
+            ReleaseBackBuffer();
+            return;
         }
-        ID3D11RenderTargetView* const renderTargetViews[] = {m_BackBufferRenderTargetView.get()};
-        m_DeviceContext->OMSetRenderTargets(1, renderTargetViews, nullptr);
 
+        // CopyResource does not need the back buffer to be bound, so the render targets Unity set are left untouched.
+        m_D3D11Device->GetImmediateContext(m_DeviceContext.ReleaseAndGetAddressOf());
         m_DeviceContext->CopyResource(m_SavedToPresent.get(), m_BackBufferTexture.get());
+        RecordRepeatCommandList();
+        m_IsRepeating = true;
     }
 
     void D3D11GraphicsDevice::PrepareSinglePresentRepeat()
     {
-        if (m_DeviceContext && m_BackBufferTexture && m_SavedToPresent)
+        if (!m_IsRepeating)
+        {
+            return;
+        }
+
+        if (m_RepeatCommandList)
+        {
+            // Restore the context state so that Unity finds the immediate context as it left it.
+            m_DeviceContext->ExecuteCommandList(m_RepeatCommandList.get(), TRUE);
+        }
+        else
         {
             m_DeviceContext->CopyResource(m_BackBufferTexture.get(), m_SavedToPresent.get());
         }
@@ -90,9 +123,57 @@ namespace GfxQuadroSync
 
     void D3D11GraphicsDevice::ConcludePresentRepeats()
     {
-        m_DeviceContext.reset();
+        // Keep the cached resources for the next warmup but release everything referencing the back buffer (the swap
+        // chain cannot be resized while we hold references on it).
+        ReleaseBackBuffer();
+    }
+
+    void D3D11GraphicsDevice::BuildRepeatCache(const RepeatCacheKey& key)
+    {
         m_SavedToPresent.reset();
-        m_BackBufferRenderTargetView.reset();
+        m_DeferredContext.reset();
+
+        m_SavedToPresent = CreateCompatibleTexture(m_D3D11Device, m_BackBufferTexture);
+        auto hr = m_D3D11Device->CreateDeferredContext(0, m_DeferredContext.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            CLUSTER_LOGF_WARNING(Device, "ID3D11Device::CreateDeferredContext failed, repeats will be copied on the "
+                "immediate context: {}", LogHResult(hr));
+            m_DeferredContext.reset();
+        }
+        m_RepeatCacheKey = key;
+    }
+
+    void D3D11GraphicsDevice::RecordRepeatCommandList()
+    {
+        if (!m_DeferredContext)
+        {
+            return;
+        }
+
+        m_DeferredContext->CopyResource(m_BackBufferTexture.get(), m_SavedToPresent.get());
+        auto hr = m_DeferredContext->FinishCommandList(FALSE, m_RepeatCommandList.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            CLUSTER_LOGF_WARNING(Device, "ID3D11DeviceContext::FinishCommandList failed, repeats will be copied on the "
+                "immediate context: {}", LogHResult(hr));
+            m_RepeatCommandList.reset();
+        }
+    }
+
+    void D3D11GraphicsDevice::ReleaseBackBuffer()
+    {
+        m_RepeatCommandList.reset();
+        m_DeviceContext.reset();
         m_BackBufferTexture.reset();
+        m_IsRepeating = false;
+    }
+
+    void D3D11GraphicsDevice::FreeResources()
+    {
+        ReleaseBackBuffer();
+        m_DeferredContext.reset();
+        m_SavedToPresent.reset();
+        m_RepeatCacheKey = RepeatCacheKey();
     }
 }
@@ -7,52 +7,58 @@ namespace GfxQuadroSync
 {
     namespace
     {
-        ComSharedPtr<ID3D12CommandAllocator> CreateCommandAllocator(const ComSharedPtr<ID3D12Device>& device)
+        /// Private data stored in the back buffers to know if the cached repeat command lists recorded for them are
+        /// still valid (new back buffers do not have it).
+        // {6E4A3C4D-1F7B-4E0B-9C52-8A1D3B5E7F20}
+        const GUID k_RepeatCacheGenerationGuid =
+            {0x6e4a3c4d, 0x1f7b, 0x4e0b, {0x9c, 0x52, 0x8a, 0x1d, 0x3b, 0x5e, 0x7f, 0x20}};
+
+        ComPtr<ID3D12CommandAllocator> CreateCommandAllocator(const ComPtr<ID3D12Device>& device)
         {
             ID3D12CommandAllocator* commandAllocator;
             auto hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
                 __uuidof(ID3D12CommandAllocator), reinterpret_cast<void**>(&commandAllocator));
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "ID3D12Device::CreateCommandAllocator failed: " << hr;
+                CLUSTER_LOG_ERROR(Device) << "ID3D12Device::CreateCommandAllocator failed: " << hr;
                 throw std::exception();
             }
             
-            return ComSharedPtr<ID3D12CommandAllocator>(commandAllocator);
+            return ComPtr<ID3D12CommandAllocator>::Adopt(commandAllocator);
         }
 
-        ComSharedPtr<ID3D12GraphicsCommandList> CreateCommandList(const ComSharedPtr<ID3D12Device>& device,
-            const ComSharedPtr<ID3D12CommandAllocator>& commandAllocator)
+        ComPtr<ID3D12GraphicsCommandList> CreateCommandList(const ComPtr<ID3D12Device>& device,
+            const ComPtr<ID3D12CommandAllocator>& commandAllocator)
         {
             ID3D12GraphicsCommandList* commandList;
             auto hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.get(),
                 nullptr, __uuidof(ID3D12GraphicsCommandList), reinterpret_cast<void**>(&commandList));
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "ID3D12Device::CreateCommandList failed: " << hr;
+                CLUSTER_LOG_ERROR(Device) << "ID3D12Device::CreateCommandList failed: " << hr;
                 throw std::exception();
             }
             
-            return ComSharedPtr<ID3D12GraphicsCommandList>(commandList);
+            return ComPtr<ID3D12GraphicsCommandList>::Adopt(commandList);
         }
 
-        ComSharedPtr<ID3D12Resource> GetSwapChainBuffer(const ComSharedPtr<IDXGISwapChain3>& swapChain,
+        ComPtr<ID3D12Resource> GetSwapChainBuffer(const ComPtr<IDXGISwapChain3>& swapChain,
             const UINT index)
         {
             ID3D12Resource* backBuffer;
             auto hr = swapChain->GetBuffer(index, __uuidof(ID3D12Resource), reinterpret_cast<void**>(&backBuffer));
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "IDXGISwapChain::GetBuffer failed to get swap chain buffer " << index
+                CLUSTER_LOG_ERROR(Device) << "IDXGISwapChain::GetBuffer failed to get swap chain buffer " << index
                     << ": " << hr;
                 throw std::exception();
             }
 
-            return ComSharedPtr<ID3D12Resource>(backBuffer);
+            return ComPtr<ID3D12Resource>::Adopt(backBuffer);
         }
 
-        ComSharedPtr<ID3D12Resource> CreateCompatibleBuffer(const ComSharedPtr<ID3D12Device>& device,
-            const ComSharedPtr<ID3D12Resource>& compatibleWith)
+        ComPtr<ID3D12Resource> CreateCompatibleBuffer(const ComPtr<ID3D12Device>& device,
+            const ComPtr<ID3D12Resource>& compatibleWith)
         {
             auto backBufferResourceDesc = compatibleWith->GetDesc();
             backBufferResourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
@@ -61,22 +67,37 @@ namespace GfxQuadroSync
             auto hr = compatibleWith->GetHeapProperties(&heapProperties, &heapFlags);
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "ID3D12Resource::GetHeapProperties failed: " << hr;
+                CLUSTER_LOG_ERROR(Device) << "ID3D12Resource::GetHeapProperties failed: " << hr;
                 throw std::exception();
             }
 
+            // Remark: Created as a copy source since this is the state in which it spends most of its time (the
+            // capture command lists transition it to a copy destination and back).
             ID3D12Resource* savedTexture;
             hr = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &backBufferResourceDesc,
-                D3D12_RESOURCE_STATE_COMMON, nullptr, __uuidof(ID3D12Resource),
+                D3D12_RESOURCE_STATE_COPY_SOURCE, nullptr, __uuidof(ID3D12Resource),
                 reinterpret_cast<void**>(&savedTexture));
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "ID3D12Device::CreateCommittedResource failed to create texture to store the "
+                CLUSTER_LOG_ERROR(Device) << "ID3D12Device::CreateCommittedResource failed to create texture to store the "
                     << "picture to repeat: " << hr;
                 throw std::exception();
             }
 
-            return ComSharedPtr<ID3D12Resource>(savedTexture);
+            return ComPtr<ID3D12Resource>::Adopt(savedTexture);
+        }
+
+        D3D12_RESOURCE_BARRIER TransitionBarrier(ID3D12Resource* const resource,
+            const D3D12_RESOURCE_STATES stateBefore, const D3D12_RESOURCE_STATES stateAfter)
+        {
+            D3D12_RESOURCE_BARRIER barrier;
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = stateBefore;
+            barrier.Transition.StateAfter = stateAfter;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
         }
     }
 
@@ -87,15 +108,18 @@ namespace GfxQuadroSync
         const UINT32 syncInterval,
         const UINT presentFlags)
     {
-        m_D3D12Device.reset(device);
-        device->AddRef();
-        m_CommandQueue.reset(commandQueue);
-        commandQueue->AddRef();
+        m_D3D12Device = ComPtr<ID3D12Device>::Retain(device);
+        m_CommandQueue = ComPtr<ID3D12CommandQueue>::Retain(commandQueue);
         SetSwapChain(swapChain);
         m_SyncInterval = syncInterval;
         m_PresentFlags = presentFlags;
     }
 
+    D3D12GraphicsDevice::~D3D12GraphicsDevice()
+    {
+        FreeResources();
+    }
+
     IDXGISwapChain* D3D12GraphicsDevice::GetSwapChain() const
     {
         return m_SwapChain.get();
@@ -103,8 +127,10 @@ namespace GfxQuadroSync
 
     void D3D12GraphicsDevice::SetDevice(IUnknown* const device)
     {
-        m_D3D12Device.reset(static_cast<ID3D12Device*>(device));
-        device->AddRef();
+        // Cached resources belong to the previous device.
+        FreeResources();
+
+        m_D3D12Device = ComPtr<ID3D12Device>::Retain(static_cast<ID3D12Device*>(device));
     }
 
     void D3D12GraphicsDevice::SetSwapChain(IDXGISwapChain* const swapChain)
@@ -113,11 +139,21 @@ namespace GfxQuadroSync
         auto hr = swapChain->QueryInterface<IDXGISwapChain3>(&swapChain3);
         if (FAILED(hr))
         {
-            CLUSTER_LOG_ERROR << "IDXGISwapChain::QueryInterface IDXGISwapChain3 failed: " << hr;
+            CLUSTER_LOG_ERROR(Device) << "IDXGISwapChain::QueryInterface IDXGISwapChain3 failed: " << hr;
             return;
         }
 
-        m_SwapChain.reset(swapChain3);
+        if (swapChain3 != m_SwapChain.get())
+        {
+            // Cached resources were recorded for the back buffers of the previous swap chain.
+            FreeResources();
+        }
+        m_SwapChain.Attach(swapChain3);
+    }
+
+    int32_t D3D12GraphicsDevice::GetDeviceRemovedReason() const
+    {
+        return m_D3D12Device ? m_D3D12Device->GetDeviceRemovedReason() : S_OK;
     }
 
     void D3D12GraphicsDevice::InitiatePresentRepeats()
@@ -127,128 +163,92 @@ namespace GfxQuadroSync
             return;
         }
 
-        if (m_CommandAllocator || m_CommandList || !m_BackBuffers.empty() || m_SavedTexture)
+        if (m_IsRepeating)
         {
-            CLUSTER_LOG_ERROR << "SaveToPresent called multiple times without calling FreeSavedToPresent";
+            CLUSTER_LOG_ERROR(Device) << "SaveToPresent called multiple times without calling FreeSavedToPresent";
             return;
         }
 
-        // Get the back buffers
         DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
         auto hr = m_SwapChain->GetDesc1(&swapChainDesc);
         if (FAILED(hr))
         {
-            CLUSTER_LOG_ERROR << "IDXGISwapChain1::GetDesc1 failed: " << hr;
+            CLUSTER_LOG_ERROR(Device) << "IDXGISwapChain1::GetDesc1 failed: " << hr;
             return;
         }
-        m_BackBuffers.reserve(swapChainDesc.BufferCount);
-        for (auto backBufferIndex = 0; backBufferIndex < swapChainDesc.BufferCount; ++backBufferIndex)
-        {
-            m_BackBuffers.push_back(GetSwapChainBuffer(m_SwapChain, backBufferIndex));
-        }
+        RepeatCacheKey cacheKey;
+        cacheKey.format = swapChainDesc.Format;
+        cacheKey.width = swapChainDesc.Width;
+        cacheKey.height = swapChainDesc.Height;
+        cacheKey.bufferCount = swapChainDesc.BufferCount;
 
-        // Create resources
-        auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        // Get the back buffers and (re)create the cached resources if they are not for those back buffers anymore
         try
         {
-            m_CommandAllocator = CreateCommandAllocator(m_D3D12Device);
-            m_CommandAllocator->SetName(L"GfxPluginQuadroSync CommandAllocator");
-            m_CommandList = CreateCommandList(m_D3D12Device, m_CommandAllocator);
-            m_CommandList->SetName(L"GfxPluginQuadroSync CommandList");
-            m_SavedTexture = CreateCompatibleBuffer(m_D3D12Device, m_BackBuffers[backBufferIndex]);
-            m_SavedTexture->SetName(L"GfxPluginQuadroSync SavedTexture");
+            m_BackBuffers.reserve(swapChainDesc.BufferCount);
+            for (UINT backBufferIndex = 0; backBufferIndex < swapChainDesc.BufferCount; ++backBufferIndex)
+            {
+                m_BackBuffers.push_back(GetSwapChainBuffer(m_SwapChain, backBufferIndex));
+            }
         }
         catch (const std::exception&)
         {
+            m_BackBuffers.clear();
+            return;
+        }
+        if (!IsRepeatCacheValid(cacheKey) && !BuildRepeatCache(cacheKey))
+        {
+            FreeResources();
             return;
         }
 
-        // Copy current backbuffer to a texture we will repeat
-        m_CommandList->CopyResource(m_SavedTexture.get(), m_BackBuffers[backBufferIndex].get());
-
-        // Indicate that the texture will become a copy source
-        D3D12_RESOURCE_BARRIER renderTargetBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_SavedTexture.get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
-
-        // Conclude the operations
-        m_CommandList->Close();
-        ID3D12CommandList* const commandListsToExecute[] = {m_CommandList.get()};
-        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
+        // Copy current backbuffer to the texture we will repeat
+        auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        auto& repeatSlot = m_RepeatSlots[backBufferIndex];
+        ExecuteSlotCommandList(repeatSlot, repeatSlot.captureCommandList.get());
+        m_IsRepeating = true;
+        m_FirstRepeatBackBufferIndex = -1;
 
         // Wait for copy to be executed (is it really necessary?  Good question, but its safer and we are not in a
         // hurry anyway as this is only executed once at initialization time.)
-        EnsureFenceCreated();
-        QueueUpdateFence();
         WaitForFence();
     }
 
     void D3D12GraphicsDevice::PrepareSinglePresentRepeat()
     {
-        if (!m_SwapChain)
+        if (!m_SwapChain || !m_IsRepeating)
         {
             return;
         }
         auto backBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
+        if (backBufferIndex >= m_RepeatSlots.size())
+        {
+            CLUSTER_LOG_ERROR(Device) << "Current back buffer index " << backBufferIndex
+                << " is outside of the back buffers of the swap chain";
+            return;
+        }
         if (m_FirstRepeatBackBufferIndex == -1)
         {
             m_FirstRepeatBackBufferIndex = backBufferIndex;
         }
 
-        WaitForFence();
-
-        // Prepare the command allocator and list for new commands
-        // Remarks: Need to be kept alive until processing of those commands are done, so we keep it until next frame.
-        m_CommandAllocator->Reset();
-        m_CommandList->Reset(m_CommandAllocator.get(), nullptr);
-
-        // Indicate that the back buffer will be used as a render target.
-        D3D12_RESOURCE_BARRIER renderTargetBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_BackBuffers[backBufferIndex].get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
-
-        // Copy the saved texture to it
-        m_CommandList->CopyResource(m_BackBuffers[backBufferIndex].get(), m_SavedTexture.get());
-
-        // Indicate that the back buffer will be used to present
-        D3D12_RESOURCE_BARRIER presentBarrier;
-        renderTargetBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        renderTargetBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        renderTargetBarrier.Transition.pResource = m_BackBuffers[backBufferIndex].get();
-        renderTargetBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-        renderTargetBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-        renderTargetBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        m_CommandList->ResourceBarrier(1, &renderTargetBarrier);
-
-        // Command list is completed
-        m_CommandList->Close();
-        ID3D12CommandList* const commandListsToExecute[] = {m_CommandList.get()};
-        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
-
-        // Add a barrier to be signaled when commands are done being processed
-        QueueUpdateFence();
+        // Pre-recorded command list copying the saved texture to the back buffer (with the transitions from and to
+        // the present state).
+        auto& repeatSlot = m_RepeatSlots[backBufferIndex];
+        ExecuteSlotCommandList(repeatSlot, repeatSlot.repeatCommandList.get());
     }
 
     void D3D12GraphicsDevice::ConcludePresentRepeats()
     {
-        if (!m_SwapChain)
+        if (!m_SwapChain || !m_IsRepeating)
         {
             return;
         }
 
-        // Why do we WaitForFence here, doesn't PrepareSinglePresentRepeat start with a WaitForFence?  Yes it does, but
-        // I wanted to be sure the current back buffer index (returned by the IDXGISwapChain3::GetCurrentBackBufferIndex
-        // call below) would return the index after the previous frame is over and not potentially the previous one.
+        // Why do we WaitForFence here?  PrepareSinglePresentRepeat only waits for the back buffer it is about to
+        // overwrite, and anyway I wanted to be sure the current back buffer index (returned by the
+        // IDXGISwapChain3::GetCurrentBackBufferIndex call below) would return the index after the previous frame is
+        // over and not potentially the previous one.
         // Is it really necessary?  Not 100% sure, but this code is only executed once during the initialization, so I
         // prefer to play safe than trying to squeeze every possible bit of speed...
         WaitForFence();
@@ -263,14 +263,18 @@ namespace GfxQuadroSync
             auto hr = m_SwapChain->Present(m_SyncInterval, m_PresentFlags);
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "IDXGISwapChain::Present failed while re-aligning CurrentBackBufferIndex: " << hr;
+                CLUSTER_LOG_ERROR(Device) << "IDXGISwapChain::Present failed while re-aligning CurrentBackBufferIndex: " << hr;
             }
 
             // Same reason for this WaitForFence as the one a few lines above.
             WaitForFence();
         }
 
-        FreeResources();
+        // Keep the cached resources for the next warmup but release the back buffers (the swap chain cannot be
+        // resized while we hold references on them).
+        m_BackBuffers.clear();
+        m_IsRepeating = false;
+        m_FirstRepeatBackBufferIndex = -1;
     }
 
     void D3D12GraphicsDevice::EnsureFenceCreated()
@@ -287,47 +291,165 @@ namespace GfxQuadroSync
                 __uuidof(ID3D12Fence), reinterpret_cast<void**>(&commandExecutionDoneFence));
             if (FAILED(hr))
             {
-                CLUSTER_LOG_ERROR << "ID3D12Device::CreateFence failed: " << hr;
+                CLUSTER_LOG_ERROR(Device) << "ID3D12Device::CreateFence failed: " << hr;
                 return;
             }
-            m_CommandExecutionDoneFence.reset(commandExecutionDoneFence);
+            m_CommandExecutionDoneFence.Attach(commandExecutionDoneFence);
             m_CommandExecutionDoneFence->SetName(L"GfxPluginQuadroSync Fence");
         }
     }
 
-    void D3D12GraphicsDevice::QueueUpdateFence()
+    UINT64 D3D12GraphicsDevice::QueueUpdateFence()
     {
+        if (!IsFenceCreated())
+        {
+            return 0;
+        }
+
         ++m_CommandExecutionDoneFenceNextValue;
         auto hr = m_CommandQueue->Signal(m_CommandExecutionDoneFence.get(), m_CommandExecutionDoneFenceNextValue);
         if (FAILED(hr))
         {
-            CLUSTER_LOG_WARNING << "ID3D12CommandQueue::Signal failed: " << hr;
+            CLUSTER_LOGF_WARNING(Device, "ID3D12CommandQueue::Signal failed: {}", LogHResult(hr));
         }
+        return m_CommandExecutionDoneFenceNextValue;
     }
 
     void D3D12GraphicsDevice::WaitForFence()
+    {
+        WaitForFenceValue(m_CommandExecutionDoneFenceNextValue);
+    }
+
+    void D3D12GraphicsDevice::WaitForFenceValue(const UINT64 value)
     {
         if (!IsFenceCreated())
         {
             return;
         }
 
-        if (m_CommandExecutionDoneFence->GetCompletedValue() < m_CommandExecutionDoneFenceNextValue)
+        if (m_CommandExecutionDoneFence->GetCompletedValue() < value)
         {
             ResetEvent(m_BarrierReachedEvent.get());
-            m_CommandExecutionDoneFence->SetEventOnCompletion(m_CommandExecutionDoneFenceNextValue,
-                m_BarrierReachedEvent.get());
+            m_CommandExecutionDoneFence->SetEventOnCompletion(value, m_BarrierReachedEvent.get());
             WaitForSingleObject(m_BarrierReachedEvent.get(), INFINITE);
         }
     }
 
+    bool D3D12GraphicsDevice::IsRepeatCacheValid(const RepeatCacheKey& key)
+    {
+        if (m_RepeatSlots.empty() || key != m_RepeatCacheKey || m_BackBuffers.size() != m_RepeatSlots.size())
+        {
+            return false;
+        }
+
+        // Resizing the swap chain (even to the same size) gives new back buffers that the cached command lists do not
+        // know about, detect them by the generation stamped in the back buffers the cache was built for.
+        for (const auto& backBuffer: m_BackBuffers)
+        {
+            UINT64 generation = 0;
+            UINT generationSize = sizeof(generation);
+            auto hr = backBuffer->GetPrivateData(k_RepeatCacheGenerationGuid, &generationSize, &generation);
+            if (FAILED(hr) || generationSize != sizeof(generation) || generation != m_RepeatCacheGeneration)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool D3D12GraphicsDevice::BuildRepeatCache(const RepeatCacheKey& key)
+    {
+        // Previous cache might still be referenced by commands in flight
+        WaitForFence();
+        m_RepeatSlots.clear();
+        m_SavedTexture.reset();
+
+        EnsureFenceCreated();
+        if (!IsFenceCreated())
+        {
+            return false;
+        }
+
+        try
+        {
+            m_SavedTexture = CreateCompatibleBuffer(m_D3D12Device, m_BackBuffers[0]);
+            m_SavedTexture->SetName(L"GfxPluginQuadroSync SavedTexture");
+
+            m_RepeatSlots.resize(m_BackBuffers.size());
+            for (size_t slotIndex = 0; slotIndex < m_RepeatSlots.size(); ++slotIndex)
+            {
+                auto& repeatSlot = m_RepeatSlots[slotIndex];
+                const auto backBuffer = m_BackBuffers[slotIndex].get();
+
+                repeatSlot.commandAllocator = CreateCommandAllocator(m_D3D12Device);
+                repeatSlot.commandAllocator->SetName(L"GfxPluginQuadroSync CommandAllocator");
+
+                // Copy the back buffer to the saved texture (the back buffer is implicitly promoted from the present
+                // state to a copy source).
+                repeatSlot.captureCommandList = CreateCommandList(m_D3D12Device, repeatSlot.commandAllocator);
+                repeatSlot.captureCommandList->SetName(L"GfxPluginQuadroSync CaptureCommandList");
+                const D3D12_RESOURCE_BARRIER captureBarriers[] = {
+                    TransitionBarrier(m_SavedTexture.get(), D3D12_RESOURCE_STATE_COPY_SOURCE,
+                        D3D12_RESOURCE_STATE_COPY_DEST),
+                    TransitionBarrier(m_SavedTexture.get(), D3D12_RESOURCE_STATE_COPY_DEST,
+                        D3D12_RESOURCE_STATE_COPY_SOURCE)};
+                repeatSlot.captureCommandList->ResourceBarrier(1, &captureBarriers[0]);
+                repeatSlot.captureCommandList->CopyResource(m_SavedTexture.get(), backBuffer);
+                repeatSlot.captureCommandList->ResourceBarrier(1, &captureBarriers[1]);
+                repeatSlot.captureCommandList->Close();
+
+                // Copy the saved texture to the back buffer
+                repeatSlot.repeatCommandList = CreateCommandList(m_D3D12Device, repeatSlot.commandAllocator);
+                repeatSlot.repeatCommandList->SetName(L"GfxPluginQuadroSync RepeatCommandList");
+                const D3D12_RESOURCE_BARRIER repeatBarriers[] = {
+                    TransitionBarrier(backBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_DEST),
+                    TransitionBarrier(backBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PRESENT)};
+                repeatSlot.repeatCommandList->ResourceBarrier(1, &repeatBarriers[0]);
+                repeatSlot.repeatCommandList->CopyResource(backBuffer, m_SavedTexture.get());
+                repeatSlot.repeatCommandList->ResourceBarrier(1, &repeatBarriers[1]);
+                repeatSlot.repeatCommandList->Close();
+            }
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        // Stamp the back buffers so that we can detect when they are replaced
+        ++m_RepeatCacheGeneration;
+        for (const auto& backBuffer: m_BackBuffers)
+        {
+            backBuffer->SetPrivateData(k_RepeatCacheGenerationGuid, sizeof(m_RepeatCacheGeneration),
+                &m_RepeatCacheGeneration);
+        }
+        m_RepeatCacheKey = key;
+        return true;
+    }
+
+    void D3D12GraphicsDevice::ExecuteSlotCommandList(RepeatSlot& slot, ID3D12GraphicsCommandList* const commandList)
+    {
+        // A command list cannot be executed again before its previous execution is done.  Usually the case already
+        // since the swap chain only hands us back a back buffer once it has been presented.
+        WaitForFenceValue(slot.fenceValue);
+
+        ID3D12CommandList* const commandListsToExecute[] = {commandList};
+        m_CommandQueue->ExecuteCommandLists(1, commandListsToExecute);
+
+        // Add a barrier to be signaled when commands are done being processed
+        slot.fenceValue = QueueUpdateFence();
+    }
+
     void D3D12GraphicsDevice::FreeResources()
     {
+        WaitForFence();
+
         m_BarrierReachedEvent.reset();
         m_CommandExecutionDoneFence.reset();
-        m_CommandList.reset();
-        m_CommandAllocator.reset();
+        m_RepeatSlots.clear();
+        m_RepeatCacheKey = RepeatCacheKey();
         m_BackBuffers.clear();
         m_SavedTexture.reset();
+        m_IsRepeating = false;
+        m_FirstRepeatBackBufferIndex = -1;
     }
 }
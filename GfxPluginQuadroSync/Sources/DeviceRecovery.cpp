@@ -0,0 +1,114 @@
+#include "DeviceRecovery.h"
+
+namespace GfxQuadroSync
+{
+    PresentFailureKind DeviceRecovery::Classify(const NvAPI_Status status, const int32_t deviceRemovedReason)
+    {
+        // DXGI_ERROR_DEVICE_REMOVED, DXGI_ERROR_DEVICE_HUNG, DXGI_ERROR_DEVICE_RESET, ... (TDR)
+        if (deviceRemovedReason != 0)
+        {
+            return PresentFailureKind::Fatal;
+        }
+
+        switch (status)
+        {
+        case NVAPI_INVALID_ARGUMENT:
+        case NVAPI_INVALID_HANDLE:
+        case NVAPI_HANDLE_INVALIDATED:
+        case NVAPI_INVALID_POINTER:
+        case NVAPI_INVALID_CALL:
+        case NVAPI_NVIDIA_DEVICE_NOT_FOUND:
+            // What we present with is no longer valid, presenting it again will not do any better.
+            return PresentFailureKind::Fatal;
+        default:
+            return PresentFailureKind::Transient;
+        }
+    }
+
+    bool DeviceRecovery::OnPresentFailed(const NvAPI_Status status, const int32_t deviceRemovedReason,
+        const uint64_t tick)
+    {
+        return OnFailure(Classify(status, deviceRemovedReason), status, deviceRemovedReason, tick);
+    }
+
+    bool DeviceRecovery::OnFailure(const PresentFailureKind kind, const int32_t status,
+        const int32_t deviceRemovedReason, const uint64_t tick)
+    {
+        ++m_Report.consecutiveFailures;
+        m_Report.lastFailureStatus = status;
+        m_Report.lastDeviceRemovedReason = deviceRemovedReason;
+        m_Report.lastFailureKind = static_cast<uint32_t>(kind);
+
+        if (kind == PresentFailureKind::Transient)
+        {
+            // However long it lasts, only MembershipLost turns it into a recovery.
+            if (!IsRecovering())
+            {
+                SetState(DeviceRecoveryState::Degraded);
+            }
+            return false;
+        }
+
+        StartRecovery(tick);
+        return true;
+    }
+
+    bool DeviceRecovery::MembershipCheckDue() const
+    {
+        return GetState() == DeviceRecoveryState::Degraded &&
+            m_Report.consecutiveFailures % k_TransientFailuresBetweenMembershipChecks == 0;
+    }
+
+    void DeviceRecovery::MembershipLost(const uint64_t tick)
+    {
+        m_Report.lastFailureKind = static_cast<uint32_t>(PresentFailureKind::Fatal);
+        StartRecovery(tick);
+    }
+
+    void DeviceRecovery::StartRecovery(const uint64_t tick)
+    {
+        if (IsRecovering())
+        {
+            // Failing again while warming up: start over (but it is still the same recovery).
+            SetState(DeviceRecoveryState::Lost);
+            return;
+        }
+
+        SetState(DeviceRecoveryState::Lost);
+        m_Report.lostTick = tick;
+        m_Report.recoveredTick = 0;
+        m_Report.lastRecoveryTicks = 0;
+    }
+
+    void DeviceRecovery::OnPresentSucceeded()
+    {
+        m_Report.consecutiveFailures = 0;
+        if (GetState() == DeviceRecoveryState::Degraded)
+        {
+            SetState(DeviceRecoveryState::Healthy);
+        }
+    }
+
+    void DeviceRecovery::Rejoined()
+    {
+        if (GetState() == DeviceRecoveryState::Lost)
+        {
+            SetState(DeviceRecoveryState::WarmingUp);
+        }
+    }
+
+    void DeviceRecovery::Recovered(const uint64_t tick)
+    {
+        if (!IsRecovering())
+        {
+            return;
+        }
+
+        SetState(DeviceRecoveryState::Healthy);
+        m_Report.consecutiveFailures = 0;
+        ++m_Report.recoveryCount;
+        m_Report.recoveredTick = tick;
+        m_Report.lastRecoveryTicks = tick > m_Report.lostTick ? tick - m_Report.lostTick : 0;
+        m_Report.totalRecoveryTicks += m_Report.lastRecoveryTicks;
+    }
+}
@@ -0,0 +1,141 @@
+#include "FrameCountService.h"
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        // If the hardware counter goes backward by more than this we consider it was reset, otherwise that it wrapped
+        // around.
+        constexpr uint32_t k_WrapAroundThreshold = 0x80000000;
+    }
+
+    FrameCountService::FrameCountService(const uint64_t ticksPerSecond)
+        : m_TicksPerSecond(ticksPerSecond > 0 ? ticksPerSecond : 1)
+        , m_TicksBetweenSamples(m_TicksPerSecond * k_DefaultSecondsBetweenSamples)
+    {
+    }
+
+    void FrameCountService::SetThrottling(const uint32_t samplesBeforeThrottle, const uint64_t ticksBetweenSamples)
+    {
+        m_SamplesBeforeThrottle = samplesBeforeThrottle;
+        m_TicksBetweenSamples = ticksBetweenSamples;
+    }
+
+    void FrameCountService::Reset()
+    {
+        m_SampleAttempts = 0;
+        m_LastAttemptTick = 0;
+        m_HasSample = false;
+        m_WrapOffset = 0;
+        m_LastHardwareFrameCount = 0;
+    }
+
+    bool FrameCountService::ShouldSample(const uint64_t nowTick) const
+    {
+        return m_SampleAttempts < m_SamplesBeforeThrottle || nowTick - m_LastAttemptTick >= m_TicksBetweenSamples;
+    }
+
+    void FrameCountService::AddSample(const uint64_t beforeTick, const uint64_t afterTick, const uint32_t frameCount)
+    {
+        ++m_SampleAttempts;
+        m_LastAttemptTick = beforeTick;
+
+        // Best guess for when the hardware counter was read is the middle of the call.
+        const uint64_t sampleTick = beforeTick + (afterTick - beforeTick) / 2;
+
+        if (m_HasSample && frameCount < m_LastHardwareFrameCount)
+        {
+            if (m_LastHardwareFrameCount - frameCount > k_WrapAroundThreshold)
+            {
+                m_WrapOffset += uint64_t(1) << 32;
+            }
+            else
+            {
+                // Counter went backward, it has been reset, so restart measuring the refresh period from scratch.
+                m_HasSample = false;
+                m_WrapOffset = 0;
+            }
+        }
+        m_LastHardwareFrameCount = frameCount;
+
+        m_LastTick = sampleTick;
+        m_LastFrameCount = m_WrapOffset + frameCount;
+        if (!m_HasSample)
+        {
+            m_AnchorTick = m_LastTick;
+            m_AnchorFrameCount = m_LastFrameCount;
+            m_HasSample = true;
+        }
+    }
+
+    void FrameCountService::SampleFailed(const uint64_t tick)
+    {
+        ++m_SampleAttempts;
+        m_LastAttemptTick = tick;
+    }
+
+    FrameCountEstimate FrameCountService::Estimate(const uint64_t nowTick) const
+    {
+        FrameCountEstimate estimate;
+        estimate.timestampNs = TicksToNanoseconds(nowTick);
+        if (!m_HasSample)
+        {
+            return estimate;
+        }
+
+        const uint64_t elapsedTicks = nowTick > m_LastTick ? nowTick - m_LastTick : 0;
+        estimate.sampleAgeNs = TicksToNanoseconds(elapsedTicks);
+        estimate.frameCount = m_LastFrameCount;
+
+        const uint64_t measuredFrames = m_LastFrameCount - m_AnchorFrameCount;
+        if (measuredFrames > 0)
+        {
+            const double ticksPerFrame = GetTicksPerFrame();
+            estimate.refreshPeriodNs = TicksToNanoseconds(static_cast<uint64_t>(ticksPerFrame + 0.5));
+            if (ticksPerFrame > 0)
+            {
+                estimate.frameCount += static_cast<uint64_t>(elapsedTicks / ticksPerFrame);
+            }
+        }
+
+        if (elapsedTicks == 0)
+        {
+            estimate.confidence = FrameCountConfidence::Sampled;
+        }
+        else if (measuredFrames > 0)
+        {
+            estimate.confidence = FrameCountConfidence::Extrapolated;
+        }
+        else
+        {
+            estimate.confidence = FrameCountConfidence::Stale;
+        }
+        return estimate;
+    }
+
+    bool FrameCountService::GetLastSample(uint64_t& tick, uint64_t& frameCount, double& ticksPerFrame) const
+    {
+        if (!m_HasSample)
+        {
+            return false;
+        }
+
+        tick = m_LastTick;
+        frameCount = m_LastFrameCount;
+        ticksPerFrame = GetTicksPerFrame();
+        return true;
+    }
+
+    double FrameCountService::GetTicksPerFrame() const
+    {
+        const uint64_t measuredFrames = m_LastFrameCount - m_AnchorFrameCount;
+        return measuredFrames > 0 ? static_cast<double>(m_LastTick - m_AnchorTick) / measuredFrames : 0;
+    }
+
+    uint64_t FrameCountService::TicksToNanoseconds(const uint64_t ticks) const
+    {
+        constexpr uint64_t nanosecondsPerSecond = 1000000000;
+        return (ticks / m_TicksPerSecond) * nanosecondsPerSecond +
+            (ticks % m_TicksPerSecond) * nanosecondsPerSecond / m_TicksPerSecond;
+    }
+}
@@ -1,9 +1,15 @@
 #include "D3D11GraphicsDevice.h"
 #include "D3D12GraphicsDevice.h"
+#include "NvApiSwapGroupApi.h"
+#include "CommandPacket.h"
 #include "QuadroSync.h"
+#include "QuadroSyncState.h"
+#include "TelemetryExport.h"
 #include "GfxQuadroSync.h"
 #include "Logger.h"
+#include "PerformanceCounter.h"
 
+#include "../External/NvAPI/nvapi.h"
 #include "../Unity/IUnityRenderingExtensions.h"
 #include "../Unity/IUnityGraphicsD3D11.h"
 #include "../Unity/IUnityGraphicsD3D12.h"
@@ -18,7 +24,7 @@ namespace GfxQuadroSync
     static IUnityGraphicsD3D12v7* s_UnityGraphicsD3D12 = nullptr;
 
     static std::unique_ptr<IGraphicsDevice> s_GraphicsDevice = nullptr;
-    static PluginCSwapGroupClient s_SwapGroupClient;
+    static PluginCSwapGroupClient s_SwapGroupClient(std::make_unique<NvApiSwapGroupApi>());
     static bool s_Initialized = false;
 
     // Any change made to this enum's constants must be reflected in
@@ -42,23 +48,8 @@ namespace GfxQuadroSync
         SwapBarrierIdMismatch = 12,
     };
     static std::atomic<QuadroSyncInitializationStatus> s_InitializationStatus = QuadroSyncInitializationStatus::NotInitialized;
-    static uint64_t s_PerformanceCounterFrequency = 0;
-    constexpr uint64_t NBR_CAN_GET_FRAME_COUNT_BEFORE_THROTTLE = 60; // This is one second at 60 fps...
-    constexpr uint64_t NBR_SECONDS_BETWEEN_CAN_GET_FRAME_COUNT = 1;  // Let's check every second once we are throttled...
-
-    uint64_t GetCurrentPerformanceCounterTick()
-    {
-        LARGE_INTEGER ret;
-        if (QueryPerformanceCounter(&ret))
-        {
-            return ret.QuadPart;
-        }
-        else
-        {
-            // I've never seen QueryPerformanceCounter fail, but let's play safe...
-            return 0;
-        }
-    }
+    static QuadroSyncStateMirror s_StateMirror;
+    static TelemetryExport s_TelemetryExport;
 
     // Override the function defining the load of the plugin
     extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API
@@ -66,7 +57,8 @@ namespace GfxQuadroSync
     {
         if (unityInterfaces)
         {
-            CLUSTER_LOG << "UnityPluginLoad triggered";
+            Logger::Instance().SetStatusMessageFunction(&NvAPI_GetErrorMessage);
+            CLUSTER_LOG(Init) << "UnityPluginLoad triggered";
 
             s_UnityInterfaces = unityInterfaces;
             s_UnityGraphics = unityInterfaces->Get<IUnityGraphics>();
@@ -78,18 +70,27 @@ namespace GfxQuadroSync
                 // to not miss the event in case the graphics device is already initialized
                 OnGraphicsDeviceEvent(kUnityGfxDeviceEventInitialize);
             }
-
-            LARGE_INTEGER performanceCounterFrequency;
-            if (QueryPerformanceFrequency(&performanceCounterFrequency))
-            {
-                s_PerformanceCounterFrequency = performanceCounterFrequency.QuadPart;
-            }
         }
         else
         {
             s_InitializationStatus = QuadroSyncInitializationStatus::FailedUnityInterfacesNull;
-            CLUSTER_LOG_ERROR << "UnityPluginLoad, unityInterfaces is null";
+            CLUSTER_LOG_ERROR(Init) << "UnityPluginLoad, unityInterfaces is null";
         }
+        PublishQuadroSyncState();
+    }
+
+    // Override the function defining the unload of the plugin
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginUnload()
+    {
+        if (s_UnityGraphics)
+        {
+            s_UnityGraphics->UnregisterDeviceEventCallback(OnGraphicsDeviceEvent);
+        }
+
+        // Must be done from here and not from static destructors (that cannot join threads)
+        s_SwapGroupClient.EnableStallWatchdog(0, false);
+        s_TelemetryExport.Close();
+        Logger::Instance().Shutdown();
     }
 
     // Freely defined function to pass a callback to plugin-specific scripts
@@ -105,6 +106,37 @@ namespace GfxQuadroSync
         Logger::Instance().SetManagedCallback(callback);
     }
 
+    // Freely defined function to set how log messages are delivered to the log callback (see LogDeliveryMode)
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetLogDeliveryMode(const uint32_t deliveryMode)
+    {
+        if (deliveryMode > (uint32_t)LogDeliveryMode::Polled)
+        {
+            CLUSTER_LOG_ERROR(Init) << "SetLogDeliveryMode, invalid mode: " << deliveryMode;
+            return;
+        }
+        Logger::Instance().SetDeliveryMode(static_cast<LogDeliveryMode>(deliveryMode));
+    }
+
+    // Freely defined function to set the minimum level of the log messages to deliver (see LogLevel)
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetLogLevel(const uint32_t level)
+    {
+        Logger::Instance().SetMinLevel(static_cast<LogLevel>(level < (uint32_t)LogLevel::None ? level :
+            (uint32_t)LogLevel::None));
+    }
+
+    // Freely defined function to set the mask of LogCategory of the log messages to deliver
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetLogCategoryMask(const uint32_t mask)
+    {
+        Logger::Instance().SetCategoryMask(mask);
+    }
+
+    // Freely defined function delivering the queued log messages to the log callback from the calling thread (returns
+    // the number of messages delivered)
+    extern "C" uint32_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API FlushLogs()
+    {
+        return Logger::Instance().Flush();
+    }
+
     // Freely defined function to set a callback that will be called before the present of each frame
     extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetBarrierWarmupCallback(
         PluginCSwapGroupClient::BarrierWarmupCallback callback)
@@ -113,37 +145,344 @@ namespace GfxQuadroSync
     }
 
     /**
-     * Status of the QuadroSync as returned by GetStatus.
+     * Method to be called by managed code to let the plugin decide when the swap barrier is warmed up (instead of the
+     * callback set by SetBarrierWarmupCallback), see BarrierWarmupPolicy.
      *
-     * \remark Any change to this struct must be matched in
-     *         Unity.ClusterDisplay.GfxPluginQuadroSyncSystem.GfxPluginQuadroSyncUtilities.QuadroSyncState in
-     *         GfxPluginQuadroSyncSystem.cs.
+     * \param[in] settings Settings of the policy (nullptr to use the callback again).
      */
-    struct QuadroSyncState
-    {
-        /// Initialization status of the QuadroSync system (not using QuadroSyncInitializationStatus for safer interop
-        /// with managed code)
-        uint32_t initializationState = 0;
-        /// Swap Group ID
-        uint32_t swapGroupId = 0;
-        /// Swap Barrier ID
-        uint32_t swapBarrierId = 0;
-        /// Number of frames successfully presented using QuadroSync's present call
-        uint64_t presentedFramesSuccess = 0;
-        /// Number of frames that failed to be presented using QuadroSync's present call
-        uint64_t presentedFramesFailed = 0;
-    };
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetBarrierWarmupPolicy(
+        const BarrierWarmupPolicy::Settings* settings)
+    {
+        s_SwapGroupClient.SetBarrierWarmupPolicy(settings);
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to get the progress and outcome of the last barrier
+     * warmup decided by the plugin.
+     *
+     * \return False if \a report is null.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetBarrierWarmupReport(BarrierWarmupReport* report)
+    {
+        if (report == nullptr)
+        {
+            return false;
+        }
+
+        *report = s_SwapGroupClient.GetBarrierWarmupReport();
+        return true;
+    }
+
+    /**
+     * Method to be called by managed code to read warmup decisions from the slot filled by PostBarrierWarmupAction
+     * (instead of calling the callback set by SetBarrierWarmupCallback on the rendering thread).
+     *
+     * \param[in] enable Non zero to use the action slot, 0 to use the callback again.
+     */
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetBarrierWarmupActionSlot(const uint32_t enable)
+    {
+        s_SwapGroupClient.SetBarrierWarmupActionSlotEnabled(enable != 0);
+    }
+
+    /**
+     * Method to be called by managed code (from any thread, returns immediately) to post what to do after the next
+     * warmup presents, see PluginCSwapGroupClient::PostBarrierWarmupAction.
+     *
+     * \return False if \a action is not a valid BarrierWarmupAction.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API PostBarrierWarmupAction(const uint32_t action)
+    {
+        if (action > static_cast<uint32_t>(PluginCSwapGroupClient::BarrierWarmupAction::BarrierWarmedUp))
+        {
+            return false;
+        }
+
+        s_SwapGroupClient.PostBarrierWarmupAction(static_cast<PluginCSwapGroupClient::BarrierWarmupAction>(action));
+        return true;
+    }
+
+    // Freely defined function returning the number of warmup presents done so far (can be called from any thread)
+    extern "C" uint64_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetBarrierWarmupPresentSequence()
+    {
+        return s_SwapGroupClient.GetBarrierWarmupPresentSequence();
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to get the swap chain changes detected by the plugin and
+     * how long the node was out of sync because of them.
+     *
+     * \return False if \a report is null.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetSwapChainChangeReport(SwapChainChangeReport* report)
+    {
+        if (report == nullptr)
+        {
+            return false;
+        }
+
+        *report = s_SwapGroupClient.GetSwapChainChangeReport();
+        return true;
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to get the progress of the recovery from failed presents
+     * (like after a TDR) and how long recoveries took.
+     *
+     * \return False if \a report is null.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetDeviceRecoveryReport(DeviceRecoveryReport* report)
+    {
+        if (report == nullptr)
+        {
+            return false;
+        }
+
+        *report = s_SwapGroupClient.GetDeviceRecoveryReport();
+        return true;
+    }
+
+    // Freely defined function to start (or stop with a threshold of 0) watching for presents blocked for more than
+    // thresholdMs in the swap barrier, optionally skipping the synchronized present of the frame following a stall
+    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetPresentStallWatchdog(const uint32_t thresholdMs,
+        const uint32_t skipSynchronizationOnStall)
+    {
+        s_SwapGroupClient.EnableStallWatchdog(thresholdMs, skipSynchronizationOnStall != 0, &PublishQuadroSyncState);
+    }
+
+    // Freely defined function to select the swap group and barrier joined by the next QuadroSyncInitialize or
+    // QuadroSyncEnable* (QuadroSyncReconfigure changes the ones already joined)
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetSwapGroupIds(const uint32_t swapGroupId,
+        const uint32_t swapBarrierId)
+    {
+        return s_SwapGroupClient.SetSwapGroupIds(swapGroupId, swapBarrierId);
+    }
+
+    // Fill the complete (latest version) QuadroSyncState
+    static void FillQuadroSyncState(QuadroSyncState& state)
+    {
+        state.size = sizeof(QuadroSyncState);
+        state.version = QuadroSyncState::k_Version;
+        state.capabilities = static_cast<uint64_t>(QuadroSyncStateCapabilities::PresentCounters |
+            QuadroSyncStateCapabilities::LogCounters | QuadroSyncStateCapabilities::PresentStallWatchdog);
+        state.initializationState = (uint32_t)s_InitializationStatus.load(std::memory_order_relaxed);
+        state.swapGroupId = s_SwapGroupClient.GetSwapGroupId();
+        state.swapBarrierId = s_SwapGroupClient.GetSwapBarrierId();
+        state.presentedFramesSuccess = s_SwapGroupClient.GetPresentSuccessCount();
+        state.presentedFramesFailed = s_SwapGroupClient.GetPresentFailureCount();
+        state.suppressedLogMessages = Logger::Instance().GetSuppressedMessageCount();
+        state.droppedLogMessages = Logger::Instance().GetDroppedMessageCount();
+        const auto& stallWatchdog = s_SwapGroupClient.GetStallWatchdog();
+        state.presentStallCount = stallWatchdog.GetStallCount();
+        state.lastPresentStallDurationNs = static_cast<uint64_t>(stallWatchdog.GetLastStallTicks() * 1000000000.0 /
+            GetPerformanceCounterFrequency());
+        state.presentStalled = stallWatchdog.IsStalled() ? 1 : 0;
+    }
 
     /**
      * Method to be called by managed code to get some information about the status of the QuadroSync plugin.
+     *
+     * \param[in,out] state Caller's state, its size field must be set to the size of the caller's struct before the
+     *                      call and is set to the number of bytes filled after the call.
+     *
+     * \return False if the size of the caller's struct is too small.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetState(QuadroSyncState* state)
+    {
+        if (state == nullptr)
+        {
+            return false;
+        }
+
+        QuadroSyncState current;
+        FillQuadroSyncState(current);
+        return CopyQuadroSyncState(current, state);
+    }
+
+    /**
+     * Method to be called by managed code (once) to get the address of the QuadroSyncStateMirror, updated by the
+     * plugin after every present and every render event.
+     *
+     * \remark Reading the mirror does not require any call into the plugin: readers read the 64 bits sequence number,
+     *         skip if it is odd, copy the QuadroSyncState that follows it and read the sequence number again to
+     *         validate it did not change during the copy.  The mirror stays valid until the plugin is unloaded.
+     */
+    extern "C" const void* UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetStateMirror()
+    {
+        return &s_StateMirror;
+    }
+
+    /**
+     * Method to be called by managed code to start publishing the state and the present timings in a named shared
+     * memory readable by other processes (see TelemetryHeader for its layout).
+     *
+     * \param[in] name Name of the shared memory (nullptr or empty to stop publishing).
+     *
+     * \return Success.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API SetTelemetryExport(const char* name)
+    {
+        if (!s_TelemetryExport.Open(name ? name : ""))
+        {
+            return false;
+        }
+        PublishQuadroSyncState();
+        return true;
+    }
+
+    void PublishQuadroSyncState()
+    {
+        s_StateMirror.Update(&FillQuadroSyncState);
+        if (s_TelemetryExport.IsOpen())
+        {
+            s_TelemetryExport.Publish(s_StateMirror.Read(), s_SwapGroupClient.GetPresentTimings());
+        }
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to get the frame count, the swap group and barrier
+     * membership and the result of the last present, without waiting for a render event to be executed.
+     *
+     * \param[out] snapshot Last SwapGroupSnapshot published by the swap group client.
+     *
+     * \return False if \a snapshot is null.
+     */
+    extern "C" bool UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetSwapGroupSnapshot(SwapGroupSnapshot* snapshot)
+    {
+        if (snapshot == nullptr)
+        {
+            return false;
+        }
+
+        *snapshot = s_SwapGroupClient.GetSnapshot();
+        return true;
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to get an estimate of the frame count (the one returned
+     * by QuadroSyncQueryFrameCount but not truncated to 32 bits) at the time of the call.  Each node extrapolates from
+     * its own samples, so use QuadroSyncQueryFrameCount for values compared between the nodes of the cluster.
+     *
+     * \param[out] confidence (Optional) How much the returned value can be trusted (FrameCountConfidence).
+     *
+     * \return The frame count, extrapolated from the last sample of the hardware frame counter.
+     */
+    extern "C" uint64_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetFrameCount(uint32_t* confidence)
+    {
+        FrameCountConfidence frameCountConfidence;
+        const auto frameCount = ExtrapolateFrameCount(s_SwapGroupClient.GetSnapshot(),
+            GetCurrentPerformanceCounterTick(), &frameCountConfidence);
+        if (confidence)
+        {
+            *confidence = static_cast<uint32_t>(frameCountConfidence);
+        }
+        return frameCount;
+    }
+
+    /**
+     * Method to be called by managed code (from any thread) to change the configuration of QuadroSync without going
+     * through a render event.  The change is applied before the next frame is presented (or the next render event).
+     *
+     * \param[in] setting PluginCSwapGroupClient::ConfigurationSetting to change.
+     * \param[in] enable New value of the setting.
+     *
+     * \return Epoch of the change (applied once GetAppliedConfigurationEpoch reaches it), 0 if setting is invalid.
+     */
+    extern "C" uint32_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API PostConfigurationChange(const uint32_t setting,
+        const uint32_t enable)
+    {
+        if (setting > static_cast<uint32_t>(PluginCSwapGroupClient::ConfigurationSetting::SyncCounter))
+        {
+            CLUSTER_LOGF_ERROR(Init, "PostConfigurationChange, invalid setting: {}", setting);
+            return 0;
+        }
+        return s_SwapGroupClient.PostConfigurationChange(
+            static_cast<PluginCSwapGroupClient::ConfigurationSetting>(setting), enable != 0);
+    }
+
+    // Freely defined function returning the epoch up to which the changes posted with PostConfigurationChange are
+    // applied (can be called from any thread)
+    extern "C" uint32_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetAppliedConfigurationEpoch()
+    {
+        return s_SwapGroupClient.GetAppliedConfigurationEpoch();
+    }
+
+    // Cursor of the managed code in the present timings ring (ReadPresentTimings is expected to always be called from
+    // the same thread).
+    static uint64_t s_PresentTimingsReadCursor = 0;
+    static uint64_t s_PresentTimingsDropped = 0;
+
+    /**
+     * Method to be called by managed code to get the timing of the presents done since the last call.
+     *
+     * \param[out] buffer Where to store the timings.
+     * \param[in] capacity Number of PresentTiming that can be stored in \a buffer.
+     * \param[out] dropped (Optional) Total number of timings that were overwritten before being read.
+     *
+     * \return Number of PresentTiming stored in \a buffer.
      */
-    extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API GetState(QuadroSyncState* state)
+    extern "C" uint32_t UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API ReadPresentTimings(PresentTiming* buffer,
+        uint32_t capacity, uint64_t* dropped)
     {
-        state->initializationState = (uint32_t)s_InitializationStatus.load(std::memory_order_relaxed);
-        state->swapGroupId = s_SwapGroupClient.GetSwapGroupId();
-        state->swapBarrierId = s_SwapGroupClient.GetSwapBarrierId();
-        state->presentedFramesSuccess = s_SwapGroupClient.GetPresentSuccessCount();
-        state->presentedFramesFailed = s_SwapGroupClient.GetPresentFailureCount();
+        if (buffer == nullptr)
+        {
+            return 0;
+        }
+
+        const auto readCount = s_SwapGroupClient.GetPresentTimings().Read(s_PresentTimingsReadCursor, buffer, capacity,
+            s_PresentTimingsDropped);
+        if (dropped)
+        {
+            *dropped = s_PresentTimingsDropped;
+        }
+        return readCount;
+    }
+
+    // Identity of the swap chain Unity currently presents through (cheap enough to be checked every frame)
+    static SwapChainIdentity GetUnitySwapChainIdentity()
+    {
+        SwapChainIdentity identity;
+        if (s_UnityGraphicsD3D11 != nullptr)
+        {
+            identity.swapChain = s_UnityGraphicsD3D11->GetSwapChain();
+        }
+        else if (s_UnityGraphicsD3D12)
+        {
+            identity.swapChain = s_UnityGraphicsD3D12->GetSwapChain();
+        }
+
+        DXGI_SWAP_CHAIN_DESC desc;
+        if (identity.swapChain != nullptr && SUCCEEDED(identity.swapChain->GetDesc(&desc)))
+        {
+            identity.width = desc.BufferDesc.Width;
+            identity.height = desc.BufferDesc.Height;
+            identity.format = desc.BufferDesc.Format;
+            identity.bufferCount = desc.BufferCount;
+            identity.flags = desc.Flags;
+            identity.windowed = desc.Windowed;
+        }
+        return identity;
+    }
+
+    // Recreates s_GraphicsDevice if Unity now renders with another device (like after a TDR)
+    static bool ReacquireGraphicsDevice()
+    {
+        IUnknown* device = nullptr;
+        if (s_UnityGraphicsD3D11 != nullptr)
+        {
+            device = s_UnityGraphicsD3D11->GetDevice();
+        }
+        else if (s_UnityGraphicsD3D12)
+        {
+            device = s_UnityGraphicsD3D12->GetDevice();
+        }
+
+        if (device != nullptr && device != s_GraphicsDevice->GetDevice())
+        {
+            CLUSTER_LOG(Device) << "Unity renders with a new device, recreating the graphics device";
+            s_GraphicsDevice = nullptr;
+            InitializeGraphicsDevice();
+        }
+        return s_GraphicsDevice != nullptr;
     }
 
     // Override the query method to use the `PresentFrame` callback
@@ -154,9 +493,38 @@ namespace GfxQuadroSync
         if (query == UnityRenderingExtQueryType::kUnityRenderingExtQueryOverridePresentFrame)
         {
             if (!IsContextValid())
+            {
+                PublishQuadroSyncState();
                 return false;
+            }
 
-            return s_SwapGroupClient.Render(s_GraphicsDevice.get());
+            // After a TDR, Unity creates a new device (and swap chain) that has to join the swap group again.
+            if (s_SwapGroupClient.NeedsDeviceRecovery())
+            {
+                if (!ReacquireGraphicsDevice() || !s_SwapGroupClient.RecoverDevice(s_GraphicsDevice.get()))
+                {
+                    PublishQuadroSyncState();
+                    return false;
+                }
+            }
+
+            // Unity recreates (or resizes) its swap chain on resolution or fullscreen changes, leaving the swap group.
+            const auto swapChainIdentity = GetUnitySwapChainIdentity();
+            if (swapChainIdentity.swapChain != nullptr && s_SwapGroupClient.HasSwapChainChanged(swapChainIdentity))
+            {
+                s_SwapGroupClient.OnSwapChainChanged(s_GraphicsDevice.get(), swapChainIdentity);
+            }
+
+            // Configuration changes posted from other threads are applied between frames, while nothing is presented.
+            if (s_SwapGroupClient.HasPendingConfiguration())
+            {
+                s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(),
+                    s_GraphicsDevice->GetSwapChain());
+            }
+
+            const auto rendered = s_SwapGroupClient.Render(s_GraphicsDevice.get());
+            PublishQuadroSyncState();
+            return rendered;
         }
         return false;
     }
@@ -166,15 +534,15 @@ namespace GfxQuadroSync
         switch (renderer)
         {
         case UnityGfxRenderer::kUnityGfxRendererD3D11:
-            CLUSTER_LOG << "Detected D3D11 renderer";
+            CLUSTER_LOG(Device) << "Detected D3D11 renderer";
             s_UnityGraphicsD3D11 = s_UnityInterfaces->Get<IUnityGraphicsD3D11>();
             break;
         case UnityGfxRenderer::kUnityGfxRendererD3D12:
-            CLUSTER_LOG << "Detected D3D12 renderer";
+            CLUSTER_LOG(Device) << "Detected D3D12 renderer";
             s_UnityGraphicsD3D12 = s_UnityInterfaces->Get<IUnityGraphicsD3D12v7>();
             break;
         default:
-            CLUSTER_LOG_ERROR << "Graphic API not supported";
+            CLUSTER_LOG_ERROR(Device) << "Graphic API not supported";
             break;
         }
     }
@@ -184,7 +552,7 @@ namespace GfxQuadroSync
     {
         if (eventType == kUnityGfxDeviceEventInitialize && !s_Initialized)
         {
-            CLUSTER_LOG << "kUnityGfxDeviceEventInitialize called";
+            CLUSTER_LOG(Init) << "kUnityGfxDeviceEventInitialize called";
             s_Initialized = true;
         }
         else if (eventType == kUnityGfxDeviceEventShutdown)
@@ -231,9 +599,17 @@ namespace GfxQuadroSync
         case EQuadroSyncRenderEvent::QuadroSyncSkipSyncForNextFrame:
             QuadroSyncSkipSyncForNextFrame();
             break;
+        case EQuadroSyncRenderEvent::QuadroSyncExecuteCommandPacket:
+            QuadroSyncExecuteCommandPacket(static_cast<CommandPacketHeader*>(data));
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncReconfigure:
+            QuadroSyncReconfigure(reinterpret_cast<uintptr_t>(data));
+            break;
         default:
             break;
         }
+
+        PublishQuadroSyncState();
     }
 
     void SetDevice()
@@ -270,32 +646,32 @@ namespace GfxQuadroSync
     {
         if (s_UnityGraphics == nullptr)
         {
-            CLUSTER_LOG_ERROR << "IsContextValid, s_UnityGraphics == nullptr";
+            CLUSTER_LOG_ERROR(Device) << "IsContextValid, s_UnityGraphics == nullptr";
             return false;
         }
 
         if (s_GraphicsDevice == nullptr)
         {
-            CLUSTER_LOG_ERROR << "IsContextValid, s_GraphicsDevice == nullptr";
+            CLUSTER_LOG_ERROR(Device) << "IsContextValid, s_GraphicsDevice == nullptr";
             return false;
         }
 
         if (s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D11 &&
             s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D12)
         {
-            CLUSTER_LOG_ERROR << "IsContextValid, s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D11-12";
+            CLUSTER_LOG_ERROR(Device) << "IsContextValid, s_UnityGraphics->GetRenderer() != UnityGfxRenderer::kUnityGfxRendererD3D11-12";
             return false;
         }
 
         if (s_GraphicsDevice->GetDevice() == nullptr)
         {
-            CLUSTER_LOG_WARNING << "IsContextValid, GetDevice() == nullptr";
+            CLUSTER_LOG_WARNING(Device) << "IsContextValid, GetDevice() == nullptr";
             SetDevice();
         }
 
         if (s_GraphicsDevice->GetSwapChain() == nullptr)
         {
-            CLUSTER_LOG_WARNING << "IsContextValid, GetSwapChain() == nullptr";
+            CLUSTER_LOG_WARNING(Device) << "IsContextValid, GetSwapChain() == nullptr";
             SetSwapChain();
         }
 
@@ -329,7 +705,7 @@ namespace GfxQuadroSync
                 auto presentFlags = s_UnityGraphicsD3D11->GetPresentFlags();
 
                 s_GraphicsDevice = std::make_unique<D3D11GraphicsDevice>(device, swapChain, syncInterval, presentFlags);
-                CLUSTER_LOG << "D3D11GraphicsDevice successfully created";
+                CLUSTER_LOG(Device) << "D3D11GraphicsDevice successfully created";
             }
             else if (s_UnityGraphicsD3D12 != nullptr)
             {
@@ -341,12 +717,12 @@ namespace GfxQuadroSync
 
                 s_GraphicsDevice = std::make_unique<D3D12GraphicsDevice>(device, swapChain, commandQueue, syncInterval,
                     presentFlags);
-                CLUSTER_LOG << "D3D12GraphicsDevice successfully created";
+                CLUSTER_LOG(Device) << "D3D12GraphicsDevice successfully created";
             }
             else
             {
                 s_InitializationStatus = QuadroSyncInitializationStatus::UnsupportedGraphicApi;
-                CLUSTER_LOG_ERROR << "Graphic API incompatible";
+                CLUSTER_LOG_ERROR(Device) << "Graphic API incompatible";
                 return false;
             }
         }
@@ -383,7 +759,7 @@ namespace GfxQuadroSync
     {
         if (!InitializeGraphicsDevice())
         {
-            CLUSTER_LOG_ERROR << "Failed during QuadroSyncInitialize";
+            CLUSTER_LOG_ERROR(Init) << "Failed during QuadroSyncInitialize";
             return;
         }
 
@@ -395,12 +771,12 @@ namespace GfxQuadroSync
         if (swapGroupClientInitializeStatus == PluginCSwapGroupClient::InitializeStatus::Success)
         {
             s_InitializationStatus = QuadroSyncInitializationStatus::Initialized;
-            CLUSTER_LOG << "Quadro Sync initialized";
+            CLUSTER_LOG(Init) << "Quadro Sync initialized";
         }
         else
         {
             s_InitializationStatus = ConvertToQuadroSyncInitializationStatus(swapGroupClientInitializeStatus);
-            CLUSTER_LOG_ERROR << "Quadro Sync initialization failed";
+            CLUSTER_LOG_ERROR(Init) << "Quadro Sync initialization failed";
         }
     }
 
@@ -444,9 +820,9 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
-        s_SwapGroupClient.EnableSystem(
-            s_GraphicsDevice->GetDevice(),
-            s_GraphicsDevice->GetSwapChain(), value);
+        // Through the configuration mailbox so that it is ordered with changes posted from other threads.
+        s_SwapGroupClient.PostConfigurationChange(PluginCSwapGroupClient::ConfigurationSetting::System, value);
+        s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
     }
 
     // Toggle to join/leave the SwapGroup
@@ -455,10 +831,9 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
-        s_SwapGroupClient.EnableSwapGroup(
-            s_GraphicsDevice->GetDevice(),
-            s_GraphicsDevice->GetSwapChain(),
-            value);
+        // Through the configuration mailbox so that it is ordered with changes posted from other threads.
+        s_SwapGroupClient.PostConfigurationChange(PluginCSwapGroupClient::ConfigurationSetting::SwapGroup, value);
+        s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
     }
 
     // Toggle to join/leave the Barrier
@@ -467,9 +842,9 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
-        s_SwapGroupClient.EnableSwapBarrier(
-            s_GraphicsDevice->GetDevice(),
-            value);
+        // Through the configuration mailbox so that it is ordered with changes posted from other threads.
+        s_SwapGroupClient.PostConfigurationChange(PluginCSwapGroupClient::ConfigurationSetting::SwapBarrier, value);
+        s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
     }
 
     // Enable or disable the Master Sync Counter
@@ -478,7 +853,9 @@ namespace GfxQuadroSync
         if (!IsContextValid())
             return;
 
-        s_SwapGroupClient.EnableSyncCounter(value);
+        // Through the configuration mailbox so that it is ordered with changes posted from other threads.
+        s_SwapGroupClient.PostConfigurationChange(PluginCSwapGroupClient::ConfigurationSetting::SyncCounter, value);
+        s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
     }
 
     // Indicate that the next frame to be presented should be presented using the normal present
@@ -489,4 +866,82 @@ namespace GfxQuadroSync
 
         s_SwapGroupClient.SkipSynchronizedPresentOfNextFrame();
     }
+
+    // Change the swap group and barrier membership and the frame counter used
+    bool QuadroSyncReconfigure(const uint64_t configuration)
+    {
+        if (!IsContextValid())
+            return false;
+
+        // Changes posted before this one must be applied before it.
+        s_SwapGroupClient.ApplyPendingConfiguration(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain());
+        return s_SwapGroupClient.Reconfigure(s_GraphicsDevice->GetDevice(), s_GraphicsDevice->GetSwapChain(),
+            SwapGroupConfiguration::Unpack(configuration)) == PluginCSwapGroupClient::ReconfigureStatus::Success;
+    }
+
+    // Execute one command of a command packet
+    static CommandStatus ExecutePacketCommand(const uint32_t id, const uint64_t argument, int64_t& result)
+    {
+        const auto renderEvent = static_cast<EQuadroSyncRenderEvent>(id);
+        if (renderEvent == EQuadroSyncRenderEvent::QuadroSyncInitialize)
+        {
+            QuadroSyncInitialize();
+            return s_InitializationStatus.load(std::memory_order_relaxed) ==
+                QuadroSyncInitializationStatus::Initialized ? CommandStatus::Succeeded : CommandStatus::Failed;
+        }
+
+        // Packets cannot be nested
+        if (id > static_cast<uint32_t>(EQuadroSyncRenderEvent::QuadroSyncReconfigure) ||
+            renderEvent == EQuadroSyncRenderEvent::QuadroSyncExecuteCommandPacket)
+        {
+            return CommandStatus::UnknownCommand;
+        }
+        if (!IsContextValid())
+        {
+            return CommandStatus::Failed;
+        }
+
+        switch (renderEvent)
+        {
+        case EQuadroSyncRenderEvent::QuadroSyncQueryFrameCount:
+        {
+            int frameCount = 0;
+            QuadroSyncQueryFrameCount(&frameCount);
+            result = frameCount;
+            break;
+        }
+        case EQuadroSyncRenderEvent::QuadroSyncResetFrameCount:
+            QuadroSyncResetFrameCount();
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncDispose:
+            QuadroSyncDispose();
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableSystem:
+            QuadroSyncEnableSystem(argument != 0);
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableSwapGroup:
+            QuadroSyncEnableSwapGroup(argument != 0);
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableSwapBarrier:
+            QuadroSyncEnableSwapBarrier(argument != 0);
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncEnableSyncCounter:
+            QuadroSyncEnableSyncCounter(argument != 0);
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncSkipSyncForNextFrame:
+            QuadroSyncSkipSyncForNextFrame();
+            break;
+        case EQuadroSyncRenderEvent::QuadroSyncReconfigure:
+            return QuadroSyncReconfigure(argument) ? CommandStatus::Succeeded : CommandStatus::Failed;
+        default:
+            return CommandStatus::UnknownCommand;
+        }
+        return CommandStatus::Succeeded;
+    }
+
+    // Execute every command of a command packet
+    void QuadroSyncExecuteCommandPacket(CommandPacketHeader* const packet)
+    {
+        ExecuteCommandPacket(packet, &ExecutePacketCommand);
+    }
 }
@@ -0,0 +1,127 @@
+#include "LogFormat.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        /// Append text to a buffer, truncating what does not fit.
+        class LogTextWriter
+        {
+        public:
+            LogTextWriter(char* const buffer, const size_t capacity)
+                : m_Buffer(buffer)
+                , m_Capacity(capacity)
+            {
+            }
+
+            void Append(const char* const text, const size_t length)
+            {
+                const auto available = m_Capacity - 1 - m_Length;
+                const auto toCopy = length < available ? length : available;
+                std::memcpy(m_Buffer + m_Length, text, toCopy);
+                m_Length += toCopy;
+            }
+
+            void Append(const char* const text)
+            {
+                Append(text, std::strlen(text));
+            }
+
+            template <class... Args>
+            void AppendFormatted(const char* const format, const Args... args)
+            {
+                char text[64];
+                const auto length = std::snprintf(text, sizeof(text), format, args...);
+                if (length > 0)
+                {
+                    Append(text, static_cast<size_t>(length) < sizeof(text) ? length : sizeof(text) - 1);
+                }
+            }
+
+            size_t Terminate()
+            {
+                m_Buffer[m_Length] = 0;
+                return m_Length;
+            }
+
+        private:
+            char* const m_Buffer;
+            const size_t m_Capacity;
+            size_t m_Length = 0;
+        };
+
+        void AppendArgument(LogTextWriter& writer, const LogArgument& argument,
+            const StatusMessageFunction statusMessageFunction)
+        {
+            switch (argument.kind)
+            {
+            case LogArgumentKind::Int:
+                writer.AppendFormatted("%" PRId64, argument.intValue);
+                break;
+            case LogArgumentKind::UInt:
+                writer.AppendFormatted("%" PRIu64, argument.uintValue);
+                break;
+            case LogArgumentKind::Double:
+                writer.AppendFormatted("%g", argument.doubleValue);
+                break;
+            case LogArgumentKind::Bool:
+                writer.Append(argument.uintValue ? "true" : "false");
+                break;
+            case LogArgumentKind::HResult:
+                writer.AppendFormatted("HRESULT 0x%08X", static_cast<uint32_t>(argument.intValue));
+                break;
+            case LogArgumentKind::NvApiStatus:
+            {
+                // Same output as operator<<(std::ostream&, NvAPI_Status)
+                const auto status = static_cast<NvAPI_Status>(argument.intValue);
+                NvAPI_ShortString statusString;
+                if (statusMessageFunction == nullptr || statusMessageFunction(status, statusString) != NVAPI_OK)
+                {
+                    writer.AppendFormatted("NvAPI_Status (%d)", static_cast<int>(status));
+                }
+                else
+                {
+                    writer.Append(statusString);
+                    writer.AppendFormatted(" (%d)", static_cast<int>(status));
+                }
+                break;
+            }
+            case LogArgumentKind::StaticString:
+                writer.Append(argument.stringValue ? argument.stringValue : "(null)");
+                break;
+            }
+        }
+    }
+
+    size_t FormatLogMessage(const LogFormat& format, const LogArgument* const arguments,
+        const StatusMessageFunction statusMessageFunction, char* const buffer, const size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            return 0;
+        }
+
+        LogTextWriter writer(buffer, capacity);
+        uint32_t argumentIndex = 0;
+        const char* textBegin = format.format;
+        for (const char* current = format.format; *current != 0; ++current)
+        {
+            if (current[0] == '{' && current[1] == '}')
+            {
+                writer.Append(textBegin, current - textBegin);
+                if (argumentIndex < format.argumentCount)
+                {
+                    AppendArgument(writer, arguments[argumentIndex++], statusMessageFunction);
+                }
+                ++current;
+                textBegin = current + 1;
+            }
+        }
+        writer.Append(textBegin);
+        return writer.Terminate();
+    }
+}
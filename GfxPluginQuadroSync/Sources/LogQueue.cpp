@@ -0,0 +1,111 @@
+#include "LogQueue.h"
+
+#include <cstring>
+
+namespace GfxQuadroSync
+{
+    LogQueue::LogQueue()
+        : m_Cells(new Cell[k_Capacity])
+    {
+        for (uint32_t cellIndex = 0; cellIndex < k_Capacity; ++cellIndex)
+        {
+            m_Cells[cellIndex].sequence.store(cellIndex, std::memory_order_relaxed);
+        }
+    }
+
+    bool LogQueue::TryPush(const LogType logType, const char* const message, size_t length)
+    {
+        uint64_t position;
+        const auto cell = ClaimCell(position);
+        if (cell == nullptr)
+        {
+            return false;
+        }
+
+        if (length > k_MaxMessageLength)
+        {
+            length = k_MaxMessageLength;
+        }
+        cell->record.logType = logType;
+        cell->record.format = nullptr;
+        cell->record.length = static_cast<uint32_t>(length);
+        std::memcpy(cell->record.message, message, length);
+        cell->record.message[length] = 0;
+
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool LogQueue::TryPush(const LogFormat& format, const LogArgument* const arguments)
+    {
+        uint64_t position;
+        const auto cell = ClaimCell(position);
+        if (cell == nullptr)
+        {
+            return false;
+        }
+
+        cell->record.logType = format.logType;
+        cell->record.format = &format;
+        std::memcpy(cell->record.arguments, arguments, format.argumentCount * sizeof(LogArgument));
+
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool LogQueue::TryPop(Record& record)
+    {
+        Cell& cell = m_Cells[m_DequeuePosition & k_IndexMask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_DequeuePosition + 1)
+        {
+            // Empty (or the producer of the next message has not finished writing it yet).
+            return false;
+        }
+
+        record.logType = cell.record.logType;
+        record.format = cell.record.format;
+        if (record.format)
+        {
+            std::memcpy(record.arguments, cell.record.arguments, record.format->argumentCount * sizeof(LogArgument));
+        }
+        else
+        {
+            record.length = cell.record.length;
+            std::memcpy(record.message, cell.record.message, cell.record.length + 1);
+        }
+
+        cell.sequence.store(m_DequeuePosition + k_Capacity, std::memory_order_release);
+        ++m_DequeuePosition;
+        return true;
+    }
+
+    LogQueue::Cell* LogQueue::ClaimCell(uint64_t& position)
+    {
+        position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto cell = &m_Cells[position & k_IndexMask];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - position);
+            if (difference == 0)
+            {
+                if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return cell;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Record still used by the message pushed k_Capacity positions ago -> queue is full.
+                m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                // Another producer took this position, try with the next one.
+                position = m_EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
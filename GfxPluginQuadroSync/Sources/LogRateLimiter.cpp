@@ -0,0 +1,141 @@
+#include "LogRateLimiter.h"
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        /// Returns the first NvAPI_Status or HRESULT argument (a null StaticString if there is none).
+        LogArgument FindStatus(const LogFormat& format, const LogArgument* const arguments)
+        {
+            for (uint32_t argumentIndex = 0; argumentIndex < format.argumentCount; ++argumentIndex)
+            {
+                const auto& argument = arguments[argumentIndex];
+                if (argument.kind == LogArgumentKind::NvApiStatus || argument.kind == LogArgumentKind::HResult)
+                {
+                    return argument;
+                }
+            }
+            return MakeLogArgument(static_cast<const char*>(nullptr));
+        }
+
+        /// splitmix64 finalizer.
+        uint64_t Mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+    }
+
+    LogRateLimiter::LogRateLimiter(const uint64_t ticksPerSecond)
+        : m_TicksPerSecond(ticksPerSecond)
+        , m_PeriodTicks(ticksPerSecond * k_DefaultPeriodSeconds)
+    {
+    }
+
+    void LogRateLimiter::Configure(const uint32_t burst, const uint32_t periodSeconds)
+    {
+        m_Burst.store(burst, std::memory_order_relaxed);
+        m_PeriodTicks.store(m_TicksPerSecond * periodSeconds, std::memory_order_relaxed);
+    }
+
+    bool LogRateLimiter::ShouldLog(const LogFormat& format, const LogArgument* const arguments)
+    {
+        const auto burst = m_Burst.load(std::memory_order_relaxed);
+        if (burst == 0)
+        {
+            return true;
+        }
+
+        const auto entry = FindOrClaimEntry(format, FindStatus(format, arguments));
+        if (entry == nullptr)
+        {
+            return true;
+        }
+
+        if (entry->countInPeriod.fetch_add(1, std::memory_order_relaxed) < burst)
+        {
+            return true;
+        }
+        entry->suppressedInPeriod.fetch_add(1, std::memory_order_relaxed);
+        m_SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t LogRateLimiter::CollectSummaries(const uint64_t nowTick, Summary* const summaries,
+        const uint32_t capacity)
+    {
+        const auto periodTicks = m_PeriodTicks.load(std::memory_order_relaxed);
+        uint32_t summaryCount = 0;
+        for (auto& entry: m_Entries)
+        {
+            if (summaryCount >= capacity)
+            {
+                break;
+            }
+
+            const auto format = entry.format.load(std::memory_order_acquire);
+            if (format == nullptr)
+            {
+                continue;
+            }
+            const auto periodStartTick = entry.periodStartTick.load(std::memory_order_relaxed);
+            if (periodStartTick == 0)
+            {
+                // First time we see the entry.
+                entry.periodStartTick.store(nowTick, std::memory_order_relaxed);
+                continue;
+            }
+            if (nowTick - periodStartTick < periodTicks)
+            {
+                continue;
+            }
+
+            // Period is over, start a new one.
+            entry.periodStartTick.store(nowTick, std::memory_order_relaxed);
+            entry.countInPeriod.store(0, std::memory_order_relaxed);
+            const auto suppressedCount = entry.suppressedInPeriod.exchange(0, std::memory_order_relaxed);
+            if (suppressedCount > 0)
+            {
+                auto& summary = summaries[summaryCount++];
+                summary.format = format;
+                summary.status = entry.status;
+                summary.suppressedCount = suppressedCount;
+                summary.periodTicks = nowTick - periodStartTick;
+            }
+        }
+        return summaryCount;
+    }
+
+    LogRateLimiter::Entry* LogRateLimiter::FindOrClaimEntry(const LogFormat& format, const LogArgument& status)
+    {
+        auto key = Mix(reinterpret_cast<uintptr_t>(&format) ^ Mix(static_cast<uint64_t>(status.intValue)));
+        if (key == 0)
+        {
+            key = 1;
+        }
+
+        const auto firstIndex = static_cast<uint32_t>(key % k_TableSize);
+        for (uint32_t probe = 0; probe < k_TableSize; ++probe)
+        {
+            auto& entry = m_Entries[(firstIndex + probe) % k_TableSize];
+            auto entryKey = entry.key.load(std::memory_order_relaxed);
+            if (entryKey == key)
+            {
+                return &entry;
+            }
+            if (entryKey == 0 && entry.key.compare_exchange_strong(entryKey, key, std::memory_order_relaxed))
+            {
+                entry.status = status;
+                entry.format.store(&format, std::memory_order_release);
+                return &entry;
+            }
+            if (entryKey == key)
+            {
+                // Claimed by another thread for the same group while we were trying to claim it.
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+}
@@ -1,26 +1,214 @@
 #include "Logger.h"
+#include "PerformanceCounter.h"
 
-#include "../../External/NvAPI/nvapi.h"
+#include <cstdio>
+#include <cstring>
 
 namespace GfxQuadroSync
 {
+    Logger::Logger()
+        : m_RateLimiter(GetPerformanceCounterFrequency())
+    {
+    }
+
+    Logger::~Logger()
+    {
+        // Joining a thread from a static destructor would deadlock on the loader lock (and on process exit the thread
+        // has already been terminated anyway), Shutdown should have been called by UnityPluginUnload.
+        if (m_DrainThread.joinable())
+        {
+            m_DrainThread.detach();
+        }
+    }
+
     void Logger::SetManagedCallback(const ManagedCallback managedCallback)
     {
-        m_ManagedCallback = managedCallback;
+        std::lock_guard<std::mutex> lock(m_ControlLock);
+        StopDrainThread();
+        Flush();
+        m_ManagedCallback.store(managedCallback, std::memory_order_relaxed);
+        UpdateDrainThread();
+    }
+
+    void Logger::SetDeliveryMode(const LogDeliveryMode deliveryMode)
+    {
+        std::lock_guard<std::mutex> lock(m_ControlLock);
+        if (deliveryMode == m_DeliveryMode)
+        {
+            return;
+        }
+        m_DeliveryMode = deliveryMode;
+        StopDrainThread();
+        UpdateDrainThread();
+    }
+
+    uint32_t Logger::Flush()
+    {
+        std::lock_guard<std::mutex> lock(m_FlushLock);
+        const auto managedCallback = m_ManagedCallback.load(std::memory_order_relaxed);
+
+        uint32_t deliveredCount = 0;
+        LogQueue::Record record;
+        while (m_Queue.TryPop(record))
+        {
+            if (managedCallback)
+            {
+                if (record.format)
+                {
+                    static constexpr char k_Prefix[] = "QuadroSync: ";
+                    std::memcpy(record.message, k_Prefix, sizeof(k_Prefix) - 1);
+                    FormatLogMessage(*record.format, record.arguments, m_StatusMessageFunction,
+                        record.message + sizeof(k_Prefix) - 1, sizeof(record.message) - sizeof(k_Prefix) + 1);
+                }
+                managedCallback((int)record.logType, record.message);
+                ++deliveredCount;
+            }
+        }
+
+        if (managedCallback)
+        {
+            deliveredCount += DeliverSuppressedSummaries(managedCallback);
+        }
+
+        const auto droppedCount = m_Queue.GetDroppedCount();
+        if (droppedCount != m_ReportedDroppedCount && managedCallback)
+        {
+            // Dropped messages are reported after the ones that were delivered, so this message will be close to
+            // where messages are missing.
+            char message[128];
+            std::snprintf(message, sizeof(message),
+                "QuadroSync: %llu log messages dropped because the log queue was full",
+                static_cast<unsigned long long>(droppedCount - m_ReportedDroppedCount));
+            managedCallback((int)LogType::Warning, message);
+            ++deliveredCount;
+        }
+        m_ReportedDroppedCount = droppedCount;
+
+        return deliveredCount;
+    }
+
+    void Logger::Shutdown()
+    {
+        std::lock_guard<std::mutex> lock(m_ControlLock);
+        StopDrainThread();
+        Flush();
+    }
+
+    void Logger::SetStatusMessageFunction(const StatusMessageFunction statusMessageFunction)
+    {
+        m_StatusMessageFunction = statusMessageFunction;
+    }
+
+    void Logger::LogMessage(const LogType logType, const char* const message, const size_t length)
+    {
+        m_Queue.TryPush(logType, message, length);
     }
 
-    void Logger::LogMessage(const LogType logType, const std::string& message)
+    void Logger::LogMessage(const LogFormat& format, const LogArgument* const arguments)
     {
-        if (m_ManagedCallback)
+        if (m_RateLimiter.ShouldLog(format, arguments))
         {
-            m_ManagedCallback((int)logType, message.c_str());
+            m_Queue.TryPush(format, arguments);
         }
     }
 
+    uint32_t Logger::DeliverSuppressedSummaries(const ManagedCallback managedCallback)
+    {
+        static constexpr LogFormat k_SummaryFormat{LogType::Warning,
+            "Suppressed {} occurrences of \"{}\" in the last {} s", 3};
+        static constexpr LogFormat k_SummaryWithStatusFormat{LogType::Warning,
+            "Suppressed {} occurrences of \"{}\" with {} in the last {} s", 4};
+        static constexpr char k_Prefix[] = "QuadroSync: ";
+
+        uint32_t deliveredCount = 0;
+        LogRateLimiter::Summary summaries[8];
+        uint32_t summaryCount;
+        do
+        {
+            summaryCount = m_RateLimiter.CollectSummaries(GetCurrentPerformanceCounterTick(), summaries,
+                sizeof(summaries) / sizeof(summaries[0]));
+            for (uint32_t summaryIndex = 0; summaryIndex < summaryCount; ++summaryIndex)
+            {
+                const auto& summary = summaries[summaryIndex];
+                const bool hasStatus = summary.status.kind != LogArgumentKind::StaticString;
+                LogArgument arguments[4];
+                uint32_t argumentIndex = 0;
+                arguments[argumentIndex++] = MakeLogArgument(summary.suppressedCount);
+                arguments[argumentIndex++] = MakeLogArgument(summary.format->format);
+                if (hasStatus)
+                {
+                    arguments[argumentIndex++] = summary.status;
+                }
+                arguments[argumentIndex++] = MakeLogArgument(
+                    static_cast<double>(summary.periodTicks) / GetPerformanceCounterFrequency());
+
+                char message[LogQueue::k_MaxMessageLength + 1];
+                std::memcpy(message, k_Prefix, sizeof(k_Prefix) - 1);
+                FormatLogMessage(hasStatus ? k_SummaryWithStatusFormat : k_SummaryFormat, arguments,
+                    m_StatusMessageFunction, message + sizeof(k_Prefix) - 1, sizeof(message) - sizeof(k_Prefix) + 1);
+                managedCallback((int)LogType::Warning, message);
+                ++deliveredCount;
+            }
+        } while (summaryCount == sizeof(summaries) / sizeof(summaries[0]));
+        return deliveredCount;
+    }
+
+    void Logger::UpdateDrainThread()
+    {
+        if (m_DeliveryMode == LogDeliveryMode::DrainThread && m_ManagedCallback.load(std::memory_order_relaxed) &&
+            !m_DrainThread.joinable())
+        {
+            m_StopDrainThread = false;
+            m_DrainThread = std::thread(&Logger::DrainThreadLoop, this);
+        }
+    }
+
+    void Logger::StopDrainThread()
+    {
+        if (!m_DrainThread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_DrainThreadLock);
+            m_StopDrainThread = true;
+        }
+        m_DrainThreadCondition.notify_one();
+        m_DrainThread.join();
+    }
+
+    void Logger::DrainThreadLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_DrainThreadLock);
+        while (!m_StopDrainThread)
+        {
+            // Producers never notify us (to keep logging as cheap as possible), so simply poll the queue.
+            m_DrainThreadCondition.wait_for(lock, k_DrainPeriod, [this] { return m_StopDrainThread; });
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+
+    LoggingStream::~LoggingStream()
+    {
+        if (IsTruncated())
+        {
+            static constexpr char k_TruncationMarker[] = "...";
+            std::memcpy(pptr() - sizeof(k_TruncationMarker) + 1, k_TruncationMarker, sizeof(k_TruncationMarker) - 1);
+        }
+        Logger::Instance().LogMessage(m_LogType, GetText(), GetLength());
+    }
+
     std::ostream& operator<<(std::ostream& os, const NvAPI_Status status)
     {
+        const auto statusMessageFunction = Logger::Instance().GetStatusMessageFunction();
         NvAPI_ShortString statusString;
-        NvAPI_GetErrorMessage(status, statusString);
+        if (statusMessageFunction == nullptr || statusMessageFunction(status, statusString) != NVAPI_OK)
+        {
+            return os << "NvAPI_Status (" << (int)status << ')';
+        }
         return os << statusString << " (" << (int)status << ')';
     }
 }
@@ -0,0 +1,67 @@
+#include "d3d11.h"
+#include "d3d12.h"
+
+#include "NvApiSwapGroupApi.h"
+
+#include "../External/NvAPI/nvapi.h"
+
+namespace GfxQuadroSync
+{
+    NvAPI_Status NvApiSwapGroupApi::Initialize()
+    {
+        return NvAPI_Initialize();
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::EnumPhysicalGPUs(NvPhysicalGpuHandle gpuHandles[NVAPI_MAX_PHYSICAL_GPUS],
+        NvU32* const gpuCount)
+    {
+        return NvAPI_EnumPhysicalGPUs(gpuHandles, gpuCount);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::SetupWorkstationSwapGroupFeature(const NvPhysicalGpuHandle gpuHandle,
+        const bool enable)
+    {
+        return enable ?
+            NvAPI_GPU_WorkstationFeatureSetup(gpuHandle, NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP, 0) :
+            NvAPI_GPU_WorkstationFeatureSetup(gpuHandle, 0, NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::QueryMaxSwapGroup(IUnknown* const device, NvU32* const maxGroups,
+        NvU32* const maxBarriers)
+    {
+        return NvAPI_D3D1x_QueryMaxSwapGroup(device, maxGroups, maxBarriers);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::JoinSwapGroup(IUnknown* const device, IDXGISwapChain* const swapChain,
+        const NvU32 group, const bool blocking)
+    {
+        return NvAPI_D3D1x_JoinSwapGroup(device, swapChain, group, blocking ? TRUE : FALSE);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::BindSwapBarrier(IUnknown* const device, const NvU32 group, const NvU32 barrier)
+    {
+        return NvAPI_D3D1x_BindSwapBarrier(device, group, barrier);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::QuerySwapGroup(IUnknown* const device, IDXGISwapChain* const swapChain,
+        NvU32* const group, NvU32* const barrier)
+    {
+        return NvAPI_D3D1x_QuerySwapGroup(device, swapChain, group, barrier);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::QueryFrameCount(IUnknown* const device, NvU32* const frameCount)
+    {
+        return NvAPI_D3D1x_QueryFrameCount(device, frameCount);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::ResetFrameCount(IUnknown* const device)
+    {
+        return NvAPI_D3D1x_ResetFrameCount(device);
+    }
+
+    NvAPI_Status NvApiSwapGroupApi::Present(IUnknown* const device, IDXGISwapChain* const swapChain,
+        const NvU32 syncInterval, const NvU32 flags)
+    {
+        return NvAPI_D3D1x_Present(device, swapChain, syncInterval, flags);
+    }
+}
@@ -0,0 +1,54 @@
+#include "PerformanceCounter.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <chrono>
+#endif
+
+namespace GfxQuadroSync
+{
+#ifdef _WIN32
+    uint64_t GetCurrentPerformanceCounterTick()
+    {
+        LARGE_INTEGER ret;
+        if (QueryPerformanceCounter(&ret))
+        {
+            return ret.QuadPart;
+        }
+        else
+        {
+            // I've never seen QueryPerformanceCounter fail, but let's play safe...
+            return 0;
+        }
+    }
+
+    uint64_t GetPerformanceCounterFrequency()
+    {
+        // Frequency of the performance counter is fixed at system boot, no need to query it every time.
+        static const uint64_t frequency = []() -> uint64_t
+        {
+            LARGE_INTEGER performanceCounterFrequency;
+            if (QueryPerformanceFrequency(&performanceCounterFrequency))
+            {
+                return performanceCounterFrequency.QuadPart;
+            }
+            return 0;
+        }();
+        return frequency;
+    }
+#else
+    // Used when building the core library on other platforms (tests and benchmarks).  Ticks are nanoseconds of a
+    // monotonic clock.
+    uint64_t GetCurrentPerformanceCounterTick()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t GetPerformanceCounterFrequency()
+    {
+        return 1000000000;
+    }
+#endif
+}
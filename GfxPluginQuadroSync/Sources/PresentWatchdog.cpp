@@ -0,0 +1,102 @@
+#include "PresentWatchdog.h"
+#include "Logger.h"
+#include "PerformanceCounter.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace GfxQuadroSync
+{
+    PresentWatchdog::PresentWatchdog(const uint64_t ticksPerSecond)
+        : m_TicksPerSecond(ticksPerSecond)
+    {
+    }
+
+    PresentWatchdog::~PresentWatchdog()
+    {
+        Stop();
+    }
+
+    void PresentWatchdog::Start(const uint32_t thresholdMs, StallCallback stallCallback)
+    {
+        std::lock_guard<std::mutex> lock(m_ControlLock);
+        if (m_Thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> threadLock(m_ThreadLock);
+                m_StopThread = true;
+            }
+            m_ThreadCondition.notify_one();
+            m_Thread.join();
+        }
+
+        m_ThresholdTicks.store(m_TicksPerSecond * thresholdMs / 1000, std::memory_order_relaxed);
+        if (thresholdMs == 0)
+        {
+            return;
+        }
+
+        m_StopThread = false;
+        m_Thread = std::thread(&PresentWatchdog::WatchdogLoop, this, std::move(stallCallback));
+    }
+
+    void PresentWatchdog::Stop()
+    {
+        Start(0, nullptr);
+    }
+
+    bool PresentWatchdog::PresentEnded(const uint64_t endTick)
+    {
+        const auto presentInProgress = m_PresentInProgress.exchange(0, std::memory_order_acq_rel);
+        if ((presentInProgress & k_StalledFlag) == 0)
+        {
+            return false;
+        }
+
+        m_LastStallTicks.store(endTick - (presentInProgress & ~k_StalledFlag), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool PresentWatchdog::Check(const uint64_t nowTick)
+    {
+        const auto thresholdTicks = m_ThresholdTicks.load(std::memory_order_relaxed);
+        auto presentInProgress = m_PresentInProgress.load(std::memory_order_acquire);
+        if (thresholdTicks == 0 || presentInProgress == 0 || (presentInProgress & k_StalledFlag) != 0 ||
+            nowTick < presentInProgress || nowTick - presentInProgress < thresholdTicks)
+        {
+            return false;
+        }
+
+        // Fails if the present ended (or a new one started) in the meantime
+        if (!m_PresentInProgress.compare_exchange_strong(presentInProgress, presentInProgress | k_StalledFlag,
+            std::memory_order_acq_rel))
+        {
+            return false;
+        }
+        m_StallCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void PresentWatchdog::WatchdogLoop(const StallCallback stallCallback)
+    {
+        // Check a few times per threshold so that stalls are detected at most 25% late.
+        const auto thresholdTicks = m_ThresholdTicks.load(std::memory_order_relaxed);
+        const auto checkPeriod = std::clamp(std::chrono::microseconds(thresholdTicks * 1000000 / m_TicksPerSecond / 4),
+            std::chrono::microseconds(1000), std::chrono::microseconds(100000));
+        const auto thresholdMs = thresholdTicks * 1000 / m_TicksPerSecond;
+
+        std::unique_lock<std::mutex> lock(m_ThreadLock);
+        while (!m_ThreadCondition.wait_for(lock, checkPeriod, [this] { return m_StopThread; }))
+        {
+            if (Check(GetCurrentPerformanceCounterTick()))
+            {
+                CLUSTER_LOGF_WARNING(Present, "Present blocked for more than {} ms, a node might have left the swap "
+                    "barrier", thresholdMs);
+                if (stallCallback)
+                {
+                    stallCallback();
+                }
+            }
+        }
+    }
+}
@@ -1,38 +1,39 @@
 #include <string>
 #include <sstream>
-#include <fstream>
-
-#include "d3d11.h"
-#include "d3d12.h"
 
 #include "QuadroSync.h"
 #include "Logger.h"
 #include "IGraphicsDevice.h"
+#include "PerformanceCounter.h"
 
 namespace GfxQuadroSync
 {
-    PluginCSwapGroupClient::PluginCSwapGroupClient()
+    PluginCSwapGroupClient::PluginCSwapGroupClient(std::unique_ptr<INvSwapGroupApi> swapGroupApi)
+        : m_SwapGroupApi(std::move(swapGroupApi))
+        , m_FrameCountService(GetPerformanceCounterFrequency())
+        , m_StallWatchdog(GetPerformanceCounterFrequency())
     {
-        CLUSTER_LOG << "Initialize PluginCSwapGroupClient";
+        CLUSTER_LOG(Init) << "Initialize PluginCSwapGroupClient";
         Prepare();
     }
 
     PluginCSwapGroupClient::~PluginCSwapGroupClient()
     {
-        CLUSTER_LOG << "Destroy PluginCSwapGroupClient";
+        CLUSTER_LOG(Init) << "Destroy PluginCSwapGroupClient";
+        m_StallWatchdog.Stop();
     }
 
     void PluginCSwapGroupClient::Prepare()
     {
         // Prepare NVAPI for use in this application
-        NvAPI_Status status = NvAPI_Initialize();
+        NvAPI_Status status = m_SwapGroupApi->Initialize();
 
         if (status != NVAPI_OK)
         {
-            CLUSTER_LOG_ERROR << "NvAPI_Initialize: " << status;
+            CLUSTER_LOG_ERROR(NvApi) << "NvAPI_Initialize: " << status;
         }
         else
-            CLUSTER_LOG << "NvAPI_Initialize successful";
+            CLUSTER_LOG_DEBUG(NvApi) << "NvAPI_Initialize successful";
     }
 
     void PluginCSwapGroupClient::SetupWorkStation()
@@ -40,18 +41,18 @@ namespace GfxQuadroSync
         // Register our request to use workstation SwapGroup resources in the driver
         NvU32 gpuCount;
         NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS];
-        NvAPI_Status status = NvAPI_EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
+        NvAPI_Status status = m_SwapGroupApi->EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
         if (NVAPI_OK == status)
         {
             for (unsigned int gpuIndex = 0; gpuIndex < gpuCount; gpuIndex++)
             {
                 // send request to enable NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP
-                status = NvAPI_GPU_WorkstationFeatureSetup(nvGPUHandle[gpuIndex], NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP, 0);
+                status = m_SwapGroupApi->SetupWorkstationSwapGroupFeature(nvGPUHandle[gpuIndex], true);
 
                 if (status == NvAPI_Status::NVAPI_OK)
-                    CLUSTER_LOG << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
+                    CLUSTER_LOG_DEBUG(NvApi) << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
                 else
-                    CLUSTER_LOG_ERROR << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
+                    CLUSTER_LOG_ERROR(NvApi) << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
             }
         }
     }
@@ -62,54 +63,69 @@ namespace GfxQuadroSync
         NvAPI_Status status;
         NvU32 gpuCount;
         NvPhysicalGpuHandle nvGPUHandle[NVAPI_MAX_PHYSICAL_GPUS];
-        status = NvAPI_EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
+        status = m_SwapGroupApi->EnumPhysicalGPUs(nvGPUHandle, &gpuCount);
         if (NVAPI_OK == status)
         {
             for (unsigned int gpuIndex = 0; gpuIndex < gpuCount; gpuIndex++)
             {
                 // send request to disable NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP
-                status = NvAPI_GPU_WorkstationFeatureSetup(nvGPUHandle[gpuIndex], 0, NVAPI_GPU_WORKSTATION_FEATURE_MASK_SWAPGROUP);
+                status = m_SwapGroupApi->SetupWorkstationSwapGroupFeature(nvGPUHandle[gpuIndex], false);
 
                 if (status == NvAPI_Status::NVAPI_OK)
-                    CLUSTER_LOG << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
+                    CLUSTER_LOG_DEBUG(NvApi) << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup successful";
                 else
-                    CLUSTER_LOG_ERROR << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
+                    CLUSTER_LOG_ERROR(NvApi) << "GPU " << gpuIndex << ": NvAPI_GPU_WorkstationFeatureSetup failed: " << status;
             }
         }
     }
 
     PluginCSwapGroupClient::InitializeStatus PluginCSwapGroupClient::Initialize(IUnknown* const pDevice,
                                                                                 IDXGISwapChain* const pSwapChain)
+    {
+        const auto initializeStatus = InitializeSwapGroupAndBarrier(pDevice, pSwapChain);
+        PublishFrameCountSnapshot(GetCurrentPerformanceCounterTick());
+        return initializeStatus;
+    }
+
+    PluginCSwapGroupClient::InitializeStatus PluginCSwapGroupClient::InitializeSwapGroupAndBarrier(
+        IUnknown* const pDevice, IDXGISwapChain* const pSwapChain)
     {
         auto status = NVAPI_OK;
 
-        status = NvAPI_D3D1x_QueryMaxSwapGroup(pDevice, &m_GSyncSwapGroups, &m_GSyncBarriers);
+        m_GroupId = GetSelectedSwapGroupId();
+        m_BarrierId = GetSelectedSwapBarrierId();
+
+        NvU32 maxSwapGroups = 0;
+        NvU32 maxSwapBarriers = 0;
+        status = m_SwapGroupApi->QueryMaxSwapGroup(pDevice, &maxSwapGroups, &maxSwapBarriers);
+        m_GSyncSwapGroups = maxSwapGroups;
+        m_GSyncBarriers = maxSwapBarriers;
 
         if (status == NvAPI_Status::NVAPI_OK)
-            CLUSTER_LOG << "NvAPI_D3D1x_QueryMaxSwapGroup successful";
+            CLUSTER_LOG_DEBUG(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup successful";
         else
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup failed: " << status;
+            CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup failed: " << status;
             return InitializeStatus::QuerySwapGroupFailed;
         }
 
-        if (m_GSyncSwapGroups > 0)
+        if (m_GSyncSwapGroups > 0 && m_GroupId <= m_GSyncSwapGroups)
         {
             if ((m_GroupId >= 0) && (m_GroupId <= m_GSyncSwapGroups))
             {
-                status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, m_GroupId, m_GroupId > 0 ? true : false);
+                status = m_SwapGroupApi->JoinSwapGroup(pDevice, pSwapChain, m_GroupId, m_GroupId > 0 ? true : false);
 
                 if (status == NvAPI_Status::NVAPI_OK)
                 {
-                    CLUSTER_LOG << "NvAPI_D3D1x_JoinSwapGroup returned NVAPI_OK";
+                    CLUSTER_LOG_DEBUG(NvApi) << "NvAPI_D3D1x_JoinSwapGroup returned NVAPI_OK";
                 }
                 else
                 {
-                    CLUSTER_LOG_ERROR << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
+                    CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
                 }
 
 #ifdef _DEBUG
-                CLUSTER_LOG << "SwapGroup (" << m_GroupId << ") / (" << m_GSyncSwapGroups << ")";
+                CLUSTER_LOG(Init) << "SwapGroup (" << m_GroupId << ") / (" << m_GSyncSwapGroups << ")";
 #endif
 
                 if (status != NVAPI_OK)
@@ -123,28 +139,37 @@ namespace GfxQuadroSync
                 NvU32 frameCount;
 
                 //! heavy
-                status = NvAPI_D3D1x_QueryFrameCount(pDevice, &frameCount);
+                status = m_SwapGroupApi->QueryFrameCount(pDevice, &frameCount);
 
                 m_GSyncCounter = (status == NVAPI_OK);
 
                 //! sync node
                 if (m_GSyncMaster && m_GSyncCounter)
                 {
-                    status = NvAPI_D3D1x_ResetFrameCount(pDevice);
+                    status = m_SwapGroupApi->ResetFrameCount(pDevice);
+                }
+                m_FrameCountService.Reset();
+
+                if (m_BarrierId > m_GSyncBarriers)
+                {
+                    CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup returned " << m_GSyncBarriers
+                                      << " barriers and m_BarrierId is " << m_BarrierId;
+                    m_BarrierId = 0;
+                    return InitializeStatus::SwapBarrierIdMismatch;
                 }
 
-                if ((m_BarrierId >= 0) && (m_BarrierId <= m_GSyncBarriers) &&
+                if ((m_BarrierId > 0) && (m_BarrierId <= m_GSyncBarriers) &&
                     (m_GroupId >= 0) && (m_GroupId <= m_GSyncSwapGroups))
                 {
-                    status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, m_BarrierId);
+                    status = m_SwapGroupApi->BindSwapBarrier(pDevice, m_GroupId, m_BarrierId);
 
                     if (status == NvAPI_Status::NVAPI_OK)
                     {
-                        CLUSTER_LOG << "NvAPI_D3D1x_BindSwapBarrier successful";
+                        CLUSTER_LOG_DEBUG(NvApi) << "NvAPI_D3D1x_BindSwapBarrier successful";
                     }
                     else
                     {
-                        CLUSTER_LOG_ERROR << "NvAPI_D3D1x_BindSwapBarrier failed: " << status;
+                        CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_BindSwapBarrier failed: " << status;
                     }
 
                     if (status != NVAPI_OK)
@@ -156,37 +181,37 @@ namespace GfxQuadroSync
             }
             else if (m_BarrierId > 0)
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 barriers";
+                CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 barriers";
                 m_BarrierId = 0;
                 return InitializeStatus::SwapBarrierIdMismatch;
             }
 
 #ifdef _DEBUG
-            CLUSTER_LOG << "BindSwapBarrier (" << m_BarrierId << ") / (" << m_GSyncBarriers << ")";
+            CLUSTER_LOG(Init) << "BindSwapBarrier (" << m_BarrierId << ") / (" << m_GSyncBarriers << ")";
 #endif
 
             NvU32 groupId;
             NvU32 barrierId;
-            status = NvAPI_D3D1x_QuerySwapGroup(pDevice, pSwapChain, &groupId, &barrierId);
+            status = m_SwapGroupApi->QuerySwapGroup(pDevice, pSwapChain, &groupId, &barrierId);
             m_GroupId = groupId;
             m_BarrierId = barrierId;
 
             if (status == NvAPI_Status::NVAPI_OK)
-                CLUSTER_LOG << "NvAPI_D3D1x_QuerySwapGroup successful";
+                CLUSTER_LOG_DEBUG(NvApi) << "NvAPI_D3D1x_QuerySwapGroup successful";
             else
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QuerySwapGroup failed: " << status;
+                CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QuerySwapGroup failed: " << status;
                 return InitializeStatus::QuerySwapGroupFailed;
             }
         }
         else if (m_GSyncSwapGroups == 0)
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 groups";
+            CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup returned 0 groups";
             return InitializeStatus::NoSwapGroupDetected;
         }
         else
         {
-            CLUSTER_LOG_ERROR << "NvAPI_D3D1x_QueryMaxSwapGroup returned " << m_GSyncSwapGroups
+            CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_QueryMaxSwapGroup returned " << m_GSyncSwapGroups
                               << " groups and m_GroupId is " << m_GroupId;
             m_GroupId = 0;
             return InitializeStatus::SwapGroupMismatch;
@@ -203,13 +228,13 @@ namespace GfxQuadroSync
         {
             if (m_BarrierId > 0)
             {
-                if (NVAPI_OK == (status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, 0)))
+                if (NVAPI_OK == (status = m_SwapGroupApi->BindSwapBarrier(pDevice, m_GroupId, 0)))
                 {
                     m_BarrierId = 0;
                 }
             }
 
-            if (NVAPI_OK == (status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, 0, 0)))
+            if (NVAPI_OK == (status = m_SwapGroupApi->JoinSwapGroup(pDevice, pSwapChain, 0, false)))
             {
                 m_GroupId = 0;
             }
@@ -217,46 +242,120 @@ namespace GfxQuadroSync
 
         m_PresentSuccessCount = 0;
         m_PresentFailureCount = 0;
+        PublishSnapshot();
     }
 
     NvU32 PluginCSwapGroupClient::QueryFrameCount(IUnknown* const pDevice)
     {
-        NvU32 count = 0;
-
         if (m_GSyncCounter)
         {
-            NvAPI_Status status;
-            if (NVAPI_OK == (status = NvAPI_D3D1x_QueryFrameCount(pDevice, &count)))
+            // Always the hardware value (never extrapolated): managed code compares it between the nodes of the
+            // cluster, and each node extrapolates from its own samples.  The sample still feeds m_FrameCountService
+            // so that GetSnapshot and GetFrameCount get a fresh base for their extrapolation.
+            const auto beforeTick = GetCurrentPerformanceCounterTick();
+            NvU32 count = 0;
+            const auto status = m_SwapGroupApi->QueryFrameCount(pDevice, &count);
+            if (status == NVAPI_OK)
             {
                 m_FrameCount = count;
+                m_FrameCountService.AddSample(beforeTick, GetCurrentPerformanceCounterTick(), count);
+                PublishFrameCountSnapshot(beforeTick);
+            }
+            else
+            {
+                m_FrameCountService.SampleFailed(beforeTick);
+                CLUSTER_LOGF_WARNING(NvApi, "NvAPI_D3D1x_QueryFrameCount failed: {}", status);
             }
         }
         else
         {
             ++m_FrameCount;
+            PublishFrameCountSnapshot(GetCurrentPerformanceCounterTick());
         }
 
         return m_FrameCount;
     }
 
+    FrameCountEstimate PluginCSwapGroupClient::QueryFrameCountEstimate(IUnknown* const pDevice)
+    {
+        // NvAPI_D3D1x_QueryFrameCount is a costly round trip to the driver, so only sample it when needed and
+        // extrapolate from the performance counter the rest of the time.
+        const auto nowTick = GetCurrentPerformanceCounterTick();
+        if (m_FrameCountService.ShouldSample(nowTick))
+        {
+            NvU32 count = 0;
+            const auto status = m_SwapGroupApi->QueryFrameCount(pDevice, &count);
+            if (status == NVAPI_OK)
+            {
+                m_FrameCountService.AddSample(nowTick, GetCurrentPerformanceCounterTick(), count);
+                PublishFrameCountSnapshot(nowTick);
+            }
+            else
+            {
+                m_FrameCountService.SampleFailed(nowTick);
+                CLUSTER_LOGF_WARNING(NvApi, "NvAPI_D3D1x_QueryFrameCount failed: {}", status);
+            }
+        }
+        return m_FrameCountService.Estimate(nowTick);
+    }
+
     void PluginCSwapGroupClient::ResetFrameCount(IUnknown* const pDevice)
     {
         if (m_GSyncMaster)
         {
-            auto status = NVAPI_OK;
-            status = NvAPI_D3D1x_ResetFrameCount(pDevice);
+            const auto status = m_SwapGroupApi->ResetFrameCount(pDevice);
+            if (status != NVAPI_OK)
+            {
+                CLUSTER_LOG_ERROR(NvApi) << "NvAPI_D3D1x_ResetFrameCount failed: " << status;
+            }
+            m_FrameCountService.Reset();
         }
         else
         {
             m_FrameCount = 0;
         }
+        PublishFrameCountSnapshot(GetCurrentPerformanceCounterTick());
+    }
+
+    void PluginCSwapGroupClient::PublishFrameCountSnapshot(const uint64_t nowTick)
+    {
+        PublishSnapshot([this, nowTick](SwapGroupSnapshot& snapshot)
+        {
+            constexpr auto hardwareCounterFlag = static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter);
+            if (m_GSyncCounter)
+            {
+                snapshot.flags |= hardwareCounterFlag;
+                snapshot.frameCount = 0;
+                snapshot.frameCountTick = 0;
+                snapshot.refreshPeriodTicks = 0;
+                const bool hasSample = m_FrameCountService.GetLastSample(snapshot.frameCountTick, snapshot.frameCount,
+                    snapshot.refreshPeriodTicks);
+                snapshot.frameCountConfidence = static_cast<uint32_t>(hasSample ? FrameCountConfidence::Sampled :
+                    FrameCountConfidence::None);
+            }
+            else
+            {
+                snapshot.flags &= ~hardwareCounterFlag;
+                snapshot.frameCount = m_FrameCount;
+                snapshot.frameCountTick = nowTick;
+                snapshot.refreshPeriodTicks = 0;
+                snapshot.frameCountConfidence = static_cast<uint32_t>(FrameCountConfidence::Sampled);
+            }
+        });
     }
 
     bool PluginCSwapGroupClient::Render(IGraphicsDevice* pGraphicsDevice)
     {
-        if (m_SkipSynchronizedPresentOfNextFrame)
+        if (m_SkipSynchronizedPresentOfNextFrame.load(std::memory_order_relaxed) &&
+            m_SkipSynchronizedPresentOfNextFrame.exchange(false, std::memory_order_relaxed))
+        {
+            RecordSkippedPresent();
+            return false;
+        }
+
+        if (m_NeedDeviceRecovery)
         {
-            m_SkipSynchronizedPresentOfNextFrame = false;
+            // Presenting through NvAPI is pointless until RecoverDevice joined the swap group again.
             return false;
         }
 
@@ -265,33 +364,91 @@ namespace GfxQuadroSync
         const auto pVsync = pGraphicsDevice->GetSyncInterval();
         const auto pFlags = pGraphicsDevice->GetPresentFlags();
 
+        const bool useBarrierWarmupPolicy = m_NeedToWarmUpBarrier &&
+            (m_UseBarrierWarmupPolicy.load(std::memory_order_acquire) || (m_AutomaticBarrierWarmup &&
+            m_BarrierWarmupCallback == &EmptyBarrierWarmupCallback &&
+            !m_UseBarrierWarmupActionSlot.load(std::memory_order_relaxed)));
+        const bool useBarrierWarmupActionSlot = m_NeedToWarmUpBarrier && !useBarrierWarmupPolicy &&
+            m_UseBarrierWarmupActionSlot.load(std::memory_order_relaxed);
         if (m_NeedToWarmUpBarrier)
         {
-            pGraphicsDevice->InitiatePresentRepeats();
+            if (!m_PresentRepeatsInitiated)
+            {
+                pGraphicsDevice->InitiatePresentRepeats();
+                m_PresentRepeatsInitiated = true;
+            }
+            if (useBarrierWarmupPolicy)
+            {
+                m_BarrierWarmupPolicy.Start(m_BarrierWarmupSettings.Read());
+                m_BarrierWarmupReport.Update([this](BarrierWarmupReport& report)
+                {
+                    report = m_BarrierWarmupPolicy.GetReport();
+                });
+            }
         }
 
+        bool isRepeatedPresent = false;
         for (;;)
         {
-            auto result = NvAPI_D3D1x_Present(pDevice, pSwapChain, pVsync, pFlags);
+            PresentTiming presentTiming;
+            if (m_NeedToWarmUpBarrier)
+            {
+                presentTiming.flags = static_cast<uint32_t>(isRepeatedPresent ?
+                    PresentTimingFlags::BarrierWarmup | PresentTimingFlags::RepeatedPresent :
+                    PresentTimingFlags::BarrierWarmup);
+            }
+            presentTiming.presentStartTick = GetCurrentPerformanceCounterTick();
+            m_StallWatchdog.PresentStarted(presentTiming.presentStartTick);
+            auto result = m_SwapGroupApi->Present(pDevice, pSwapChain, pVsync, pFlags);
+            presentTiming.presentEndTick = GetCurrentPerformanceCounterTick();
+            if (m_StallWatchdog.PresentEnded(presentTiming.presentEndTick))
+            {
+                presentTiming.flags |= static_cast<uint32_t>(PresentTimingFlags::Stalled);
+            }
+            presentTiming.status = result;
+            m_PresentTimings.Push(presentTiming);
+            PublishSnapshot([&presentTiming](SwapGroupSnapshot& snapshot)
+            {
+                ++snapshot.presentCount;
+                snapshot.lastPresentEndTick = presentTiming.presentEndTick;
+                snapshot.lastPresentStatus = presentTiming.status;
+                snapshot.flags |= static_cast<uint32_t>(SwapGroupSnapshotFlags::HasPresented);
+            });
+
             if (result != NVAPI_OK)
             {
                 m_PresentFailureCount.fetch_add(1, std::memory_order_relaxed);
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_Present failed: " << result;
+                CLUSTER_LOGF_ERROR(Present, "NvAPI_D3D1x_Present failed: {}", result);
+                OnPresentFailed(pGraphicsDevice, result, presentTiming.presentEndTick);
                 return false;
             }
+            if (m_DeviceRecovery.GetReport().consecutiveFailures > 0)
+            {
+                m_DeviceRecovery.OnPresentSucceeded();
+                PublishDeviceRecoveryReport();
+            }
 
             if (m_NeedToWarmUpBarrier)
             {
-                const auto barrierWarmupAction = m_BarrierWarmupCallback();
+                m_BarrierWarmupPresentSequence.fetch_add(1, std::memory_order_release);
+                const auto barrierWarmupAction = useBarrierWarmupPolicy ?
+                    ApplyBarrierWarmupPolicy(pDevice, presentTiming.presentEndTick) :
+                    useBarrierWarmupActionSlot ? TakePostedBarrierWarmupAction() : m_BarrierWarmupCallback();
                 if (barrierWarmupAction == BarrierWarmupAction::RepeatPresent)
                 {
                     pGraphicsDevice->PrepareSinglePresentRepeat();
+                    isRepeatedPresent = true;
                     continue;
                 }
                 if (barrierWarmupAction == BarrierWarmupAction::BarrierWarmedUp)
                 {
                     pGraphicsDevice->ConcludePresentRepeats();
+                    m_PresentRepeatsInitiated = false;
                     m_NeedToWarmUpBarrier = false;
+                    CLUSTER_LOGF(Warmup, "Swap barrier warmed up");
+                    m_AutomaticBarrierWarmup = false;
+                    SwapChainResynchronized();
+                    DeviceRecovered();
                 }
             }
             break;
@@ -301,82 +458,539 @@ namespace GfxQuadroSync
         return true;
     }
 
-    void PluginCSwapGroupClient::EnableSystem(IUnknown* const pDevice,
-        IDXGISwapChain* const pSwapChain,
-        const bool value)
+    void PluginCSwapGroupClient::EnableStallWatchdog(const uint32_t thresholdMs, const bool skipSynchronizationOnStall,
+        PresentWatchdog::StallCallback stallCallback)
     {
-        m_IsActive = value;
-        EnableSwapGroup(pDevice, pSwapChain, value);
-        EnableSwapBarrier(pDevice, value);
+        if (skipSynchronizationOnStall)
+        {
+            stallCallback = [this, stallCallback = std::move(stallCallback)]
+            {
+                SkipSynchronizedPresentOfNextFrame();
+                if (stallCallback)
+                {
+                    stallCallback();
+                }
+            };
+        }
+        m_StallWatchdog.Start(thresholdMs, std::move(stallCallback));
+        CLUSTER_LOGF(Present, "Present stall watchdog threshold: {} ms (skip synchronization on stall: {})",
+            thresholdMs, skipSynchronizationOnStall);
     }
 
-    void PluginCSwapGroupClient::EnableSwapGroup(IUnknown* const pDevice,
-                                                 IDXGISwapChain* const pSwapChain,
-                                                 const bool value)
+    void PluginCSwapGroupClient::SetBarrierWarmupPolicy(const BarrierWarmupPolicy::Settings* const settings)
     {
-        const NvU32 newSwapGroup = (value) ? 1 : 0;
-        CLUSTER_LOG << "EnableSwapGroup: (" << (value ? "true" : "false") << ", newSwapGroup ID is " << newSwapGroup;
+        if (settings)
+        {
+            m_BarrierWarmupSettings.Update([settings](BarrierWarmupPolicy::Settings& value) { value = *settings; });
+            CLUSTER_LOGF(Warmup, "Barrier warmup policy: {} stable presents (tolerances: {} interval, {} frames), "
+                "give up after {} presents", settings->stablePresents, settings->intervalTolerance,
+                settings->frameCountTolerance, settings->maxPresents);
+        }
+        else
+        {
+            CLUSTER_LOGF(Warmup, "Barrier warmup decided by the callback");
+        }
+        m_UseBarrierWarmupPolicy.store(settings != nullptr, std::memory_order_release);
+    }
+
+    void PluginCSwapGroupClient::SetBarrierWarmupActionSlotEnabled(const bool enabled)
+    {
+        CLUSTER_LOGF(Warmup, "Barrier warmup decided by the {}", enabled ? "action slot" : "callback");
+        m_UseBarrierWarmupActionSlot.store(enabled, std::memory_order_relaxed);
+    }
 
-        if ((newSwapGroup != m_GroupId) && (newSwapGroup <= m_GSyncSwapGroups))
+    void PluginCSwapGroupClient::PostBarrierWarmupAction(const BarrierWarmupAction action)
+    {
+        m_PostedBarrierWarmupAction.store(static_cast<uint32_t>(action) + 1, std::memory_order_release);
+    }
+
+    PluginCSwapGroupClient::BarrierWarmupAction PluginCSwapGroupClient::TakePostedBarrierWarmupAction()
+    {
+        auto posted = m_PostedBarrierWarmupAction.load(std::memory_order_acquire);
+        if (posted == 0)
         {
-            const auto status = NvAPI_D3D1x_JoinSwapGroup(pDevice, pSwapChain, newSwapGroup, (newSwapGroup > 0));
+            return BarrierWarmupAction::ContinueToNextFrame;
+        }
 
-            if (status == NvAPI_Status::NVAPI_OK)
+        const auto action = static_cast<BarrierWarmupAction>(posted - 1);
+        if (action == BarrierWarmupAction::BarrierWarmedUp)
+        {
+            // Unless something else was posted in the meantime (that is then for the next warmup)
+            m_PostedBarrierWarmupAction.compare_exchange_strong(posted, 0, std::memory_order_relaxed);
+        }
+        return action;
+    }
+
+    PluginCSwapGroupClient::BarrierWarmupAction PluginCSwapGroupClient::ApplyBarrierWarmupPolicy(
+        IUnknown* const pDevice, const uint64_t presentEndTick)
+    {
+        // Sampled after every present (not through m_FrameCountService) as the policy needs every frame.
+        NvU32 frameCount = 0;
+        const bool hasFrameCount = m_GSyncCounter && m_SwapGroupApi->QueryFrameCount(pDevice, &frameCount) == NVAPI_OK;
+        const auto decision = m_BarrierWarmupPolicy.OnPresent(presentEndTick, hasFrameCount, frameCount);
+        const auto& report = m_BarrierWarmupPolicy.GetReport();
+        m_BarrierWarmupReport.Update([&report](BarrierWarmupReport& value) { value = report; });
+
+        switch (decision)
+        {
+        case BarrierWarmupPolicy::Decision::RepeatPresent:
+            return BarrierWarmupAction::RepeatPresent;
+        case BarrierWarmupPolicy::Decision::Converged:
+            CLUSTER_LOGF(Warmup, "Barrier warmup converged after {} presents", report.presentCount);
+            break;
+        case BarrierWarmupPolicy::Decision::GaveUp:
+            CLUSTER_LOGF_WARNING(Warmup, "Barrier warmup gave up after {} presents ({} stable)", report.presentCount,
+                report.stablePresentCount);
+            break;
+        }
+        return BarrierWarmupAction::BarrierWarmedUp;
+    }
+
+    void PluginCSwapGroupClient::RecordSkippedPresent()
+    {
+        PresentTiming presentTiming;
+        presentTiming.presentStartTick = GetCurrentPerformanceCounterTick();
+        presentTiming.presentEndTick = presentTiming.presentStartTick;
+        presentTiming.status = NVAPI_OK;
+        presentTiming.flags = static_cast<uint32_t>(PresentTimingFlags::SkippedSynchronization);
+        m_PresentTimings.Push(presentTiming);
+    }
+
+    uint32_t PluginCSwapGroupClient::PostConfigurationChange(const ConfigurationSetting setting, const bool value)
+    {
+        auto changes = ConfigurationMailbox::Change(static_cast<uint32_t>(setting), value);
+        if (setting == ConfigurationSetting::System)
+        {
+            // Supersedes any pending change of the swap group or barrier, as EnableSystem does.
+            changes |= ConfigurationMailbox::Change(static_cast<uint32_t>(ConfigurationSetting::SwapGroup), value) |
+                ConfigurationMailbox::Change(static_cast<uint32_t>(ConfigurationSetting::SwapBarrier), value);
+        }
+        return m_ConfigurationMailbox.Post(changes);
+    }
+
+    bool PluginCSwapGroupClient::ApplyPendingConfiguration(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain)
+    {
+        if (!m_ConfigurationMailbox.HasPending())
+        {
+            return false;
+        }
+
+        uint32_t epoch;
+        const auto changes = m_ConfigurationMailbox.Take(epoch);
+        auto target = GetConfiguration();
+        bool membershipChanged = false;
+        bool value;
+        // Slot of System only carries m_IsActive, its swap group and barrier changes are in their own slots.
+        if (ConfigurationMailbox::GetChange(changes, static_cast<uint32_t>(ConfigurationSetting::System), value))
+        {
+            m_IsActive = value;
+        }
+        if (ConfigurationMailbox::GetChange(changes, static_cast<uint32_t>(ConfigurationSetting::SwapGroup), value))
+        {
+            target.swapGroupId = value ? GetEnabledSwapGroupId() : 0;
+            membershipChanged = true;
+        }
+        if (ConfigurationMailbox::GetChange(changes, static_cast<uint32_t>(ConfigurationSetting::SwapBarrier), value))
+        {
+            target.swapBarrierId = value ? GetEnabledSwapBarrierId() : 0;
+            membershipChanged = true;
+        }
+        if (ConfigurationMailbox::GetChange(changes, static_cast<uint32_t>(ConfigurationSetting::SyncCounter), value))
+        {
+            target.hardwareFrameCounter = value;
+        }
+        if (target.swapGroupId == 0)
+        {
+            // A swap barrier cannot be bound without a swap group
+            target.swapBarrierId = 0;
+        }
+        if (membershipChanged)
+        {
+            Reconfigure(pDevice, pSwapChain, target);
+        }
+        else
+        {
+            // Nothing to ask the driver (Reconfigure would still query the swap group membership).
+            m_GSyncCounter = target.hardwareFrameCounter;
+            PublishFrameCountSnapshot(GetCurrentPerformanceCounterTick());
+        }
+
+        m_ConfigurationMailbox.SetAppliedEpoch(epoch);
+        CLUSTER_LOGF(Init, "Configuration changes up to epoch {} applied", epoch);
+        return true;
+    }
+
+    SwapChainChange PluginCSwapGroupClient::OnSwapChainChanged(IGraphicsDevice* const pGraphicsDevice,
+        const SwapChainIdentity& identity)
+    {
+        const auto change = m_SwapChainMonitor.Observe(identity, GetCurrentPerformanceCounterTick());
+        if (change == SwapChainChange::None)
+        {
+            return change;
+        }
+
+        if (m_PresentRepeatsInitiated)
+        {
+            // Saved frame was presented through the previous swap chain, the next warmup present saves a new one.
+            pGraphicsDevice->ConcludePresentRepeats();
+            m_PresentRepeatsInitiated = false;
+        }
+        if ((static_cast<uint32_t>(change) & static_cast<uint32_t>(SwapChainChange::Recreated)) != 0)
+        {
+            pGraphicsDevice->SetSwapChain(identity.swapChain);
+        }
+
+        // The membership of the new (or resized) swap chain is queried, so only what was lost is joined or bound again.
+        const auto target = GetConfiguration();
+        CLUSTER_LOGF(Device, "Swap chain {} ({}x{}), rejoining swap group {} / barrier {}",
+            (static_cast<uint32_t>(change) & static_cast<uint32_t>(SwapChainChange::Recreated)) != 0 ? "recreated" :
+            "resized", identity.width, identity.height, target.swapGroupId, target.swapBarrierId);
+        const bool neededToWarmUpBarrier = m_NeedToWarmUpBarrier;
+        auto status = ReconfigureStatus::Success;
+        if (target.swapGroupId != 0)
+        {
+            status = Reconfigure(pGraphicsDevice->GetDevice(), pGraphicsDevice->GetSwapChain(), target);
+        }
+        m_SwapChainMonitor.SetRejoinStatus(static_cast<uint32_t>(status));
+        m_AutomaticBarrierWarmup = m_AutomaticBarrierWarmup || (!neededToWarmUpBarrier && m_NeedToWarmUpBarrier);
+
+        if (status != ReconfigureStatus::Success)
+        {
+            CLUSTER_LOGF_ERROR(Device, "Failed to rejoin the swap group after the swap chain change: {}", status);
+        }
+        else if (!m_NeedToWarmUpBarrier)
+        {
+            SwapChainResynchronized();
+        }
+        m_SwapChainChangeReport.Update([this](SwapChainChangeReport& report)
+        {
+            report = m_SwapChainMonitor.GetReport();
+        });
+        return change;
+    }
+
+    void PluginCSwapGroupClient::SwapChainResynchronized()
+    {
+        if (!m_SwapChainMonitor.IsOutOfSync())
+        {
+            return;
+        }
+
+        m_SwapChainMonitor.Resynchronized(GetCurrentPerformanceCounterTick());
+        const auto& report = m_SwapChainMonitor.GetReport();
+        m_SwapChainChangeReport.Update([&report](SwapChainChangeReport& value) { value = report; });
+        CLUSTER_LOGF(Device, "Synchronized again {} ms after the swap chain change",
+            static_cast<double>(report.lastOutOfSyncTicks) * 1000.0 / GetPerformanceCounterFrequency());
+    }
+
+    void PluginCSwapGroupClient::OnPresentFailed(IGraphicsDevice* const pGraphicsDevice, const NvAPI_Status status,
+        const uint64_t tick)
+    {
+        const auto deviceRemovedReason = pGraphicsDevice->GetDeviceRemovedReason();
+        const bool wasRecovering = m_DeviceRecovery.IsRecovering();
+        if (m_DeviceRecovery.OnPresentFailed(status, deviceRemovedReason, tick))
+        {
+            StartDeviceRecovery(pGraphicsDevice, wasRecovering);
+            CLUSTER_LOGF_WARNING(Device, "Present failed with {} (device removed reason: {}), swap group {} / barrier "
+                "{} will be joined again once the device is usable", status, LogHResult(deviceRemovedReason),
+                m_DeviceRecoveryTarget.swapGroupId, m_DeviceRecoveryTarget.swapBarrierId);
+        }
+        else if (m_DeviceRecovery.MembershipCheckDue())
+        {
+            // Failing barriers are most likely caused by another node of the cluster, only a lost membership is
+            // something joining the swap group again would fix.
+            NvU32 groupId = 0;
+            NvU32 barrierId = 0;
+            const auto queryStatus = m_SwapGroupApi->QuerySwapGroup(pGraphicsDevice->GetDevice(),
+                pGraphicsDevice->GetSwapChain(), &groupId, &barrierId);
+            if (queryStatus == NVAPI_OK && (groupId != m_GroupId || barrierId != m_BarrierId))
             {
-                CLUSTER_LOG << "NvAPI_D3D1x_JoinSwapGroup returned NVAPI_OK";
-                m_GroupId = newSwapGroup;
+                m_DeviceRecovery.MembershipLost(tick);
+                StartDeviceRecovery(pGraphicsDevice, wasRecovering);
+                CLUSTER_LOGF_WARNING(Device, "Presents keep failing with {} and the swap chain is in swap group {} / "
+                    "barrier {}, swap group {} / barrier {} will be joined again", status, groupId, barrierId,
+                    m_DeviceRecoveryTarget.swapGroupId, m_DeviceRecoveryTarget.swapBarrierId);
             }
             else
             {
-                CLUSTER_LOG_ERROR << "NvAPI_D3D1x_JoinSwapGroup failed: " << status;
+                CLUSTER_LOGF_WARNING(Device, "{} presents failed in a row (last one with {}), still in swap group {} / "
+                    "barrier {}", m_DeviceRecovery.GetReport().consecutiveFailures, status, m_GroupId.load(),
+                    m_BarrierId.load());
+            }
+        }
+        PublishDeviceRecoveryReport();
+    }
 
-#ifdef _DEBUG
-                CLUSTER_LOG << "Values before Query: m_GroupeId(" << m_GroupId << "), m_BarrierId (" << m_BarrierId << ")";
+    void PluginCSwapGroupClient::StartDeviceRecovery(IGraphicsDevice* const pGraphicsDevice, const bool wasRecovering)
+    {
+        if (!wasRecovering)
+        {
+            m_DeviceRecoveryTarget = GetConfiguration();
+        }
+        if (m_PresentRepeatsInitiated)
+        {
+            // Saved frame belongs to the device (or swap chain) that failed.
+            pGraphicsDevice->ConcludePresentRepeats();
+            m_PresentRepeatsInitiated = false;
+        }
+        m_NextRejoinAttemptTick = 0;
+        m_NeedDeviceRecovery = true;
+    }
 
-                NvU32 groupId;
-                NvU32 barrierId;
-                NvAPI_D3D1x_QuerySwapGroup(pDevice, pSwapChain, &groupId, &barrierId);
-                m_GroupId = groupId;
-                m_BarrierId = barrierId;
+    bool PluginCSwapGroupClient::RecoverDevice(IGraphicsDevice* const pGraphicsDevice)
+    {
+        if (!m_NeedDeviceRecovery)
+        {
+            return true;
+        }
+        // Unity did not create a new device yet
+        if (pGraphicsDevice->GetDeviceRemovedReason() != 0)
+        {
+            return false;
+        }
+        const auto now = GetCurrentPerformanceCounterTick();
+        if (now < m_NextRejoinAttemptTick)
+        {
+            return false;
+        }
 
-                CLUSTER_LOG << "Values after Query m_GroupeId(" << m_GroupId << "), m_BarrierId (" << m_BarrierId << ")";
-#endif
-            }
+        // Membership of the new device's swap chain is queried, so only what was lost is joined or bound again.
+        const bool neededToWarmUpBarrier = m_NeedToWarmUpBarrier;
+        auto status = ReconfigureStatus::Success;
+        if (m_DeviceRecoveryTarget.swapGroupId != 0)
+        {
+            status = Reconfigure(pGraphicsDevice->GetDevice(), pGraphicsDevice->GetSwapChain(),
+                m_DeviceRecoveryTarget);
+        }
+        if (status != ReconfigureStatus::Success)
+        {
+            m_NextRejoinAttemptTick = now + GetPerformanceCounterFrequency() * k_RejoinRetryIntervalMs / 1000;
+            CLUSTER_LOGF_ERROR(Device, "Failed to join the swap group again after failed presents: {}", status);
+            return false;
+        }
+
+        m_NeedDeviceRecovery = false;
+        m_DeviceRecovery.Rejoined();
+        m_AutomaticBarrierWarmup = m_AutomaticBarrierWarmup || (!neededToWarmUpBarrier && m_NeedToWarmUpBarrier);
+        if (m_NeedToWarmUpBarrier)
+        {
+            CLUSTER_LOGF(Device, "Swap group {} / barrier {} joined again, warming up the barrier",
+                m_DeviceRecoveryTarget.swapGroupId, m_DeviceRecoveryTarget.swapBarrierId);
+            PublishDeviceRecoveryReport();
+        }
+        else
+        {
+            DeviceRecovered();
         }
+        return true;
     }
 
-    void PluginCSwapGroupClient::EnableSwapBarrier(IUnknown* const pDevice, const bool value)
+    void PluginCSwapGroupClient::DeviceRecovered()
     {
-        if (m_GroupId == 1)
+        if (!m_DeviceRecovery.IsRecovering())
         {
-            const NvU32 newSwapBarrier = (value) ? 1 : 0;
-            CLUSTER_LOG << "EnableSwapBarrier: " << (value ? "true" : "false") << ", newSwapBarrier ID is " << newSwapBarrier;
+            return;
+        }
+
+        m_DeviceRecovery.Recovered(GetCurrentPerformanceCounterTick());
+        PublishDeviceRecoveryReport();
+        CLUSTER_LOGF(Device, "Recovered from failed presents in {} ms",
+            static_cast<double>(m_DeviceRecovery.GetReport().lastRecoveryTicks) * 1000.0 /
+            GetPerformanceCounterFrequency());
+    }
+
+    void PluginCSwapGroupClient::PublishDeviceRecoveryReport()
+    {
+        const auto& report = m_DeviceRecovery.GetReport();
+        m_DeviceRecoveryReport.Update([&report](DeviceRecoveryReport& value) { value = report; });
+    }
 
-            if ((newSwapBarrier != m_BarrierId) && (newSwapBarrier <= m_GSyncBarriers))
+    SwapGroupConfiguration PluginCSwapGroupClient::GetConfiguration() const
+    {
+        SwapGroupConfiguration configuration;
+        configuration.swapGroupId = m_GroupId;
+        configuration.swapBarrierId = m_BarrierId;
+        configuration.hardwareFrameCounter = m_GSyncCounter;
+        return configuration;
+    }
+
+    PluginCSwapGroupClient::ReconfigureStatus PluginCSwapGroupClient::Reconfigure(IUnknown* const pDevice,
+        IDXGISwapChain* const pSwapChain, const SwapGroupConfiguration& target)
+    {
+        if (target.swapGroupId > m_GSyncSwapGroups || target.swapBarrierId > m_GSyncBarriers ||
+            (target.swapGroupId == 0 && target.swapBarrierId != 0))
+        {
+            CLUSTER_LOGF_ERROR(Init, "Reconfigure, invalid swap group {} / barrier {} (maximum {} / {})",
+                target.swapGroupId, target.swapBarrierId, m_GSyncSwapGroups.load(), m_GSyncBarriers.load());
+            return ReconfigureStatus::InvalidConfiguration;
+        }
+
+        // Start from the membership confirmed by the driver, not from the one we think we have.
+        NvU32 liveGroupId = 0;
+        NvU32 liveBarrierId = 0;
+        uint32_t driverCalls = 1;
+        const auto queryStatus = m_SwapGroupApi->QuerySwapGroup(pDevice, pSwapChain, &liveGroupId, &liveBarrierId);
+        if (queryStatus != NVAPI_OK)
+        {
+            CLUSTER_LOGF_WARNING(NvApi, "NvAPI_D3D1x_QuerySwapGroup failed: {}, reconfiguring from the last known "
+                "membership", queryStatus);
+            liveGroupId = m_GroupId;
+            liveBarrierId = m_BarrierId;
+        }
+
+        // Swap barriers are bound to a swap group, so the barrier has to be unbound before changing swap group and
+        // bound once the swap group is joined.
+        auto status = ReconfigureStatus::Success;
+        NvU32 groupId = liveGroupId;
+        NvU32 barrierId = liveBarrierId;
+        bool boundBarrier = false;
+        const bool changeGroup = target.swapGroupId != groupId;
+        if (barrierId != 0 && (changeGroup || target.swapBarrierId != barrierId))
+        {
+            ++driverCalls;
+            const auto nvStatus = m_SwapGroupApi->BindSwapBarrier(pDevice, groupId, 0);
+            if (nvStatus == NVAPI_OK)
+            {
+                barrierId = 0;
+            }
+            else
+            {
+                CLUSTER_LOGF_ERROR(NvApi, "NvAPI_D3D1x_BindSwapBarrier failed to unbind barrier: {}", nvStatus);
+                status = ReconfigureStatus::FailedToBindSwapBarrier;
+            }
+        }
+        if (status == ReconfigureStatus::Success && changeGroup)
+        {
+            ++driverCalls;
+            const auto nvStatus = m_SwapGroupApi->JoinSwapGroup(pDevice, pSwapChain, target.swapGroupId,
+                target.swapGroupId > 0);
+            if (nvStatus == NVAPI_OK)
+            {
+                groupId = target.swapGroupId;
+            }
+            else
+            {
+                CLUSTER_LOGF_ERROR(NvApi, "NvAPI_D3D1x_JoinSwapGroup failed: {}", nvStatus);
+                status = ReconfigureStatus::FailedToJoinSwapGroup;
+            }
+        }
+        if (status == ReconfigureStatus::Success && target.swapBarrierId != barrierId)
+        {
+            ++driverCalls;
+            const auto nvStatus = m_SwapGroupApi->BindSwapBarrier(pDevice, groupId, target.swapBarrierId);
+            if (nvStatus == NVAPI_OK)
+            {
+                barrierId = target.swapBarrierId;
+                boundBarrier = true;
+            }
+            else
             {
-                const auto status = NvAPI_D3D1x_BindSwapBarrier(pDevice, m_GroupId, newSwapBarrier);
+                CLUSTER_LOGF_ERROR(NvApi, "NvAPI_D3D1x_BindSwapBarrier failed: {}", nvStatus);
+                status = ReconfigureStatus::FailedToBindSwapBarrier;
+            }
+        }
 
-                if (status == NvAPI_Status::NVAPI_OK)
+        if (status != ReconfigureStatus::Success)
+        {
+            // Undo, in reverse order, what was done
+            if (groupId != liveGroupId)
+            {
+                ++driverCalls;
+                if (m_SwapGroupApi->JoinSwapGroup(pDevice, pSwapChain, liveGroupId, liveGroupId > 0) == NVAPI_OK)
                 {
-                    CLUSTER_LOG << "NvAPI_D3D1x_BindSwapBarrier returned NVAPI_OK";
-                    m_BarrierId = newSwapBarrier;
+                    groupId = liveGroupId;
                 }
-                else
+            }
+            if (barrierId != liveBarrierId && groupId == liveGroupId)
+            {
+                ++driverCalls;
+                if (m_SwapGroupApi->BindSwapBarrier(pDevice, groupId, liveBarrierId) == NVAPI_OK)
                 {
-                    CLUSTER_LOG_ERROR << "NvAPI_D3D1x_BindSwapBarrier failed: " << status;
+                    barrierId = liveBarrierId;
+                    boundBarrier = liveBarrierId != 0;
                 }
             }
-            CLUSTER_LOG << "EnableSwapBarrier: already set, nothing has been called";
+            if (groupId != liveGroupId || barrierId != liveBarrierId)
+            {
+                CLUSTER_LOGF_ERROR(Init, "Reconfigure, failed to restore swap group {} / barrier {}", liveGroupId,
+                    liveBarrierId);
+                status = ReconfigureStatus::RollbackFailed;
+            }
         }
         else
         {
-            CLUSTER_LOG << "EnableSwapBarrier: (NULL), m_GroupId is different than 1";
+            m_GSyncCounter = target.hardwareFrameCounter;
+        }
+
+        // Only a newly bound barrier needs to be warmed up (including the one bound again by the rollback).
+        if (boundBarrier)
+        {
+            m_NeedToWarmUpBarrier = true;
+        }
+
+        m_GroupId = groupId;
+        m_BarrierId = barrierId;
+        PublishFrameCountSnapshot(GetCurrentPerformanceCounterTick());
+        CLUSTER_LOGF(Init, "Reconfigured to swap group {} / barrier {} with {} driver calls (status {})", groupId,
+            barrierId, driverCalls, status);
+        return status;
+    }
+
+    bool PluginCSwapGroupClient::SetSwapGroupIds(const NvU32 swapGroupId, const NvU32 swapBarrierId)
+    {
+        // Maximums are 0 until initialized, ids are then validated by Initialize.
+        const NvU32 maxSwapGroups = m_GSyncSwapGroups;
+        const NvU32 maxSwapBarriers = m_GSyncBarriers;
+        if (swapGroupId == 0 || swapGroupId > 0xFFFF || swapBarrierId > 0xFFFF ||
+            (maxSwapGroups > 0 && (swapGroupId > maxSwapGroups || swapBarrierId > maxSwapBarriers)))
+        {
+            CLUSTER_LOGF_ERROR(Init, "SetSwapGroupIds, invalid swap group {} / barrier {} (maximum {} / {})",
+                swapGroupId, swapBarrierId, maxSwapGroups, maxSwapBarriers);
+            return false;
+        }
+
+        CLUSTER_LOGF(Init, "SetSwapGroupIds: swap group {} / barrier {}", swapGroupId, swapBarrierId);
+        m_SelectedIds = swapGroupId | (swapBarrierId << 16);
+        return true;
+    }
+
+    void PluginCSwapGroupClient::EnableSystem(IUnknown* const pDevice,
+        IDXGISwapChain* const pSwapChain,
+        const bool value)
+    {
+        m_IsActive = value;
+        auto target = GetConfiguration();
+        target.swapGroupId = value ? GetEnabledSwapGroupId() : 0;
+        target.swapBarrierId = value && target.swapGroupId > 0 ? GetEnabledSwapBarrierId() : 0;
+        Reconfigure(pDevice, pSwapChain, target);
+    }
+
+    void PluginCSwapGroupClient::EnableSwapGroup(IUnknown* const pDevice,
+                                                 IDXGISwapChain* const pSwapChain,
+                                                 const bool value)
+    {
+        CLUSTER_LOGF(Init, "EnableSwapGroup: {}", value);
+        auto target = GetConfiguration();
+        target.swapGroupId = value ? GetEnabledSwapGroupId() : 0;
+        if (target.swapGroupId == 0)
+        {
+            target.swapBarrierId = 0;
         }
-        m_NeedToWarmUpBarrier = true;
+        Reconfigure(pDevice, pSwapChain, target);
     }
 
-    void PluginCSwapGroupClient::EnableSyncCounter(const bool value)
+    void PluginCSwapGroupClient::EnableSwapBarrier(IUnknown* const pDevice, IDXGISwapChain* const pSwapChain,
+                                                   const bool value)
     {
-        m_GSyncCounter = value;
+        if (m_GroupId == 0)
+        {
+            CLUSTER_LOG(Init) << "EnableSwapBarrier: (NULL), no swap group joined";
+            return;
+        }
+
+        CLUSTER_LOGF(Init, "EnableSwapBarrier: {}", value);
+        auto target = GetConfiguration();
+        target.swapBarrierId = value ? GetEnabledSwapBarrierId() : 0;
+        Reconfigure(pDevice, pSwapChain, target);
     }
 }
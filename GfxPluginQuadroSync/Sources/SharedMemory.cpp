@@ -0,0 +1,137 @@
+#include "SharedMemory.h"
+#include "Logger.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    SharedMemory::~SharedMemory()
+    {
+        Close();
+    }
+
+    bool SharedMemory::Create(const std::string& name, const size_t size)
+    {
+        return Map(name, size, true);
+    }
+
+    bool SharedMemory::OpenReadOnly(const std::string& name, const size_t size)
+    {
+        return Map(name, size, false);
+    }
+
+#ifdef _WIN32
+    bool SharedMemory::Map(const std::string& name, const size_t size, const bool create)
+    {
+        Close();
+
+        const auto nameLength = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, nullptr, 0);
+        std::wstring wideName(nameLength > 0 ? nameLength : 1, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, wideName.data(), nameLength);
+
+        const auto mappingHandle = create ?
+            CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(size) >> 32),
+                static_cast<DWORD>(size & 0xFFFFFFFF), wideName.c_str()) :
+            OpenFileMappingW(FILE_MAP_READ, FALSE, wideName.c_str());
+        if (mappingHandle == nullptr)
+        {
+            CLUSTER_LOG_ERROR(Init) << "Failed to " << (create ? "create" : "open") << " shared memory " << name
+                << ": " << GetLastError();
+            return false;
+        }
+
+        const auto data = MapViewOfFile(mappingHandle, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+        if (data == nullptr)
+        {
+            CLUSTER_LOG_ERROR(Init) << "Failed to map shared memory " << name << ": " << GetLastError();
+            CloseHandle(mappingHandle);
+            return false;
+        }
+
+        m_MappingHandle = mappingHandle;
+        m_Data = data;
+        m_Size = size;
+        return true;
+    }
+
+    void SharedMemory::Close()
+    {
+        if (m_Data != nullptr)
+        {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+            m_Size = 0;
+        }
+        if (m_MappingHandle != nullptr)
+        {
+            CloseHandle(m_MappingHandle);
+            m_MappingHandle = nullptr;
+        }
+    }
+#else
+    bool SharedMemory::Map(const std::string& name, const size_t size, const bool create)
+    {
+        Close();
+
+        const auto posixName = (name.empty() || name[0] != '/') ? "/" + name : name;
+        const auto fd = shm_open(posixName.c_str(), create ? (O_CREAT | O_RDWR) : O_RDONLY, 0644);
+        if (fd < 0)
+        {
+            CLUSTER_LOG_ERROR(Init) << "Failed to " << (create ? "create" : "open") << " shared memory " << name
+                << ": " << errno;
+            return false;
+        }
+
+        if (create && ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            CLUSTER_LOG_ERROR(Init) << "Failed to size shared memory " << name << ": " << errno;
+            close(fd);
+            shm_unlink(posixName.c_str());
+            return false;
+        }
+
+        const auto data = mmap(nullptr, size, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            CLUSTER_LOG_ERROR(Init) << "Failed to map shared memory " << name << ": " << errno;
+            if (create)
+            {
+                shm_unlink(posixName.c_str());
+            }
+            return false;
+        }
+
+        m_Data = data;
+        m_Size = size;
+        if (create)
+        {
+            m_UnlinkName = posixName;
+        }
+        return true;
+    }
+
+    void SharedMemory::Close()
+    {
+        if (m_Data != nullptr)
+        {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+            m_Size = 0;
+        }
+        if (!m_UnlinkName.empty())
+        {
+            shm_unlink(m_UnlinkName.c_str());
+            m_UnlinkName.clear();
+        }
+    }
+#endif
+}
@@ -0,0 +1,258 @@
+#include "SimulatedSwapGroupApi.h"
+
+#include <thread>
+
+namespace GfxQuadroSync
+{
+    SimulatedSwapGroupApi::SimulatedSwapGroupApi(const Config& config)
+        : m_Config(config)
+        , m_RefreshPeriod(config.refreshRateHz > 0 ?
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.refreshRateHz)) :
+            Clock::duration::zero())
+        , m_VblankOrigin(Clock::now())
+    {
+    }
+
+    void SimulatedSwapGroupApi::InjectFailure(const Call call, const NvAPI_Status status, const uint32_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        auto& injectedFailure = m_InjectedFailures[static_cast<int>(call)];
+        injectedFailure.status = status;
+        injectedFailure.remaining = count;
+    }
+
+    uint64_t SimulatedSwapGroupApi::GetCallCount(const Call call) const
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        return m_CallCounts[static_cast<int>(call)];
+    }
+
+    NvU32 SimulatedSwapGroupApi::GetFrameCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        return static_cast<NvU32>(VblanksSinceOrigin(Clock::now()) - m_FrameCountOffset);
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::Initialize()
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::Initialize);
+        if (status == NVAPI_OK)
+        {
+            m_Initialized = true;
+        }
+        return status;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::EnumPhysicalGPUs(NvPhysicalGpuHandle gpuHandles[NVAPI_MAX_PHYSICAL_GPUS],
+        NvU32* const gpuCount)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::EnumPhysicalGPUs);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (gpuHandles == nullptr || gpuCount == nullptr)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        *gpuCount = m_Config.gpuCount < NVAPI_MAX_PHYSICAL_GPUS ? m_Config.gpuCount : NVAPI_MAX_PHYSICAL_GPUS;
+        for (NvU32 gpuIndex = 0; gpuIndex < *gpuCount; ++gpuIndex)
+        {
+            // Handles are opaque, they only need to be unique and non null.
+            gpuHandles[gpuIndex] = reinterpret_cast<NvPhysicalGpuHandle>(static_cast<uintptr_t>(gpuIndex + 1));
+        }
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::SetupWorkstationSwapGroupFeature(const NvPhysicalGpuHandle gpuHandle,
+        const bool enable)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::SetupWorkstationSwapGroupFeature);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (gpuHandle == nullptr)
+        {
+            return NVAPI_INVALID_HANDLE;
+        }
+
+        m_WorkstationFeatureEnabled = enable;
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::QueryMaxSwapGroup(IUnknown* const device, NvU32* const maxGroups,
+        NvU32* const maxBarriers)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::QueryMaxSwapGroup);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr || maxGroups == nullptr || maxBarriers == nullptr)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        *maxGroups = m_Config.maxSwapGroups;
+        *maxBarriers = m_Config.maxSwapBarriers;
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::JoinSwapGroup(IUnknown* const device, IDXGISwapChain* const swapChain,
+        const NvU32 group, const bool)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::JoinSwapGroup);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr || swapChain == nullptr || group > m_Config.maxSwapGroups)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        m_GroupId = group;
+        m_SwapChain = swapChain;
+        if (group == 0)
+        {
+            // Leaving the swap group also leaves the barrier it was bound to.
+            m_BarrierId = 0;
+        }
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::BindSwapBarrier(IUnknown* const device, const NvU32 group,
+        const NvU32 barrier)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::BindSwapBarrier);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr || group == 0 || group != m_GroupId || barrier > m_Config.maxSwapBarriers)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        m_BarrierId = barrier;
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::QuerySwapGroup(IUnknown* const device, IDXGISwapChain* const swapChain,
+        NvU32* const group, NvU32* const barrier)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::QuerySwapGroup);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr || swapChain == nullptr || group == nullptr || barrier == nullptr)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        // Like a swap chain recreated by Unity, a swap chain that did not join is not a member.
+        *group = swapChain == m_SwapChain ? m_GroupId : 0;
+        *barrier = swapChain == m_SwapChain ? m_BarrierId : 0;
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::QueryFrameCount(IUnknown* const device, NvU32* const frameCount)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::QueryFrameCount);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr || frameCount == nullptr)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        *frameCount = static_cast<NvU32>(VblanksSinceOrigin(Clock::now()) - m_FrameCountOffset);
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::ResetFrameCount(IUnknown* const device)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        const auto status = BeginCall(Call::ResetFrameCount);
+        if (status != NVAPI_OK)
+        {
+            return status;
+        }
+        if (device == nullptr)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+
+        m_FrameCountOffset = VblanksSinceOrigin(Clock::now());
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::Present(IUnknown* const device, IDXGISwapChain* const swapChain,
+        const NvU32 syncInterval, const NvU32)
+    {
+        Clock::time_point presentDoneTime;
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+            const auto status = BeginCall(Call::Present);
+            if (status != NVAPI_OK)
+            {
+                return status;
+            }
+            if (device == nullptr || swapChain == nullptr)
+            {
+                return NVAPI_INVALID_ARGUMENT;
+            }
+
+            presentDoneTime = Clock::now();
+            if (m_RefreshPeriod > Clock::duration::zero() && (syncInterval > 0 || m_GroupId > 0))
+            {
+                const auto nextVblank = VblanksSinceOrigin(presentDoneTime) + (syncInterval > 0 ? syncInterval : 1);
+                presentDoneTime = m_VblankOrigin + m_RefreshPeriod * nextVblank;
+            }
+            presentDoneTime += std::chrono::duration_cast<Clock::duration>(m_Config.presentLatency);
+        }
+
+        std::this_thread::sleep_until(presentDoneTime);
+        return NVAPI_OK;
+    }
+
+    NvAPI_Status SimulatedSwapGroupApi::BeginCall(const Call call)
+    {
+        ++m_CallCounts[static_cast<int>(call)];
+
+        auto& injectedFailure = m_InjectedFailures[static_cast<int>(call)];
+        if (injectedFailure.remaining > 0)
+        {
+            --injectedFailure.remaining;
+            return injectedFailure.status;
+        }
+
+        if (!m_Initialized && call != Call::Initialize)
+        {
+            return NVAPI_API_NOT_INITIALIZED;
+        }
+        return NVAPI_OK;
+    }
+
+    uint64_t SimulatedSwapGroupApi::VblanksSinceOrigin(const Clock::time_point now) const
+    {
+        if (m_RefreshPeriod <= Clock::duration::zero())
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>((now - m_VblankOrigin) / m_RefreshPeriod);
+    }
+}
@@ -0,0 +1,53 @@
+#include "SwapChainMonitor.h"
+
+namespace GfxQuadroSync
+{
+    SwapChainChange SwapChainMonitor::Observe(const SwapChainIdentity& identity, const uint64_t tick)
+    {
+        uint32_t change = 0;
+        if (m_HasIdentity)
+        {
+            if (identity.swapChain != m_Identity.swapChain)
+            {
+                change |= static_cast<uint32_t>(SwapChainChange::Recreated);
+            }
+            SwapChainIdentity sameSwapChain = identity;
+            sameSwapChain.swapChain = m_Identity.swapChain;
+            if (sameSwapChain != m_Identity)
+            {
+                change |= static_cast<uint32_t>(SwapChainChange::Resized);
+            }
+        }
+        m_HasIdentity = true;
+        m_Identity = identity;
+
+        if (change != 0)
+        {
+            ++m_Report.changeCount;
+            m_Report.lastChange = change;
+            m_Report.lastRejoinStatus = 0;
+            // A change while still out of sync from the previous one extends the same out of sync period.
+            if (!IsOutOfSync())
+            {
+                m_Report.outOfSync = 1;
+                m_Report.lastChangeTick = tick;
+            }
+            m_Report.lastResynchronizedTick = 0;
+            m_Report.lastOutOfSyncTicks = 0;
+        }
+        return static_cast<SwapChainChange>(change);
+    }
+
+    void SwapChainMonitor::Resynchronized(const uint64_t tick)
+    {
+        if (!IsOutOfSync())
+        {
+            return;
+        }
+
+        m_Report.outOfSync = 0;
+        m_Report.lastResynchronizedTick = tick;
+        m_Report.lastOutOfSyncTicks = tick > m_Report.lastChangeTick ? tick - m_Report.lastChangeTick : 0;
+        m_Report.totalOutOfSyncTicks += m_Report.lastOutOfSyncTicks;
+    }
+}
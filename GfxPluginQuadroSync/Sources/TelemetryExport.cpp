@@ -0,0 +1,111 @@
+#include "TelemetryExport.h"
+#include "Logger.h"
+#include "PerformanceCounter.h"
+
+#include <cstddef>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace GfxQuadroSync
+{
+    namespace
+    {
+        uint32_t GetCurrentProcessIdentifier()
+        {
+#ifdef _WIN32
+            return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+            return static_cast<uint32_t>(getpid());
+#endif
+        }
+
+        /// Number of timings copied from the source ring to the shared memory at once.
+        constexpr uint32_t k_TimingsCopyBatch = 32;
+    }
+
+    bool TelemetryExport::Open(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Block.store(nullptr, std::memory_order_relaxed);
+        m_SharedMemory.Close();
+        if (name.empty())
+        {
+            return true;
+        }
+
+        if (!m_SharedMemory.Create(name, sizeof(TelemetryBlock)))
+        {
+            return false;
+        }
+
+        const auto block = new (m_SharedMemory.GetData()) TelemetryBlock();
+        auto& header = block->header;
+        header.layoutVersion = TelemetryHeader::k_LayoutVersion;
+        header.totalSize = static_cast<uint32_t>(sizeof(TelemetryBlock));
+        header.processId = GetCurrentProcessIdentifier();
+        header.performanceCounterFrequency = GetPerformanceCounterFrequency();
+        header.stateOffset = static_cast<uint32_t>(offsetof(TelemetryBlock, state));
+        header.timingsOffset = static_cast<uint32_t>(offsetof(TelemetryBlock, timings));
+        header.timingsCapacity = PresentTimingRing::k_Capacity;
+        header.magic.store(TelemetryHeader::k_Magic, std::memory_order_release);
+
+        // Publish the whole history still in the source ring on the first call to Publish.
+        m_TimingsReadCursor = 0;
+        m_Block.store(block, std::memory_order_relaxed);
+        CLUSTER_LOG(Init) << "Publishing telemetry in shared memory " << name;
+        return true;
+    }
+
+    void TelemetryExport::Publish(const QuadroSyncState& state, const PresentTimingRing& timings)
+    {
+        if (m_Block.load(std::memory_order_relaxed) == nullptr)
+        {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Lock, std::try_to_lock);
+        const auto block = m_Block.load(std::memory_order_relaxed);
+        if (!lock.owns_lock() || block == nullptr)
+        {
+            return;
+        }
+
+        block->state.Write(state);
+
+        PresentTiming batch[k_TimingsCopyBatch];
+        uint64_t dropped = 0;
+        uint32_t readCount;
+        while ((readCount = timings.Read(m_TimingsReadCursor, batch, k_TimingsCopyBatch, dropped)) > 0)
+        {
+            for (uint32_t i = 0; i < readCount; ++i)
+            {
+                block->timings.Push(batch[i]);
+            }
+        }
+    }
+
+    const TelemetryBlock* TelemetryExport::Validate(const void* const memory, const size_t size)
+    {
+        if (memory == nullptr || size < sizeof(TelemetryBlock))
+        {
+            return nullptr;
+        }
+
+        const auto block = static_cast<const TelemetryBlock*>(memory);
+        const auto& header = block->header;
+        if (header.magic.load(std::memory_order_acquire) != TelemetryHeader::k_Magic ||
+            header.layoutVersion != TelemetryHeader::k_LayoutVersion || header.totalSize != sizeof(TelemetryBlock) ||
+            header.stateOffset != offsetof(TelemetryBlock, state) ||
+            header.timingsOffset != offsetof(TelemetryBlock, timings) ||
+            header.timingsCapacity != PresentTimingRing::k_Capacity)
+        {
+            return nullptr;
+        }
+        return block;
+    }
+}
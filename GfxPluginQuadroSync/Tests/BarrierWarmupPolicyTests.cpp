@@ -0,0 +1,132 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "BarrierWarmupPolicy.h"
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::SimulatedClient;
+using Decision = BarrierWarmupPolicy::Decision;
+
+namespace
+{
+    BarrierWarmupPolicy::Settings TestSettings()
+    {
+        BarrierWarmupPolicy::Settings settings;
+        settings.stablePresents = 3;
+        settings.maxPresents = 20;
+        settings.intervalTolerance = 0.1;
+        settings.frameCountTolerance = 0;
+        return settings;
+    }
+
+    PluginCSwapGroupClient::BarrierWarmupAction UNITY_INTERFACE_API CallbackMustNotBeCalled()
+    {
+        CHECK(false);
+        return PluginCSwapGroupClient::BarrierWarmupAction::BarrierWarmedUp;
+    }
+}
+
+TEST_CASE(BarrierWarmupPolicy_ConvergesOnceFramesAndIntervalsAreStable)
+{
+    BarrierWarmupPolicy policy;
+    policy.Start(TestSettings());
+    CHECK(policy.GetReport().outcome == static_cast<uint32_t>(BarrierWarmupOutcome::InProgress));
+
+    // Presents not paced by the barrier yet: many per frame
+    CHECK(policy.OnPresent(1000, true, 10) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(1010, true, 10) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(1020, true, 10) == Decision::RepeatPresent);
+    CHECK(policy.GetReport().stablePresentCount == 0);
+
+    // One frame per present at a steady interval
+    CHECK(policy.OnPresent(1120, true, 11) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(1221, true, 12) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(1320, true, 13) == Decision::Converged);
+
+    const auto& report = policy.GetReport();
+    CHECK(report.outcome == static_cast<uint32_t>(BarrierWarmupOutcome::Converged));
+    CHECK(report.presentCount == 6);
+    CHECK(report.stablePresentCount == 3);
+    CHECK(report.startTick == 1000);
+    CHECK(report.endTick == 1320);
+    CHECK(report.presentIntervalTicks == 100.0);
+}
+
+TEST_CASE(BarrierWarmupPolicy_UnstablePresentRestartsTheCount)
+{
+    BarrierWarmupPolicy policy;
+    policy.Start(TestSettings());
+    CHECK(policy.OnPresent(0, true, 0) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(100, true, 1) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(200, true, 2) == Decision::RepeatPresent);
+    // Interval outside of the tolerance
+    CHECK(policy.OnPresent(350, true, 3) == Decision::RepeatPresent);
+    CHECK(policy.GetReport().stablePresentCount == 0);
+    // Frame skipped
+    CHECK(policy.OnPresent(450, true, 4) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(550, true, 6) == Decision::RepeatPresent);
+    CHECK(policy.GetReport().stablePresentCount == 0);
+    CHECK(policy.OnPresent(650, true, 7) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(750, true, 8) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(850, true, 9) == Decision::Converged);
+
+    // Frame tolerance
+    auto settings = TestSettings();
+    settings.frameCountTolerance = 1;
+    policy.Start(settings);
+    CHECK(policy.OnPresent(0, true, 0) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(100, true, 2) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(200, true, 2) == Decision::RepeatPresent);
+    CHECK(policy.OnPresent(300, true, 3) == Decision::Converged);
+}
+
+TEST_CASE(BarrierWarmupPolicy_GivesUpAfterMaxPresents)
+{
+    BarrierWarmupPolicy policy;
+    policy.Start(TestSettings());
+    uint64_t tick = 0;
+    for (uint32_t i = 1; i < TestSettings().maxPresents; ++i)
+    {
+        // Never more than one stable present in a row
+        tick += (i % 2) == 0 ? 100 : 300;
+        CHECK(policy.OnPresent(tick, false, 0) == Decision::RepeatPresent);
+    }
+    CHECK(policy.OnPresent(tick + 1000, false, 0) == Decision::GaveUp);
+    CHECK(policy.GetReport().outcome == static_cast<uint32_t>(BarrierWarmupOutcome::GaveUp));
+    CHECK(policy.GetReport().presentCount == TestSettings().maxPresents);
+}
+
+TEST_CASE(BarrierWarmupPolicy_SwapGroupClientWarmsUpWithoutCallback)
+{
+    auto config = SimulatedClient::NoWaitConfig();
+    config.refreshRateHz = 1000;
+    SimulatedClient simulated(config);
+    simulated.client->SetBarrierWarmupCallback(&CallbackMustNotBeCalled);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    CHECK(simulated.client->GetBarrierWarmupReport().outcome == static_cast<uint32_t>(BarrierWarmupOutcome::None));
+
+    // Generous tolerances: the simulated vertical blanks are paced by the scheduler of the machine running the test.
+    auto settings = TestSettings();
+    settings.maxPresents = 200;
+    settings.intervalTolerance = 0.9;
+    settings.frameCountTolerance = 1;
+    simulated.client->SetBarrierWarmupPolicy(&settings);
+    CHECK(simulated.client->Render(&simulated.device));
+
+    const auto report = simulated.client->GetBarrierWarmupReport();
+    CHECK(report.outcome != static_cast<uint32_t>(BarrierWarmupOutcome::None));
+    CHECK(report.outcome != static_cast<uint32_t>(BarrierWarmupOutcome::InProgress));
+    CHECK(report.presentCount >= settings.stablePresents + 1);
+    CHECK(simulated.device.initiatePresentRepeatsCount == 1);
+    CHECK(simulated.device.prepareSinglePresentRepeatCount == report.presentCount - 1);
+    CHECK(simulated.device.concludePresentRepeatsCount == 1);
+    CHECK(simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::Present) == report.presentCount);
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+
+    // Back to the callback
+    simulated.client->SetBarrierWarmupPolicy(nullptr);
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::Present) == report.presentCount + 1);
+}
@@ -0,0 +1,126 @@
+#include "TestFramework.h"
+#include "FakeUnknown.h"
+
+#include "ComPtr.h"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::FakeUnknown;
+
+TEST_CASE(ComPtr_AdoptDoesNotAddReference)
+{
+    FakeUnknown object;
+    {
+        auto ptr = ComPtr<FakeUnknown>::Adopt(&object);
+        CHECK(ptr.get() == &object);
+        CHECK(object.GetReferenceCount() == 1);
+    }
+    CHECK(object.GetReferenceCount() == 0);
+}
+
+TEST_CASE(ComPtr_RetainAddsReference)
+{
+    FakeUnknown object;
+    {
+        auto ptr = ComPtr<FakeUnknown>::Retain(&object);
+        CHECK(object.GetReferenceCount() == 2);
+    }
+    CHECK(object.GetReferenceCount() == 1);
+}
+
+TEST_CASE(ComPtr_MoveTransfersTheReference)
+{
+    FakeUnknown object;
+    auto ptr = ComPtr<FakeUnknown>::Retain(&object);
+
+    ComPtr<FakeUnknown> moved(std::move(ptr));
+    CHECK(!ptr);
+    CHECK(moved.get() == &object);
+    CHECK(object.GetReferenceCount() == 2);
+
+    ComPtr<FakeUnknown> assigned;
+    assigned = std::move(moved);
+    CHECK(!moved);
+    CHECK(assigned.get() == &object);
+    CHECK(object.GetReferenceCount() == 2);
+
+    // Growing a vector moves its elements
+    std::vector<ComPtr<FakeUnknown>> ptrs;
+    for (int i = 0; i < 10; ++i)
+    {
+        ptrs.push_back(ComPtr<FakeUnknown>::Retain(assigned.get()));
+    }
+    CHECK(object.GetReferenceCount() == 12);
+    ptrs.clear();
+    assigned.reset();
+    CHECK(object.GetReferenceCount() == 1);
+}
+
+TEST_CASE(ComPtr_IsMoveOnly)
+{
+    static_assert(!std::is_copy_constructible_v<ComPtr<FakeUnknown>>);
+    static_assert(!std::is_copy_assignable_v<ComPtr<FakeUnknown>>);
+    static_assert(std::is_nothrow_move_constructible_v<ComPtr<FakeUnknown>>);
+    static_assert(std::is_nothrow_move_assignable_v<ComPtr<FakeUnknown>>);
+
+    // Adding a reference has to be explicit
+    FakeUnknown object;
+    auto ptr = ComPtr<FakeUnknown>::Retain(&object);
+    {
+        auto other = ComPtr<FakeUnknown>::Retain(ptr.get());
+        CHECK(other == ptr);
+        CHECK(object.GetReferenceCount() == 3);
+    }
+    CHECK(object.GetReferenceCount() == 2);
+}
+
+TEST_CASE(ComPtr_AttachReleasesPreviousObject)
+{
+    FakeUnknown first;
+    FakeUnknown second;
+    auto ptr = ComPtr<FakeUnknown>::Adopt(&first);
+
+    second.AddRef();
+    ptr.Attach(&second);
+    CHECK(first.GetReferenceCount() == 0);
+    CHECK(second.GetReferenceCount() == 2);
+
+    // Attaching a new reference on the same object must not leak the previous one
+    second.AddRef();
+    ptr.Attach(&second);
+    CHECK(second.GetReferenceCount() == 2);
+}
+
+TEST_CASE(ComPtr_DetachGivesTheReferenceBack)
+{
+    FakeUnknown object;
+    auto ptr = ComPtr<FakeUnknown>::Retain(&object);
+
+    FakeUnknown* const detached = ptr.Detach();
+    CHECK(detached == &object);
+    CHECK(!ptr);
+    CHECK(object.GetReferenceCount() == 2);
+
+    detached->Release();
+}
+
+TEST_CASE(ComPtr_ReleaseAndGetAddressOfForOutParameters)
+{
+    FakeUnknown first;
+    FakeUnknown second;
+    auto ptr = ComPtr<FakeUnknown>::Adopt(&first);
+
+    // What a method like ID3D11Device::GetImmediateContext does with its out parameter
+    FakeUnknown** const address = ptr.ReleaseAndGetAddressOf();
+    CHECK(first.GetReferenceCount() == 0);
+    CHECK(*address == nullptr);
+    second.AddRef();
+    *address = &second;
+
+    CHECK(ptr.get() == &second);
+    ptr = nullptr;
+    CHECK(second.GetReferenceCount() == 1);
+}
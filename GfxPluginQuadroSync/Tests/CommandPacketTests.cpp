@@ -0,0 +1,114 @@
+#include "TestFramework.h"
+
+#include "CommandPacket.h"
+
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    /// Command packet stored in a single buffer like the one built by managed code.
+    class TestPacket
+    {
+        // Storage aligned like CommandPacketHeader
+        struct alignas(CommandPacketHeader) Storage { unsigned char bytes[sizeof(CommandPacketHeader)]; };
+
+    public:
+        explicit TestPacket(const std::vector<QuadroSyncCommand>& commands, const CommandPacketFlags flags)
+            : m_Buffer((sizeof(CommandPacketHeader) + commands.size() * sizeof(QuadroSyncCommand) +
+                sizeof(Storage) - 1) / sizeof(Storage))
+        {
+            auto& header = GetHeader();
+            header.version = CommandPacketHeader::k_Version;
+            header.flags = static_cast<uint32_t>(flags);
+            header.commandCount = static_cast<uint32_t>(commands.size());
+            header.processedCount.store(CommandPacketHeader::k_NotProcessed);
+            for (size_t i = 0; i < commands.size(); ++i)
+            {
+                header.GetCommands()[i] = commands[i];
+            }
+        }
+
+        CommandPacketHeader& GetHeader() { return *reinterpret_cast<CommandPacketHeader*>(m_Buffer.data()); }
+        QuadroSyncCommand& GetCommand(const size_t index) { return GetHeader().GetCommands()[index]; }
+
+    private:
+        std::vector<Storage> m_Buffer;
+    };
+
+    constexpr uint32_t k_Add = 1;
+    constexpr uint32_t k_Fail = 2;
+    constexpr uint32_t k_Query = 3;
+}
+
+TEST_CASE(CommandPacket_ExecutesCommandsInOrder)
+{
+    TestPacket packet({{k_Add, 0, 5, 0}, {k_Add, 0, 3, 0}, {k_Query, 0, 0, 0}}, CommandPacketFlags::None);
+
+    std::vector<uint64_t> arguments;
+    int64_t total = 0;
+    REQUIRE(ExecuteCommandPacket(&packet.GetHeader(), [&](const uint32_t id, const uint64_t argument, int64_t& result)
+    {
+        arguments.push_back(argument);
+        if (id == k_Add)
+        {
+            total += static_cast<int64_t>(argument);
+        }
+        else if (id == k_Query)
+        {
+            result = total;
+        }
+        return CommandStatus::Succeeded;
+    }));
+
+    CHECK(packet.GetHeader().processedCount.load() == 3);
+    REQUIRE(arguments.size() == 3);
+    CHECK(arguments[0] == 5);
+    CHECK(arguments[1] == 3);
+    CHECK(packet.GetCommand(0).status == static_cast<uint32_t>(CommandStatus::Succeeded));
+    CHECK(packet.GetCommand(2).status == static_cast<uint32_t>(CommandStatus::Succeeded));
+    CHECK(packet.GetCommand(2).result == 8);
+}
+
+TEST_CASE(CommandPacket_StopOnFailure)
+{
+    const auto handler = [](const uint32_t id, uint64_t, int64_t&)
+    {
+        return id == k_Fail ? CommandStatus::Failed : CommandStatus::Succeeded;
+    };
+
+    TestPacket stopping({{k_Add, 0, 1, 0}, {k_Fail, 0, 0, 0}, {k_Add, 0, 1, 0}}, CommandPacketFlags::StopOnFailure);
+    REQUIRE(ExecuteCommandPacket(&stopping.GetHeader(), handler));
+    CHECK(stopping.GetCommand(0).status == static_cast<uint32_t>(CommandStatus::Succeeded));
+    CHECK(stopping.GetCommand(1).status == static_cast<uint32_t>(CommandStatus::Failed));
+    CHECK(stopping.GetCommand(2).status == static_cast<uint32_t>(CommandStatus::Skipped));
+
+    TestPacket continuing({{k_Add, 0, 1, 0}, {k_Fail, 0, 0, 0}, {k_Add, 0, 1, 0}}, CommandPacketFlags::None);
+    REQUIRE(ExecuteCommandPacket(&continuing.GetHeader(), handler));
+    CHECK(continuing.GetCommand(1).status == static_cast<uint32_t>(CommandStatus::Failed));
+    CHECK(continuing.GetCommand(2).status == static_cast<uint32_t>(CommandStatus::Succeeded));
+}
+
+TEST_CASE(CommandPacket_RejectsInvalidPackets)
+{
+    uint32_t handlerCalls = 0;
+    const auto handler = [&handlerCalls](uint32_t, uint64_t, int64_t&)
+    {
+        ++handlerCalls;
+        return CommandStatus::Succeeded;
+    };
+
+    TestPacket wrongVersion({{k_Add, 0, 1, 0}}, CommandPacketFlags::None);
+    wrongVersion.GetHeader().version = CommandPacketHeader::k_Version + 1;
+    CHECK(!ExecuteCommandPacket(&wrongVersion.GetHeader(), handler));
+    CHECK(wrongVersion.GetHeader().processedCount.load() == 0);
+    CHECK(wrongVersion.GetCommand(0).status == static_cast<uint32_t>(CommandStatus::Pending));
+
+    TestPacket tooManyCommands({{k_Add, 0, 1, 0}}, CommandPacketFlags::None);
+    tooManyCommands.GetHeader().commandCount = CommandPacketHeader::k_MaxCommandCount + 1;
+    CHECK(!ExecuteCommandPacket(&tooManyCommands.GetHeader(), handler));
+
+    CHECK(!ExecuteCommandPacket(nullptr, handler));
+    CHECK(handlerCalls == 0);
+}
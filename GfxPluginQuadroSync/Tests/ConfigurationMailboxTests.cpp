@@ -0,0 +1,150 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "ConfigurationMailbox.h"
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::SimulatedClient;
+
+namespace
+{
+    using Setting = PluginCSwapGroupClient::ConfigurationSetting;
+}
+
+TEST_CASE(ConfigurationMailbox_LastPostOfASettingWins)
+{
+    ConfigurationMailbox mailbox;
+    CHECK(!mailbox.HasPending());
+    CHECK(mailbox.Post(ConfigurationMailbox::Change(0, true) | ConfigurationMailbox::Change(2, true)) == 1);
+    CHECK(mailbox.Post(ConfigurationMailbox::Change(2, false)) == 2);
+    CHECK(mailbox.Post(ConfigurationMailbox::Change(15, true)) == 3);
+    CHECK(mailbox.HasPending());
+    CHECK(mailbox.GetPostedEpoch() == 3);
+    CHECK(mailbox.GetAppliedEpoch() == 0);
+
+    uint32_t epoch = 0;
+    const auto changes = mailbox.Take(epoch);
+    CHECK(epoch == 3);
+    CHECK(!mailbox.HasPending());
+    bool value = false;
+    CHECK(ConfigurationMailbox::GetChange(changes, 0, value) && value);
+    CHECK(!ConfigurationMailbox::GetChange(changes, 1, value));
+    CHECK(ConfigurationMailbox::GetChange(changes, 2, value) && !value);
+    CHECK(ConfigurationMailbox::GetChange(changes, 15, value) && value);
+    mailbox.SetAppliedEpoch(epoch);
+    CHECK(mailbox.GetAppliedEpoch() == 3);
+
+    CHECK(mailbox.Take(epoch) == 0);
+    CHECK(epoch == 3);
+}
+
+TEST_CASE(ConfigurationMailbox_ConcurrentPostsAreNotLost)
+{
+    ConfigurationMailbox mailbox;
+    constexpr uint32_t threadCount = 4;
+    constexpr uint32_t postsPerThread = 10000;
+    std::atomic<bool> postersDone{false};
+    std::vector<std::thread> posters;
+    for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        posters.emplace_back([&mailbox, threadIndex]
+        {
+            // Every thread has its own setting and ends with true
+            for (uint32_t i = 1; i <= postsPerThread; ++i)
+            {
+                mailbox.Post(ConfigurationMailbox::Change(threadIndex, (i % 2) == 0));
+            }
+        });
+    }
+
+    // Owner taking changes while they are posted
+    bool lastValues[threadCount] = {};
+    auto takeChanges = [&mailbox, &lastValues]
+    {
+        uint32_t epoch;
+        const auto changes = mailbox.Take(epoch);
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            ConfigurationMailbox::GetChange(changes, threadIndex, lastValues[threadIndex]);
+        }
+        mailbox.SetAppliedEpoch(epoch);
+    };
+    std::thread owner([&postersDone, &takeChanges]
+    {
+        while (!postersDone.load())
+        {
+            takeChanges();
+        }
+    });
+
+    for (auto& poster : posters)
+    {
+        poster.join();
+    }
+    postersDone = true;
+    owner.join();
+    takeChanges();
+
+    CHECK(mailbox.GetPostedEpoch() == threadCount * postsPerThread);
+    CHECK(mailbox.GetAppliedEpoch() == threadCount * postsPerThread);
+    for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        CHECK(lastValues[threadIndex]);
+    }
+}
+
+TEST_CASE(ConfigurationMailbox_SwapGroupClientAppliesInPostOrder)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    CHECK(!simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain()));
+
+    // Swap group enabled then whole system disabled: system wins
+    simulated.client->PostConfigurationChange(Setting::SwapGroup, true);
+    const auto epoch = simulated.client->PostConfigurationChange(Setting::System, false);
+    CHECK(simulated.client->HasPendingConfiguration());
+    CHECK(simulated.client->GetAppliedConfigurationEpoch() < epoch);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+
+    CHECK(simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain()));
+    CHECK(simulated.client->GetAppliedConfigurationEpoch() == epoch);
+    CHECK(!simulated.client->HasPendingConfiguration());
+    CHECK(simulated.client->GetSwapGroupId() == 0);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+
+    // Whole system disabled then swap group enabled: swap group joined without the barrier
+    simulated.client->PostConfigurationChange(Setting::System, false);
+    simulated.client->PostConfigurationChange(Setting::SwapGroup, true);
+    const auto joinsBefore = simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::JoinSwapGroup);
+    CHECK(simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain()));
+    CHECK(simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::JoinSwapGroup) == joinsBefore + 1);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+}
+
+TEST_CASE(ConfigurationMailbox_SwapGroupClientTogglesSyncCounterWithoutDriverCalls)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    REQUIRE(simulated.client->GetConfiguration().hardwareFrameCounter);
+    const auto queriesBefore = simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::QuerySwapGroup);
+
+    simulated.client->PostConfigurationChange(Setting::SyncCounter, false);
+    CHECK(simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain()));
+    CHECK(!simulated.client->GetConfiguration().hardwareFrameCounter);
+    CHECK((simulated.client->GetSnapshot().flags &
+        static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter)) == 0);
+
+    simulated.client->PostConfigurationChange(Setting::SyncCounter, true);
+    CHECK(simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain()));
+    CHECK(simulated.client->GetConfiguration().hardwareFrameCounter);
+    CHECK(simulated.api->GetCallCount(SimulatedSwapGroupApi::Call::QuerySwapGroup) == queriesBefore);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+}
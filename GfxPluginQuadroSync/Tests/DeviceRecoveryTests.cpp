@@ -0,0 +1,154 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "DeviceRecovery.h"
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::FakeComObject;
+using QuadroSyncTests::SimulatedClient;
+using Call = SimulatedSwapGroupApi::Call;
+
+namespace
+{
+    // DXGI_ERROR_DEVICE_REMOVED
+    const auto k_DeviceRemoved = static_cast<int32_t>(0x887A0005);
+}
+
+TEST_CASE(DeviceRecovery_ClassifiesPresentFailures)
+{
+    CHECK(DeviceRecovery::Classify(NVAPI_ERROR, 0) == PresentFailureKind::Transient);
+    CHECK(DeviceRecovery::Classify(NVAPI_DEVICE_BUSY, 0) == PresentFailureKind::Transient);
+    CHECK(DeviceRecovery::Classify(NVAPI_ERROR, k_DeviceRemoved) == PresentFailureKind::Fatal);
+    CHECK(DeviceRecovery::Classify(NVAPI_HANDLE_INVALIDATED, 0) == PresentFailureKind::Fatal);
+    CHECK(DeviceRecovery::Classify(NVAPI_INVALID_ARGUMENT, 0) == PresentFailureKind::Fatal);
+}
+
+TEST_CASE(DeviceRecovery_TransientFailuresOnlyDegrade)
+{
+    DeviceRecovery recovery;
+    CHECK(!recovery.OnPresentFailed(NVAPI_DEVICE_BUSY, 0, 10));
+    CHECK(recovery.GetState() == DeviceRecoveryState::Degraded);
+    recovery.OnPresentSucceeded();
+    CHECK(recovery.GetState() == DeviceRecoveryState::Healthy);
+    CHECK(recovery.GetReport().consecutiveFailures == 0);
+
+    // However long they last, transient failures only ask for the membership to be checked from time to time
+    for (uint32_t i = 1; i <= DeviceRecovery::k_TransientFailuresBetweenMembershipChecks * 3; ++i)
+    {
+        CHECK(!recovery.OnPresentFailed(NVAPI_ERROR, 0, 100 + i));
+        CHECK(recovery.MembershipCheckDue() == (i % DeviceRecovery::k_TransientFailuresBetweenMembershipChecks == 0));
+    }
+    CHECK(recovery.GetState() == DeviceRecoveryState::Degraded);
+    CHECK(recovery.GetReport().recoveryCount == 0);
+
+    recovery.MembershipLost(200);
+    CHECK(recovery.GetState() == DeviceRecoveryState::Lost);
+    CHECK(recovery.GetReport().lostTick == 200);
+    CHECK(recovery.GetReport().lastFailureKind == static_cast<uint32_t>(PresentFailureKind::Fatal));
+
+    recovery.Rejoined();
+    CHECK(recovery.GetState() == DeviceRecoveryState::WarmingUp);
+    // Transient failures while warming up do not restart the recovery, fatal ones go back to Lost without restarting
+    // the clock
+    CHECK(!recovery.OnPresentFailed(NVAPI_ERROR, 0, 220));
+    CHECK(recovery.GetState() == DeviceRecoveryState::WarmingUp);
+    CHECK(recovery.OnPresentFailed(NVAPI_ERROR, k_DeviceRemoved, 250));
+    CHECK(recovery.GetState() == DeviceRecoveryState::Lost);
+    recovery.Rejoined();
+    recovery.Recovered(300);
+    recovery.Recovered(400);
+
+    const auto& report = recovery.GetReport();
+    CHECK(report.state == static_cast<uint32_t>(DeviceRecoveryState::Healthy));
+    CHECK(report.recoveryCount == 1);
+    CHECK(report.lastRecoveryTicks == 100);
+    CHECK(report.totalRecoveryTicks == 100);
+    CHECK(report.lastFailureStatus == NVAPI_ERROR);
+    CHECK(report.lastDeviceRemovedReason == k_DeviceRemoved);
+}
+
+TEST_CASE(DeviceRecovery_SwapGroupClientOnlyRejoinsLostMembership)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.InitializeAndWarmUp());
+    simulated.client->SetBarrierWarmupCallback(nullptr);
+
+    // Another node left the cluster: the barrier keeps failing but this node is still a member
+    const auto failureCount = DeviceRecovery::k_TransientFailuresBetweenMembershipChecks * 3;
+    simulated.api->InjectFailure(Call::Present, NVAPI_ERROR, failureCount);
+    const auto queryCount = simulated.api->GetCallCount(Call::QuerySwapGroup);
+    for (uint32_t i = 0; i < failureCount; ++i)
+    {
+        CHECK(!simulated.client->Render(&simulated.device));
+    }
+    CHECK(!simulated.client->NeedsDeviceRecovery());
+    CHECK(simulated.api->GetCallCount(Call::QuerySwapGroup) == queryCount + 3);
+    auto report = simulated.client->GetDeviceRecoveryReport();
+    CHECK(report.state == static_cast<uint32_t>(DeviceRecoveryState::Degraded));
+    CHECK(report.consecutiveFailures == failureCount);
+    CHECK(report.recoveryCount == 0);
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetDeviceRecoveryReport().state == static_cast<uint32_t>(DeviceRecoveryState::Healthy));
+
+    // Membership lost behind our back: noticed at the next check
+    REQUIRE(simulated.api->BindSwapBarrier(simulated.device.GetDevice(), 1, 0) == NVAPI_OK);
+    simulated.api->InjectFailure(Call::Present, NVAPI_ERROR,
+        DeviceRecovery::k_TransientFailuresBetweenMembershipChecks);
+    for (uint32_t i = 0; i < DeviceRecovery::k_TransientFailuresBetweenMembershipChecks; ++i)
+    {
+        CHECK(!simulated.client->Render(&simulated.device));
+    }
+    CHECK(simulated.client->NeedsDeviceRecovery());
+    CHECK(simulated.client->GetDeviceRecoveryReport().state == static_cast<uint32_t>(DeviceRecoveryState::Lost));
+    CHECK(simulated.client->RecoverDevice(&simulated.device));
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+    CHECK(simulated.client->Render(&simulated.device));
+    report = simulated.client->GetDeviceRecoveryReport();
+    CHECK(report.state == static_cast<uint32_t>(DeviceRecoveryState::Healthy));
+    CHECK(report.recoveryCount == 1);
+}
+
+TEST_CASE(DeviceRecovery_SwapGroupClientRejoinsAfterDeviceRemoved)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.InitializeAndWarmUp());
+    // Like managed code does once the barrier is warmed up
+    simulated.client->SetBarrierWarmupCallback(nullptr);
+
+    // TDR
+    simulated.api->InjectFailure(Call::Present, NVAPI_ERROR);
+    simulated.device.deviceRemovedReason = k_DeviceRemoved;
+    CHECK(!simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->NeedsDeviceRecovery());
+    CHECK(simulated.client->GetDeviceRecoveryReport().state == static_cast<uint32_t>(DeviceRecoveryState::Lost));
+    const auto presentCount = simulated.api->GetCallCount(Call::Present);
+    CHECK(!simulated.client->Render(&simulated.device));
+    CHECK(simulated.api->GetCallCount(Call::Present) == presentCount);
+
+    // Device still removed
+    const auto joinCount = simulated.api->GetCallCount(Call::JoinSwapGroup);
+    CHECK(!simulated.client->RecoverDevice(&simulated.device));
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount);
+
+    // New device and swap chain: swap group and barrier are joined again and the barrier is warmed up on its own
+    simulated.device.deviceRemovedReason = 0;
+    simulated.device.SetSwapChain(FakeComObject<IDXGISwapChain>(0x3000));
+    CHECK(simulated.client->RecoverDevice(&simulated.device));
+    CHECK(!simulated.client->NeedsDeviceRecovery());
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount + 1);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+    CHECK(simulated.client->GetDeviceRecoveryReport().state == static_cast<uint32_t>(DeviceRecoveryState::WarmingUp));
+
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+    CHECK(simulated.client->GetBarrierWarmupReport().outcome != static_cast<uint32_t>(BarrierWarmupOutcome::None));
+    const auto report = simulated.client->GetDeviceRecoveryReport();
+    CHECK(report.state == static_cast<uint32_t>(DeviceRecoveryState::Healthy));
+    CHECK(report.recoveryCount == 1);
+    CHECK(report.lastFailureKind == static_cast<uint32_t>(PresentFailureKind::Fatal));
+    CHECK(report.recoveredTick >= report.lostTick);
+    CHECK(report.lastRecoveryTicks == report.recoveredTick - report.lostTick);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IGraphicsDevice.h"
+
+#include <cstdint>
+
+namespace QuadroSyncTests
+{
+    /// Returns a non null pointer to be used as a fake device or swap chain (never dereferenced by the simulated api).
+    template <class T>
+    T* FakeComObject(const uintptr_t value)
+    {
+        return reinterpret_cast<T*>(value);
+    }
+
+    /**
+     * IGraphicsDevice that does nothing except counting calls to the present repeat methods (to be used with
+     * SimulatedSwapGroupApi).
+     */
+    class FakeGraphicsDevice final : public GfxQuadroSync::IGraphicsDevice
+    {
+    public:
+        GfxQuadroSync::GraphicsDeviceType GetDeviceType() const override
+        {
+            return GfxQuadroSync::GraphicsDeviceType::GRAPHICS_DEVICE_D3D12;
+        }
+
+        IUnknown* GetDevice() const override { return m_Device; }
+        IDXGISwapChain* GetSwapChain() const override { return m_SwapChain; }
+        uint32_t GetSyncInterval() const override { return 1; }
+        uint32_t GetPresentFlags() const override { return 0; }
+
+        void SetDevice(IUnknown* const device) override { m_Device = device; }
+        void SetSwapChain(IDXGISwapChain* const swapChain) override { m_SwapChain = swapChain; }
+
+        int32_t GetDeviceRemovedReason() const override { return deviceRemovedReason; }
+
+        void InitiatePresentRepeats() override { ++initiatePresentRepeatsCount; }
+        void PrepareSinglePresentRepeat() override { ++prepareSinglePresentRepeatCount; }
+        void ConcludePresentRepeats() override { ++concludePresentRepeatsCount; }
+
+        uint32_t initiatePresentRepeatsCount = 0;
+        uint32_t prepareSinglePresentRepeatCount = 0;
+        uint32_t concludePresentRepeatsCount = 0;
+        /// Returned by GetDeviceRemovedReason (to simulate a TDR).
+        int32_t deviceRemovedReason = 0;
+
+    private:
+        IUnknown* m_Device = FakeComObject<IUnknown>(0x1000);
+        IDXGISwapChain* m_SwapChain = FakeComObject<IDXGISwapChain>(0x2000);
+    };
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace QuadroSyncTests
+{
+    /**
+     * Minimal COM-like object (only AddRef and Release) counting its references, to test and benchmark COM smart
+     * pointers without Windows.
+     *
+     * \remark Not deleted when its reference count reaches 0 (tests check the count instead).
+     */
+    class FakeUnknown final
+    {
+    public:
+        unsigned long AddRef() { return m_ReferenceCount.fetch_add(1, std::memory_order_relaxed) + 1; }
+        unsigned long Release() { return m_ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+        uint32_t GetReferenceCount() const { return m_ReferenceCount.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint32_t> m_ReferenceCount{1};
+    };
+}
@@ -0,0 +1,106 @@
+#include "TestFramework.h"
+
+#include "FrameCountService.h"
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    // Use microsecond ticks and a 60 Hz refresh rate
+    constexpr uint64_t k_TicksPerSecond = 1000000;
+    constexpr uint64_t k_TicksPerFrame = 16667;
+
+    uint32_t HardwareFrameCountAt(const uint64_t tick)
+    {
+        return static_cast<uint32_t>(tick / k_TicksPerFrame);
+    }
+}
+
+TEST_CASE(FrameCountService_NoEstimateBeforeFirstSample)
+{
+    FrameCountService service(k_TicksPerSecond);
+    CHECK(service.ShouldSample(0));
+    CHECK(service.Estimate(1000).confidence == FrameCountConfidence::None);
+}
+
+TEST_CASE(FrameCountService_ThrottlesSamplingAfterInitialSamples)
+{
+    FrameCountService service(k_TicksPerSecond);
+    service.SetThrottling(3, k_TicksPerSecond);
+
+    uint64_t tick = 100;
+    uint32_t sampleCount = 0;
+    for (int frame = 0; frame < 180; ++frame, tick += k_TicksPerFrame)
+    {
+        if (service.ShouldSample(tick))
+        {
+            ++sampleCount;
+            service.AddSample(tick, tick + 10, HardwareFrameCountAt(tick));
+        }
+    }
+
+    // 3 unthrottled samples, then one per second for the remaining 2 seconds
+    CHECK(sampleCount == 5);
+}
+
+TEST_CASE(FrameCountService_ExtrapolatesUsingMeasuredRefreshPeriod)
+{
+    FrameCountService service(k_TicksPerSecond);
+    service.SetThrottling(2, 10 * k_TicksPerSecond);
+
+    const uint64_t firstTick = 5000;
+    const uint64_t secondTick = firstTick + 60 * k_TicksPerFrame;
+    service.AddSample(firstTick, firstTick, HardwareFrameCountAt(firstTick));
+    service.AddSample(secondTick, secondTick, HardwareFrameCountAt(secondTick));
+
+    auto sampled = service.Estimate(secondTick);
+    CHECK(sampled.confidence == FrameCountConfidence::Sampled);
+    CHECK(sampled.frameCount == HardwareFrameCountAt(secondTick));
+
+    const uint64_t laterTick = secondTick + 300 * k_TicksPerFrame + k_TicksPerFrame / 2;
+    CHECK(!service.ShouldSample(laterTick));
+    auto extrapolated = service.Estimate(laterTick);
+    CHECK(extrapolated.confidence == FrameCountConfidence::Extrapolated);
+    CHECK(extrapolated.frameCount == HardwareFrameCountAt(laterTick));
+    CHECK(extrapolated.refreshPeriodNs > 16660000 && extrapolated.refreshPeriodNs < 16670000);
+    CHECK(extrapolated.timestampNs == laterTick * 1000);
+    CHECK(extrapolated.sampleAgeNs == (laterTick - secondTick) * 1000);
+}
+
+TEST_CASE(FrameCountService_StaleUntilRefreshPeriodIsKnown)
+{
+    FrameCountService service(k_TicksPerSecond);
+    service.AddSample(1000, 1000, 42);
+    const auto estimate = service.Estimate(1000 + 10 * k_TicksPerFrame);
+    CHECK(estimate.confidence == FrameCountConfidence::Stale);
+    CHECK(estimate.frameCount == 42);
+}
+
+TEST_CASE(FrameCountService_HandlesWrapAroundAndReset)
+{
+    FrameCountService service(k_TicksPerSecond);
+    service.AddSample(0, 0, 0xFFFFFFF0);
+    service.AddSample(32 * k_TicksPerFrame, 32 * k_TicksPerFrame, 0x10);
+    auto estimate = service.Estimate(32 * k_TicksPerFrame);
+    CHECK(estimate.frameCount == 0x100000010ull);
+
+    // Counter going back to a small value (not a wrap around) means it was reset
+    service.AddSample(40 * k_TicksPerFrame, 40 * k_TicksPerFrame, 2);
+    estimate = service.Estimate(40 * k_TicksPerFrame);
+    CHECK(estimate.frameCount == 2);
+    CHECK(estimate.refreshPeriodNs == 0);
+
+    service.Reset();
+    CHECK(service.ShouldSample(41 * k_TicksPerFrame));
+    CHECK(service.Estimate(41 * k_TicksPerFrame).confidence == FrameCountConfidence::None);
+}
+
+TEST_CASE(FrameCountService_FailedSampleDelaysNextAttempt)
+{
+    FrameCountService service(k_TicksPerSecond);
+    service.SetThrottling(0, k_TicksPerSecond);
+    CHECK(service.ShouldSample(k_TicksPerSecond));
+    service.SampleFailed(k_TicksPerSecond);
+    CHECK(!service.ShouldSample(k_TicksPerSecond + 10));
+    CHECK(service.ShouldSample(2 * k_TicksPerSecond));
+}
@@ -0,0 +1,127 @@
+#include "TestFramework.h"
+
+#include "LogRateLimiter.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    constexpr uint64_t k_TicksPerSecond = 1000;
+    constexpr LogFormat k_PresentFailed{LogType::Error, "Present failed: {}", 1};
+    constexpr LogFormat k_OtherFailure{LogType::Error, "Other failure: {} ({})", 2};
+
+    bool ShouldLogStatus(LogRateLimiter& limiter, const LogFormat& format, const NvAPI_Status status)
+    {
+        const LogArgument arguments[2] = {MakeLogArgument(status), MakeLogArgument(42)};
+        return limiter.ShouldLog(format, arguments);
+    }
+}
+
+TEST_CASE(LogRateLimiter_FirstOccurrencesPassThenAreSuppressed)
+{
+    LogRateLimiter limiter(k_TicksPerSecond);
+    limiter.Configure(3, 10);
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    }
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        CHECK(!ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    }
+    CHECK(limiter.GetSuppressedCount() == 100);
+}
+
+TEST_CASE(LogRateLimiter_GroupsAreKeyedByCallSiteAndStatus)
+{
+    LogRateLimiter limiter(k_TicksPerSecond);
+    limiter.Configure(1, 10);
+
+    CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    CHECK(!ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_INVALID_ARGUMENT));
+    CHECK(ShouldLogStatus(limiter, k_OtherFailure, NVAPI_ERROR));
+    CHECK(!ShouldLogStatus(limiter, k_OtherFailure, NVAPI_ERROR));
+
+    // No status -> only keyed by call site
+    const LogArgument noStatus = MakeLogArgument(1);
+    CHECK(limiter.ShouldLog(k_PresentFailed, &noStatus));
+    CHECK(!limiter.ShouldLog(k_PresentFailed, &noStatus));
+}
+
+TEST_CASE(LogRateLimiter_SummaryIsCollectedAtTheEndOfThePeriod)
+{
+    LogRateLimiter limiter(k_TicksPerSecond);
+    limiter.Configure(2, 10);
+
+    LogRateLimiter::Summary summaries[4];
+    for (uint32_t i = 0; i < 3543; ++i)
+    {
+        ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR);
+    }
+
+    // Period starts the first time the consumer sees the group
+    CHECK(limiter.CollectSummaries(1000, summaries, 4) == 0);
+    CHECK(limiter.CollectSummaries(10999, summaries, 4) == 0);
+    REQUIRE(limiter.CollectSummaries(11000, summaries, 4) == 1);
+    CHECK(summaries[0].format == &k_PresentFailed);
+    CHECK(summaries[0].status.kind == LogArgumentKind::NvApiStatus);
+    CHECK(summaries[0].status.intValue == NVAPI_ERROR);
+    CHECK(summaries[0].suppressedCount == 3541);
+    CHECK(summaries[0].periodTicks == 10000);
+
+    // A new period started, the first occurrences pass again
+    CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    CHECK(!ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+
+    // Nothing to report for periods without suppressed occurrences
+    CHECK(limiter.CollectSummaries(21000, summaries, 4) == 1);
+    CHECK(summaries[0].suppressedCount == 1);
+    CHECK(limiter.CollectSummaries(31000, summaries, 4) == 0);
+}
+
+TEST_CASE(LogRateLimiter_ZeroBurstDisablesLimiting)
+{
+    LogRateLimiter limiter(k_TicksPerSecond);
+    limiter.Configure(0, 10);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        CHECK(ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR));
+    }
+    CHECK(limiter.GetSuppressedCount() == 0);
+}
+
+TEST_CASE(LogRateLimiter_ConcurrentCallersShareTheGroup)
+{
+    LogRateLimiter limiter(k_TicksPerSecond);
+    limiter.Configure(10, 10);
+
+    std::atomic<uint32_t> passedCount{0};
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 0; threadIndex < 4; ++threadIndex)
+    {
+        threads.emplace_back([&limiter, &passedCount]()
+        {
+            for (uint32_t i = 0; i < 10000; ++i)
+            {
+                if (ShouldLogStatus(limiter, k_PresentFailed, NVAPI_ERROR))
+                {
+                    ++passedCount;
+                }
+            }
+        });
+    }
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    CHECK(passedCount == 10);
+    CHECK(limiter.GetSuppressedCount() == 40000 - 10);
+}
@@ -0,0 +1,359 @@
+#include "TestFramework.h"
+
+#include "Logger.h"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    std::mutex s_ReceivedMessagesLock;
+    std::vector<std::string> s_ReceivedMessages;
+    std::thread::id s_ReceivingThread;
+
+    void UNITY_INTERFACE_API ReceiveMessage(int, const char* message)
+    {
+        std::lock_guard<std::mutex> lock(s_ReceivedMessagesLock);
+        s_ReceivedMessages.emplace_back(message);
+        s_ReceivingThread = std::this_thread::get_id();
+    }
+
+    size_t GetReceivedMessageCount()
+    {
+        std::lock_guard<std::mutex> lock(s_ReceivedMessagesLock);
+        return s_ReceivedMessages.size();
+    }
+
+    /// Connects ReceiveMessage to the Logger singleton for the duration of a test.
+    struct ScopedLogCapture
+    {
+        explicit ScopedLogCapture(const LogDeliveryMode deliveryMode)
+        {
+            s_ReceivedMessages.clear();
+            Logger::Instance().SetDeliveryMode(deliveryMode);
+            Logger::Instance().SetManagedCallback(&ReceiveMessage);
+        }
+
+        ~ScopedLogCapture()
+        {
+            Logger::Instance().SetMinLevel(LogLevel::Debug);
+            Logger::Instance().SetRateLimit(LogRateLimiter::k_DefaultBurst, LogRateLimiter::k_DefaultPeriodSeconds);
+            Logger::Instance().SetCategoryMask(static_cast<uint32_t>(LogCategory::All));
+            Logger::Instance().SetManagedCallback(nullptr);
+            Logger::Instance().SetDeliveryMode(LogDeliveryMode::DrainThread);
+        }
+    };
+}
+
+TEST_CASE(LogQueue_PopReturnsPushedMessagesInOrder)
+{
+    LogQueue queue;
+    CHECK(queue.TryPush(LogType::Log, "First", 5));
+    CHECK(queue.TryPush(LogType::Error, "Second message", 6));
+
+    LogQueue::Record record;
+    REQUIRE(queue.TryPop(record));
+    CHECK(record.logType == LogType::Log);
+    CHECK(std::strcmp(record.message, "First") == 0);
+    REQUIRE(queue.TryPop(record));
+    CHECK(record.logType == LogType::Error);
+    CHECK(record.length == 6);
+    CHECK(std::strcmp(record.message, "Second") == 0);
+    CHECK(!queue.TryPop(record));
+}
+
+TEST_CASE(LogQueue_PushToFullQueueIsDropped)
+{
+    LogQueue queue;
+    for (uint32_t i = 0; i < LogQueue::k_Capacity; ++i)
+    {
+        CHECK(queue.TryPush(LogType::Log, "Message", 7));
+    }
+    CHECK(!queue.TryPush(LogType::Log, "Message", 7));
+    CHECK(queue.GetDroppedCount() == 1);
+
+    // Popping one frees room for another one
+    LogQueue::Record record;
+    CHECK(queue.TryPop(record));
+    CHECK(queue.TryPush(LogType::Log, "Message", 7));
+    CHECK(queue.GetDroppedCount() == 1);
+}
+
+TEST_CASE(LogQueue_ConcurrentProducersDoNotLoseOrCorruptMessages)
+{
+    LogQueue queue;
+    constexpr uint32_t k_ProducerCount = 4;
+    constexpr uint32_t k_MessagesPerProducer = 20000;
+
+    std::atomic<bool> producersDone{false};
+    std::vector<std::thread> producers;
+    for (uint32_t producerIndex = 0; producerIndex < k_ProducerCount; ++producerIndex)
+    {
+        producers.emplace_back([&queue, producerIndex]()
+        {
+            for (uint32_t messageIndex = 0; messageIndex < k_MessagesPerProducer; ++messageIndex)
+            {
+                const auto text = std::to_string(producerIndex) + ":" + std::to_string(messageIndex);
+                while (!queue.TryPush(LogType::Log, text.c_str(), text.size()))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every producer's messages must be received in order and intact.
+    uint32_t nextMessageIndex[k_ProducerCount] = {};
+    uint32_t receivedCount = 0;
+    LogQueue::Record record;
+    while (receivedCount < k_ProducerCount * k_MessagesPerProducer)
+    {
+        if (!queue.TryPop(record))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const char* separator = std::strchr(record.message, ':');
+        REQUIRE(separator != nullptr);
+        const auto producerIndex = static_cast<uint32_t>(std::stoul(std::string(static_cast<const char*>(record.message), separator)));
+        const auto messageIndex = static_cast<uint32_t>(std::stoul(std::string(separator + 1)));
+        REQUIRE(producerIndex < k_ProducerCount);
+        CHECK(messageIndex == nextMessageIndex[producerIndex]);
+        nextMessageIndex[producerIndex] = messageIndex + 1;
+        ++receivedCount;
+    }
+
+    for (auto& producer: producers)
+    {
+        producer.join();
+    }
+    CHECK(!queue.TryPop(record));
+}
+
+TEST_CASE(Logger_PolledModeDeliversOnlyOnFlush)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+
+    CLUSTER_LOG(Init) << "Value is " << 42;
+    CLUSTER_LOG_ERROR(Init) << "Something failed";
+    CHECK(GetReceivedMessageCount() == 0);
+
+    CHECK(Logger::Instance().Flush() == 2);
+    REQUIRE(GetReceivedMessageCount() == 2);
+    CHECK(s_ReceivedMessages[0] == "QuadroSync: Value is 42");
+    CHECK(s_ReceivedMessages[1] == "QuadroSync: Something failed");
+    CHECK(s_ReceivingThread == std::this_thread::get_id());
+    CHECK(Logger::Instance().Flush() == 0);
+}
+
+TEST_CASE(Logger_DrainThreadDeliversMessages)
+{
+    const auto testThread = std::this_thread::get_id();
+    ScopedLogCapture capture(LogDeliveryMode::DrainThread);
+
+    CLUSTER_LOG_WARNING(Init) << "From the drain thread";
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (GetReceivedMessageCount() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::lock_guard<std::mutex> lock(s_ReceivedMessagesLock);
+    REQUIRE(s_ReceivedMessages.size() == 1);
+    CHECK(s_ReceivedMessages[0] == "QuadroSync: From the drain thread");
+    CHECK(s_ReceivingThread != testThread);
+}
+
+TEST_CASE(Logger_ChangingCallbackDeliversPendingMessages)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+
+    CLUSTER_LOG(Init) << "Pending";
+    Logger::Instance().SetManagedCallback(nullptr);
+    CHECK(GetReceivedMessageCount() == 1);
+
+    // No callback -> nothing is queued
+    CLUSTER_LOG(Init) << "Nobody listening";
+    Logger::Instance().SetManagedCallback(&ReceiveMessage);
+    CHECK(Logger::Instance().Flush() == 0);
+}
+
+TEST_CASE(Logger_LongMessagesAreTruncated)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+
+    CLUSTER_LOG(Init) << std::string(LogQueue::k_MaxMessageLength * 2, 'a');
+    Logger::Instance().Flush();
+
+    REQUIRE(GetReceivedMessageCount() == 1);
+    const auto& message = s_ReceivedMessages[0];
+    CHECK(message.size() == LogQueue::k_MaxMessageLength);
+    CHECK(message.compare(message.size() - 3, 3, "...") == 0);
+}
+
+TEST_CASE(Logger_DroppedMessagesAreReported)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+
+    const auto droppedBefore = Logger::Instance().GetDroppedMessageCount();
+    for (uint32_t i = 0; i < LogQueue::k_Capacity + 10; ++i)
+    {
+        CLUSTER_LOG(Init) << "Message " << i;
+    }
+    CHECK(Logger::Instance().GetDroppedMessageCount() == droppedBefore + 10);
+
+    CHECK(Logger::Instance().Flush() == LogQueue::k_Capacity + 1);
+    REQUIRE(GetReceivedMessageCount() == LogQueue::k_Capacity + 1);
+    CHECK(s_ReceivedMessages.back() == "QuadroSync: 10 log messages dropped because the log queue was full");
+}
+
+namespace
+{
+    NvAPI_Status TestStatusMessage(const NvAPI_Status status, NvAPI_ShortString text)
+    {
+        if (status != NVAPI_ERROR)
+        {
+            return NVAPI_INVALID_ARGUMENT;
+        }
+        std::strcpy(text, "NVAPI_ERROR");
+        return NVAPI_OK;
+    }
+
+    std::string Format(const LogFormat& format, const std::vector<LogArgument>& arguments)
+    {
+        char buffer[256];
+        const auto length = FormatLogMessage(format, arguments.data(), &TestStatusMessage, buffer, sizeof(buffer));
+        CHECK(length == std::strlen(buffer));
+        return buffer;
+    }
+
+    enum class TestEnum : uint8_t
+    {
+        Value = 200
+    };
+}
+
+TEST_CASE(LogFormat_CountPlaceholdersIsEvaluatedAtCompileTime)
+{
+    static_assert(CountLogPlaceholders("No placeholder") == 0, "");
+    static_assert(CountLogPlaceholders("{}") == 1, "");
+    static_assert(CountLogPlaceholders("a {} b {}{} c {") == 3, "");
+}
+
+TEST_CASE(LogFormat_FormatsEveryKindOfArgument)
+{
+    const LogFormat format{LogType::Log, "{}|{}|{}|{}|{}|{}|{}|{}", 8};
+    const std::vector<LogArgument> arguments = {MakeLogArgument(-12), MakeLogArgument(uint64_t(1) << 40),
+        MakeLogArgument(true), MakeLogArgument(0.5), MakeLogArgument(LogHResult(int32_t(0x887A0005))),
+        MakeLogArgument(NVAPI_ERROR), MakeLogArgument("static"), MakeLogArgument(TestEnum::Value)};
+    CHECK(Format(format, arguments) ==
+        "-12|1099511627776|true|0.5|HRESULT 0x887A0005|NVAPI_ERROR (-1)|static|200");
+}
+
+TEST_CASE(LogFormat_StatusWithoutMessageIsFormattedAsNumber)
+{
+    const LogFormat format{LogType::Error, "Present failed: {}.", 1};
+    CHECK(Format(format, {MakeLogArgument(NVAPI_INVALID_ARGUMENT)}) == "Present failed: NvAPI_Status (-5).");
+}
+
+TEST_CASE(LogFormat_LongMessagesAreTruncated)
+{
+    const LogFormat format{LogType::Log, "0123456789{}", 1};
+    const LogArgument argument = MakeLogArgument(123456);
+    char buffer[13];
+    CHECK(FormatLogMessage(format, &argument, nullptr, buffer, sizeof(buffer)) == 12);
+    CHECK(std::string(buffer) == "012345678912");
+}
+
+TEST_CASE(Logger_DeferredMessagesAreFormattedWhenDelivered)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+    const auto previousStatusMessageFunction = Logger::Instance().GetStatusMessageFunction();
+    Logger::Instance().SetStatusMessageFunction(&TestStatusMessage);
+
+    CLUSTER_LOGF_ERROR(Present, "NvAPI_D3D1x_Present failed: {}", NVAPI_ERROR);
+    CLUSTER_LOGF(Present, "Frame {} of {}", 1, 2u);
+    CLUSTER_LOGF_WARNING(Warmup, "No argument");
+    CHECK(Logger::Instance().Flush() == 3);
+
+    REQUIRE(GetReceivedMessageCount() == 3);
+    CHECK(s_ReceivedMessages[0] == "QuadroSync: NvAPI_D3D1x_Present failed: NVAPI_ERROR (-1)");
+    CHECK(s_ReceivedMessages[1] == "QuadroSync: Frame 1 of 2");
+    CHECK(s_ReceivedMessages[2] == "QuadroSync: No argument");
+
+    Logger::Instance().SetStatusMessageFunction(previousStatusMessageFunction);
+}
+
+TEST_CASE(Logger_MessagesBelowMinLevelAreNotProduced)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+    Logger::Instance().SetMinLevel(LogLevel::Warning);
+
+    bool evaluated = false;
+    const auto evaluate = [&evaluated]() { evaluated = true; return 0; };
+    CLUSTER_LOG_DEBUG(Init) << "Debug " << evaluate();
+    CLUSTER_LOG(Init) << "Info " << evaluate();
+    CLUSTER_LOGF(Present, "Info {}", 1);
+    CHECK(!evaluated);
+    CLUSTER_LOG_WARNING(Init) << "Warning";
+    CLUSTER_LOGF_ERROR(Present, "Error {}", 2);
+
+    CHECK(Logger::Instance().Flush() == 2);
+    REQUIRE(GetReceivedMessageCount() == 2);
+    CHECK(s_ReceivedMessages[0] == "QuadroSync: Warning");
+    CHECK(s_ReceivedMessages[1] == "QuadroSync: Error 2");
+}
+
+TEST_CASE(Logger_MessagesOfMaskedCategoriesAreNotProduced)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+    Logger::Instance().SetCategoryMask(static_cast<uint32_t>(LogCategory::Present) |
+        static_cast<uint32_t>(LogCategory::NvApi));
+
+    CLUSTER_LOG_ERROR(Init) << "Init";
+    CLUSTER_LOG_ERROR(Device) << "Device";
+    CLUSTER_LOGF_ERROR(Warmup, "Warmup");
+    CLUSTER_LOG_ERROR(NvApi) << "NvApi";
+    CLUSTER_LOGF(Present, "Present");
+
+    CHECK(Logger::Instance().Flush() == 2);
+    REQUIRE(GetReceivedMessageCount() == 2);
+    CHECK(s_ReceivedMessages[0] == "QuadroSync: NvApi");
+    CHECK(s_ReceivedMessages[1] == "QuadroSync: Present");
+}
+
+TEST_CASE(Logger_LevelsMapToLogTypes)
+{
+    static_assert(ToLogType(LogLevel::Debug) == LogType::Log, "");
+    static_assert(ToLogType(LogLevel::Info) == LogType::Log, "");
+    static_assert(ToLogType(LogLevel::Warning) == LogType::Warning, "");
+    static_assert(ToLogType(LogLevel::Error) == LogType::Error, "");
+    static_assert(IsLogLevelCompiled(LogLevel::Error), "");
+}
+
+TEST_CASE(Logger_RepeatedMessagesAreSummarized)
+{
+    ScopedLogCapture capture(LogDeliveryMode::Polled);
+    Logger::Instance().SetRateLimit(2, 0);
+
+    const auto suppressedBefore = Logger::Instance().GetSuppressedMessageCount();
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        CLUSTER_LOGF_ERROR(Present, "NvAPI_D3D1x_Present failed: {}", NVAPI_INVALID_ARGUMENT);
+    }
+    CHECK(Logger::Instance().GetSuppressedMessageCount() == suppressedBefore + 8);
+
+    // First flush starts the period of the group (of 0 seconds), the second one ends it.
+    CHECK(Logger::Instance().Flush() == 2);
+    CHECK(Logger::Instance().Flush() == 1);
+    REQUIRE(GetReceivedMessageCount() == 3);
+    CHECK(s_ReceivedMessages[0] == s_ReceivedMessages[1]);
+    CHECK(s_ReceivedMessages[2].find("QuadroSync: Suppressed 8 occurrences of \"NvAPI_D3D1x_Present failed: {}\" with "
+        "NvAPI_Status (-5) in the last ") == 0);
+}
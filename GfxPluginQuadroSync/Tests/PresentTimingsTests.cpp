@@ -0,0 +1,143 @@
+#include "TestFramework.h"
+
+#include "PresentTimings.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    PresentTiming MakeTiming(const uint64_t value)
+    {
+        PresentTiming timing;
+        timing.presentStartTick = value;
+        timing.presentEndTick = value * 2;
+        timing.status = -static_cast<int32_t>(value % 1000);
+        timing.flags = static_cast<uint32_t>(value % 8);
+        return timing;
+    }
+}
+
+TEST_CASE(PresentTimingRing_ReadReturnsPushedEntriesInOrder)
+{
+    PresentTimingRing ring;
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        ring.Push(MakeTiming(i + 1));
+    }
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    PresentTiming buffer[16];
+    REQUIRE(ring.Read(cursor, buffer, 16, dropped) == 10);
+    CHECK(cursor == 10);
+    CHECK(dropped == 0);
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        const auto expected = MakeTiming(i + 1);
+        CHECK(buffer[i].presentIndex == i);
+        CHECK(buffer[i].presentStartTick == expected.presentStartTick);
+        CHECK(buffer[i].presentEndTick == expected.presentEndTick);
+        CHECK(buffer[i].status == expected.status);
+        CHECK(buffer[i].flags == expected.flags);
+    }
+
+    // Nothing new
+    CHECK(ring.Read(cursor, buffer, 16, dropped) == 0);
+}
+
+TEST_CASE(PresentTimingRing_ReadIsLimitedByCapacity)
+{
+    PresentTimingRing ring;
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        ring.Push(MakeTiming(i));
+    }
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    PresentTiming buffer[4];
+    CHECK(ring.Read(cursor, buffer, 4, dropped) == 4);
+    CHECK(ring.Read(cursor, buffer, 4, dropped) == 4);
+    CHECK(buffer[0].presentIndex == 4);
+    CHECK(ring.Read(cursor, buffer, 4, dropped) == 2);
+    CHECK(dropped == 0);
+}
+
+TEST_CASE(PresentTimingRing_OverwrittenEntriesAreCountedAsDropped)
+{
+    PresentTimingRing ring;
+    const uint64_t pushCount = PresentTimingRing::k_Capacity + 100;
+    for (uint64_t i = 0; i < pushCount; ++i)
+    {
+        ring.Push(MakeTiming(i));
+    }
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    std::vector<PresentTiming> buffer(PresentTimingRing::k_Capacity);
+    CHECK(ring.Read(cursor, buffer.data(), PresentTimingRing::k_Capacity, dropped) == PresentTimingRing::k_Capacity);
+    CHECK(dropped == 100);
+    CHECK(buffer[0].presentIndex == 100);
+    CHECK(buffer[0].presentStartTick == 100);
+}
+
+TEST_CASE(PresentTimingRing_ConsumersHaveIndependentCursors)
+{
+    PresentTimingRing ring;
+    ring.Push(MakeTiming(1));
+    ring.Push(MakeTiming(2));
+
+    uint64_t firstCursor = 0;
+    uint64_t secondCursor = 0;
+    uint64_t dropped = 0;
+    PresentTiming buffer[4];
+    CHECK(ring.Read(firstCursor, buffer, 4, dropped) == 2);
+    ring.Push(MakeTiming(3));
+    CHECK(ring.Read(firstCursor, buffer, 4, dropped) == 1);
+    CHECK(ring.Read(secondCursor, buffer, 4, dropped) == 3);
+}
+
+TEST_CASE(PresentTimingRing_ConcurrentReadsNeverReturnTornEntries)
+{
+    PresentTimingRing ring;
+    std::atomic<bool> producerDone{false};
+    std::thread producer([&ring, &producerDone]()
+        {
+            for (uint64_t i = 0; i < 200000; ++i)
+            {
+                ring.Push(MakeTiming(i));
+            }
+            producerDone = true;
+        });
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    uint64_t readCount = 0;
+    bool allConsistent = true;
+    PresentTiming buffer[64];
+    for (;;)
+    {
+        const bool wasDone = producerDone;
+        const auto count = ring.Read(cursor, buffer, 64, dropped);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto expected = MakeTiming(buffer[i].presentIndex);
+            allConsistent &= buffer[i].presentStartTick == expected.presentStartTick &&
+                buffer[i].presentEndTick == expected.presentEndTick && buffer[i].status == expected.status &&
+                buffer[i].flags == expected.flags;
+        }
+        readCount += count;
+        if (wasDone && count == 0)
+        {
+            break;
+        }
+    }
+    producer.join();
+
+    CHECK(allConsistent);
+    CHECK(readCount + dropped == 200000);
+}
@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "PresentWatchdog.h"
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::BarrierWarmedUp;
+using QuadroSyncTests::SimulatedClient;
+
+namespace
+{
+    // 1 tick per microsecond
+    constexpr uint64_t k_TicksPerSecond = 1000000;
+    // Present start tick the performance counter read by the watchdog thread never reaches (so that only the test
+    // detects stalls).
+    constexpr uint64_t k_FarFutureTick = 1ull << 62;
+}
+
+TEST_CASE(PresentWatchdog_NoStallWhenStopped)
+{
+    PresentWatchdog watchdog(k_TicksPerSecond);
+    CHECK(!watchdog.IsRunning());
+    watchdog.PresentStarted(1000);
+    CHECK(!watchdog.Check(1000000000));
+    CHECK(!watchdog.PresentEnded(1000000000));
+    CHECK(watchdog.GetStallCount() == 0);
+}
+
+TEST_CASE(PresentWatchdog_DetectsStallOnce)
+{
+    PresentWatchdog watchdog(k_TicksPerSecond);
+    watchdog.Start(60, nullptr);
+    REQUIRE(watchdog.IsRunning());
+
+    // Not presenting
+    CHECK(!watchdog.Check(k_FarFutureTick));
+
+    watchdog.PresentStarted(k_FarFutureTick);
+    CHECK(!watchdog.Check(k_FarFutureTick + 59999));
+    CHECK(!watchdog.IsStalled());
+    CHECK(watchdog.Check(k_FarFutureTick + 60000));
+    CHECK(watchdog.IsStalled());
+    CHECK(watchdog.GetStallCount() == 1);
+
+    // Reported only once per present
+    CHECK(!watchdog.Check(k_FarFutureTick + 70000));
+    CHECK(watchdog.GetStallCount() == 1);
+
+    CHECK(watchdog.PresentEnded(k_FarFutureTick + 75000));
+    CHECK(!watchdog.IsStalled());
+    CHECK(watchdog.GetLastStallTicks() == 75000);
+
+    // Next present is not stalled
+    watchdog.PresentStarted(k_FarFutureTick + 80000);
+    CHECK(!watchdog.PresentEnded(k_FarFutureTick + 81000));
+    CHECK(watchdog.GetLastStallTicks() == 75000);
+    CHECK(watchdog.GetStallCount() == 1);
+}
+
+TEST_CASE(PresentWatchdog_ThreadCallsCallback)
+{
+    PresentWatchdog watchdog(k_TicksPerSecond);
+    std::atomic<uint32_t> callbackCount{0};
+    watchdog.Start(5, [&callbackCount] { ++callbackCount; });
+
+    // Started long ago according to the performance counter
+    watchdog.PresentStarted(1);
+    const auto waitStart = std::chrono::steady_clock::now();
+    while (callbackCount.load() == 0 && std::chrono::steady_clock::now() - waitStart < std::chrono::seconds(5))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(callbackCount.load() == 1);
+    CHECK(watchdog.IsStalled());
+    watchdog.Stop();
+    CHECK(!watchdog.IsRunning());
+    CHECK(watchdog.PresentEnded(2));
+}
+
+TEST_CASE(PresentWatchdog_SwapGroupClientSkipsSynchronizationAfterStall)
+{
+    auto config = SimulatedClient::NoWaitConfig();
+    config.presentLatency = std::chrono::milliseconds(100);
+    SimulatedClient simulated(config);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    simulated.client->SetBarrierWarmupCallback(&BarrierWarmedUp);
+    simulated.client->EnableStallWatchdog(10, true);
+
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetStallWatchdog().GetStallCount() == 1);
+    CHECK(simulated.client->GetStallWatchdog().GetLastStallTicks() > 0);
+
+    // Frame following the stall is presented by Unity
+    CHECK(!simulated.client->Render(&simulated.device));
+
+    PresentTiming timings[2];
+    uint64_t readCursor = 0;
+    uint64_t dropped = 0;
+    REQUIRE(simulated.client->GetPresentTimings().Read(readCursor, timings, 2, dropped) == 2);
+    CHECK((timings[0].flags & static_cast<uint32_t>(PresentTimingFlags::Stalled)) != 0);
+    CHECK(timings[1].flags == static_cast<uint32_t>(PresentTimingFlags::SkippedSynchronization));
+    simulated.client->EnableStallWatchdog(0, false);
+}
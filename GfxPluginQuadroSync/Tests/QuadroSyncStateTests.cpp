@@ -0,0 +1,161 @@
+#include "TestFramework.h"
+
+#include "QuadroSyncState.h"
+#include "SeqLock.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    /// Value whose words are always all equal when consistent.
+    struct TornDetector
+    {
+        uint64_t words[6];
+    };
+}
+
+TEST_CASE(SeqLock_ReadWhatWasWritten)
+{
+    SeqLock<QuadroSyncState> seqLock;
+    CHECK(seqLock.GetSequence() == 0);
+    CHECK(seqLock.Read().size == sizeof(QuadroSyncState));
+
+    QuadroSyncState state;
+    state.swapGroupId = 2;
+    state.presentedFramesSuccess = 42;
+    seqLock.Write(state);
+    CHECK(seqLock.GetSequence() == 2);
+
+    seqLock.Update([](QuadroSyncState& toModify) { ++toModify.presentedFramesSuccess; });
+    CHECK(seqLock.GetSequence() == 4);
+
+    QuadroSyncState read;
+    REQUIRE(seqLock.TryRead(read));
+    CHECK(read.swapGroupId == 2);
+    CHECK(read.presentedFramesSuccess == 43);
+}
+
+TEST_CASE(SeqLock_LayoutIsSequenceFollowedByValue)
+{
+    SeqLock<QuadroSyncState> seqLock;
+    QuadroSyncState state;
+    state.swapBarrierId = 7;
+    seqLock.Write(state);
+
+    static_assert(sizeof(SeqLock<QuadroSyncState>) == sizeof(uint64_t) + sizeof(QuadroSyncState),
+        "Unexpected SeqLock layout");
+    const auto* const memory = reinterpret_cast<const unsigned char*>(&seqLock);
+    uint64_t sequence;
+    std::memcpy(&sequence, memory, sizeof(sequence));
+    CHECK(sequence == 2);
+    QuadroSyncState mirrored;
+    std::memcpy(&mirrored, memory + sizeof(uint64_t), sizeof(mirrored));
+    CHECK(mirrored.swapBarrierId == 7);
+}
+
+TEST_CASE(SeqLock_ReadersNeverSeeTornValues)
+{
+    SeqLock<TornDetector> seqLock;
+    std::atomic<bool> stop{false};
+    std::atomic<uint32_t> tornCount{0};
+    std::atomic<uint64_t> readCount{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto value = seqLock.Read();
+                for (const auto word : value.words)
+                {
+                    if (word != value.words[0])
+                    {
+                        ++tornCount;
+                        break;
+                    }
+                }
+                ++readCount;
+            }
+        });
+    }
+
+    // Two writers to also validate writers are serialized
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 2; ++i)
+    {
+        writers.emplace_back([&seqLock]
+        {
+            for (int update = 0; update < 20000; ++update)
+            {
+                seqLock.Update([](TornDetector& value)
+                {
+                    for (auto& word : value.words)
+                    {
+                        ++word;
+                    }
+                });
+            }
+        });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    stop.store(true);
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    CHECK(tornCount.load() == 0);
+    CHECK(readCount.load() > 0);
+    const auto finalValue = seqLock.Read();
+    CHECK(finalValue.words[0] == 40000);
+    CHECK(finalValue.words[5] == 40000);
+    CHECK(seqLock.GetSequence() == 80000);
+}
+
+TEST_CASE(QuadroSyncState_CopyTruncatedToCallerSize)
+{
+    QuadroSyncState source;
+    source.capabilities = static_cast<uint64_t>(QuadroSyncStateCapabilities::PresentCounters |
+        QuadroSyncStateCapabilities::LogCounters);
+    source.initializationState = 1;
+    source.presentedFramesSuccess = 100;
+    source.droppedLogMessages = 3;
+
+    // Caller knowing every field
+    QuadroSyncState complete;
+    complete.size = sizeof(QuadroSyncState);
+    REQUIRE(CopyQuadroSyncState(source, &complete));
+    CHECK(complete.size == sizeof(QuadroSyncState));
+    CHECK(complete.version == QuadroSyncState::k_Version);
+    CHECK(complete.capabilities == source.capabilities);
+    CHECK(complete.presentedFramesSuccess == 100);
+    CHECK(complete.droppedLogMessages == 3);
+
+    // Caller built against an older, smaller, version of the struct
+    QuadroSyncState partial;
+    partial.presentedFramesSuccess = 0xBAD;
+    partial.droppedLogMessages = 0xBAD;
+    partial.size = offsetof(QuadroSyncState, presentedFramesFailed);
+    REQUIRE(CopyQuadroSyncState(source, &partial));
+    CHECK(partial.size == offsetof(QuadroSyncState, presentedFramesFailed));
+    CHECK(partial.initializationState == 1);
+    CHECK(partial.presentedFramesSuccess == 100);
+    CHECK(partial.droppedLogMessages == 0xBAD);
+
+    // Too small for the header
+    QuadroSyncState tooSmall;
+    tooSmall.size = k_QuadroSyncStateHeaderSize - 1;
+    CHECK(!CopyQuadroSyncState(source, &tooSmall));
+    CHECK(tooSmall.size == k_QuadroSyncStateHeaderSize - 1);
+}
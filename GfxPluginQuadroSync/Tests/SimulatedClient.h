@@ -0,0 +1,53 @@
+#pragma once
+
+#include "FakeGraphicsDevice.h"
+
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+#include <memory>
+
+namespace QuadroSyncTests
+{
+    /// Barrier warmup callback concluding the warmup at the first present.
+    inline GfxQuadroSync::PluginCSwapGroupClient::BarrierWarmupAction UNITY_INTERFACE_API BarrierWarmedUp()
+    {
+        return GfxQuadroSync::PluginCSwapGroupClient::BarrierWarmupAction::BarrierWarmedUp;
+    }
+
+    /// PluginCSwapGroupClient using a SimulatedSwapGroupApi (that does not wait for vertical blanks by default).
+    struct SimulatedClient
+    {
+        explicit SimulatedClient(GfxQuadroSync::SimulatedSwapGroupApi::Config config = NoWaitConfig())
+        {
+            auto simulatedApi = std::make_unique<GfxQuadroSync::SimulatedSwapGroupApi>(config);
+            api = simulatedApi.get();
+            client = std::make_unique<GfxQuadroSync::PluginCSwapGroupClient>(std::move(simulatedApi));
+        }
+
+        static GfxQuadroSync::SimulatedSwapGroupApi::Config NoWaitConfig()
+        {
+            GfxQuadroSync::SimulatedSwapGroupApi::Config config;
+            config.refreshRateHz = 0;
+            return config;
+        }
+
+        GfxQuadroSync::PluginCSwapGroupClient::InitializeStatus Initialize()
+        {
+            client->SetupWorkStation();
+            return client->Initialize(device.GetDevice(), device.GetSwapChain());
+        }
+
+        /// Initialize and present the first frame, warming up the barrier with BarrierWarmedUp (that is left set).
+        bool InitializeAndWarmUp()
+        {
+            client->SetBarrierWarmupCallback(&BarrierWarmedUp);
+            return Initialize() == GfxQuadroSync::PluginCSwapGroupClient::InitializeStatus::Success &&
+                client->Render(&device) && !client->NeedsBarrierWarmup();
+        }
+
+        GfxQuadroSync::SimulatedSwapGroupApi* api;
+        std::unique_ptr<GfxQuadroSync::PluginCSwapGroupClient> client;
+        FakeGraphicsDevice device;
+    };
+}
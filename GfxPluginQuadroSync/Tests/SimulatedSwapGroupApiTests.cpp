@@ -0,0 +1,91 @@
+#include "TestFramework.h"
+#include "FakeGraphicsDevice.h"
+
+#include "SimulatedSwapGroupApi.h"
+
+#include <chrono>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::FakeComObject;
+
+namespace
+{
+    IUnknown* const k_Device = FakeComObject<IUnknown>(0x1000);
+    IDXGISwapChain* const k_SwapChain = FakeComObject<IDXGISwapChain>(0x2000);
+}
+
+TEST_CASE(SimulatedSwapGroupApi_RequiresInitialize)
+{
+    SimulatedSwapGroupApi api;
+    NvU32 maxGroups, maxBarriers;
+    CHECK(api.QueryMaxSwapGroup(k_Device, &maxGroups, &maxBarriers) == NVAPI_API_NOT_INITIALIZED);
+    CHECK(api.Initialize() == NVAPI_OK);
+    CHECK(api.QueryMaxSwapGroup(k_Device, &maxGroups, &maxBarriers) == NVAPI_OK);
+}
+
+TEST_CASE(SimulatedSwapGroupApi_ValidatesGroupAndBarrier)
+{
+    SimulatedSwapGroupApi::Config config;
+    config.maxSwapGroups = 2;
+    config.maxSwapBarriers = 1;
+    SimulatedSwapGroupApi api(config);
+    api.Initialize();
+
+    NvU32 maxGroups, maxBarriers;
+    REQUIRE(api.QueryMaxSwapGroup(k_Device, &maxGroups, &maxBarriers) == NVAPI_OK);
+    CHECK(maxGroups == 2);
+    CHECK(maxBarriers == 1);
+
+    CHECK(api.BindSwapBarrier(k_Device, 1, 1) == NVAPI_INVALID_ARGUMENT); // Not in group 1
+    CHECK(api.JoinSwapGroup(k_Device, k_SwapChain, 3, true) == NVAPI_INVALID_ARGUMENT);
+    CHECK(api.JoinSwapGroup(k_Device, k_SwapChain, 2, true) == NVAPI_OK);
+    CHECK(api.BindSwapBarrier(k_Device, 2, 2) == NVAPI_INVALID_ARGUMENT);
+    CHECK(api.BindSwapBarrier(k_Device, 2, 1) == NVAPI_OK);
+
+    NvU32 group, barrier;
+    REQUIRE(api.QuerySwapGroup(k_Device, k_SwapChain, &group, &barrier) == NVAPI_OK);
+    CHECK(group == 2);
+    CHECK(barrier == 1);
+
+    // Leaving the group also leaves the barrier
+    CHECK(api.JoinSwapGroup(k_Device, k_SwapChain, 0, false) == NVAPI_OK);
+    REQUIRE(api.QuerySwapGroup(k_Device, k_SwapChain, &group, &barrier) == NVAPI_OK);
+    CHECK(group == 0);
+    CHECK(barrier == 0);
+}
+
+TEST_CASE(SimulatedSwapGroupApi_InjectedFailuresAreConsumed)
+{
+    SimulatedSwapGroupApi::Config config;
+    config.refreshRateHz = 0;
+    SimulatedSwapGroupApi api(config);
+    api.Initialize();
+    api.InjectFailure(SimulatedSwapGroupApi::Call::Present, NVAPI_DEVICE_BUSY, 2);
+
+    CHECK(api.Present(k_Device, k_SwapChain, 1, 0) == NVAPI_DEVICE_BUSY);
+    CHECK(api.Present(k_Device, k_SwapChain, 1, 0) == NVAPI_DEVICE_BUSY);
+    CHECK(api.Present(k_Device, k_SwapChain, 1, 0) == NVAPI_OK);
+    CHECK(api.GetCallCount(SimulatedSwapGroupApi::Call::Present) == 3);
+}
+
+TEST_CASE(SimulatedSwapGroupApi_PresentWaitsForVerticalBlank)
+{
+    SimulatedSwapGroupApi::Config config;
+    config.refreshRateHz = 200;
+    SimulatedSwapGroupApi api(config);
+    api.Initialize();
+    api.ResetFrameCount(k_Device);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(api.Present(k_Device, k_SwapChain, 1, 0) == NVAPI_OK);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // 4 presents at 200 Hz take at least 3 full refresh periods (first one might be right at a vblank).
+    CHECK(elapsed >= std::chrono::milliseconds(15));
+    NvU32 frameCount = 0;
+    CHECK(api.QueryFrameCount(k_Device, &frameCount) == NVAPI_OK);
+    CHECK(frameCount >= 4);
+}
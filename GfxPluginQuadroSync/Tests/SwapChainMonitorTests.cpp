@@ -0,0 +1,120 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+#include "SwapChainMonitor.h"
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::FakeComObject;
+using QuadroSyncTests::SimulatedClient;
+using Call = SimulatedSwapGroupApi::Call;
+
+namespace
+{
+    SwapChainIdentity TestIdentity(const uintptr_t swapChain, const uint32_t width, const uint32_t height)
+    {
+        SwapChainIdentity identity;
+        identity.swapChain = FakeComObject<IDXGISwapChain>(swapChain);
+        identity.width = width;
+        identity.height = height;
+        identity.format = 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+        identity.bufferCount = 2;
+        identity.windowed = 1;
+        return identity;
+    }
+}
+
+TEST_CASE(SwapChainMonitor_DetectsRecreatedAndResizedSwapChains)
+{
+    SwapChainMonitor monitor;
+    const auto initial = TestIdentity(0x2000, 1920, 1080);
+    CHECK(monitor.HasChanged(initial));
+    CHECK(monitor.Observe(initial, 10) == SwapChainChange::None);
+    CHECK(!monitor.HasChanged(initial));
+    CHECK(!monitor.IsOutOfSync());
+    CHECK(monitor.GetReport().changeCount == 0);
+
+    // Resized
+    const auto resized = TestIdentity(0x2000, 3840, 2160);
+    CHECK(monitor.HasChanged(resized));
+    CHECK(monitor.Observe(resized, 100) == SwapChainChange::Resized);
+    CHECK(monitor.IsOutOfSync());
+    monitor.Resynchronized(150);
+    CHECK(!monitor.IsOutOfSync());
+    CHECK(monitor.GetReport().lastChangeTick == 100);
+    CHECK(monitor.GetReport().lastResynchronizedTick == 150);
+    CHECK(monitor.GetReport().lastOutOfSyncTicks == 50);
+
+    // Recreated (and resized) twice before being synchronized again: a single out of sync period
+    CHECK(monitor.Observe(TestIdentity(0x3000, 3840, 2160), 200) == SwapChainChange::Recreated);
+    const auto recreated = TestIdentity(0x4000, 1920, 1080);
+    CHECK(monitor.Observe(recreated, 220) ==
+        static_cast<SwapChainChange>(static_cast<uint32_t>(SwapChainChange::Recreated) |
+            static_cast<uint32_t>(SwapChainChange::Resized)));
+    CHECK(monitor.GetReport().lastOutOfSyncTicks == 0);
+    monitor.Resynchronized(300);
+    monitor.Resynchronized(400);
+
+    const auto& report = monitor.GetReport();
+    CHECK(report.changeCount == 3);
+    CHECK(report.outOfSync == 0);
+    CHECK(report.lastChangeTick == 200);
+    CHECK(report.lastOutOfSyncTicks == 100);
+    CHECK(report.totalOutOfSyncTicks == 150);
+}
+
+TEST_CASE(SwapChainMonitor_SwapGroupClientRejoinsRecreatedSwapChain)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.InitializeAndWarmUp());
+
+    // First look at the swap chain, nothing to rejoin
+    const auto initial = TestIdentity(0x2000, 1920, 1080);
+    CHECK(simulated.client->HasSwapChainChanged(initial));
+    CHECK(simulated.client->OnSwapChainChanged(&simulated.device, initial) == SwapChainChange::None);
+    CHECK(!simulated.client->HasSwapChainChanged(initial));
+    const auto joinCount = simulated.api->GetCallCount(Call::JoinSwapGroup);
+    const auto bindCount = simulated.api->GetCallCount(Call::BindSwapBarrier);
+
+    // Resized, but still a member of the swap group: synchronized right away
+    const auto resized = TestIdentity(0x2000, 3840, 2160);
+    CHECK(simulated.client->OnSwapChainChanged(&simulated.device, resized) == SwapChainChange::Resized);
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount);
+    CHECK(simulated.api->GetCallCount(Call::BindSwapBarrier) == bindCount);
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+    CHECK(simulated.client->GetSwapChainChangeReport().outOfSync == 0);
+
+    // Recreated: the new swap chain joins the swap group and barrier and the barrier is warmed up again
+    const auto recreated = TestIdentity(0x3000, 3840, 2160);
+    CHECK(simulated.client->OnSwapChainChanged(&simulated.device, recreated) == SwapChainChange::Recreated);
+    CHECK(simulated.device.GetSwapChain() == recreated.swapChain);
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount + 1);
+    CHECK(simulated.api->GetCallCount(Call::BindSwapBarrier) == bindCount + 1);
+    NvU32 groupId = 0;
+    NvU32 barrierId = 0;
+    REQUIRE(simulated.api->QuerySwapGroup(simulated.device.GetDevice(), recreated.swapChain, &groupId, &barrierId) ==
+        NVAPI_OK);
+    CHECK(groupId == 1);
+    CHECK(barrierId == 1);
+    CHECK(simulated.client->NeedsBarrierWarmup());
+    CHECK(simulated.client->GetSwapChainChangeReport().outOfSync == 1);
+
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+    const auto report = simulated.client->GetSwapChainChangeReport();
+    CHECK(report.changeCount == 2);
+    CHECK(report.lastChange == static_cast<uint32_t>(SwapChainChange::Recreated));
+    CHECK(report.lastRejoinStatus == static_cast<uint32_t>(PluginCSwapGroupClient::ReconfigureStatus::Success));
+    CHECK(report.outOfSync == 0);
+    CHECK(report.lastResynchronizedTick >= report.lastChangeTick);
+    CHECK(report.lastOutOfSyncTicks == report.lastResynchronizedTick - report.lastChangeTick);
+
+    // Failing to rejoin keeps the node out of sync
+    simulated.api->InjectFailure(Call::JoinSwapGroup, NVAPI_ERROR);
+    CHECK(simulated.client->OnSwapChainChanged(&simulated.device, TestIdentity(0x4000, 3840, 2160)) ==
+        SwapChainChange::Recreated);
+    CHECK(simulated.client->GetSwapChainChangeReport().lastRejoinStatus ==
+        static_cast<uint32_t>(PluginCSwapGroupClient::ReconfigureStatus::FailedToJoinSwapGroup));
+    CHECK(simulated.client->GetSwapChainChangeReport().outOfSync == 1);
+}
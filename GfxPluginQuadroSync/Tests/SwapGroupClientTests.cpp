@@ -0,0 +1,348 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::SimulatedClient;
+
+namespace
+{
+    using Call = SimulatedSwapGroupApi::Call;
+
+    uint32_t s_WarmupCallbackCount = 0;
+    uint32_t s_RepeatsBeforeWarmedUp = 0;
+
+    PluginCSwapGroupClient::BarrierWarmupAction UNITY_INTERFACE_API RepeatThenWarmedUp()
+    {
+        ++s_WarmupCallbackCount;
+        return s_WarmupCallbackCount <= s_RepeatsBeforeWarmedUp ?
+            PluginCSwapGroupClient::BarrierWarmupAction::RepeatPresent :
+            PluginCSwapGroupClient::BarrierWarmupAction::BarrierWarmedUp;
+    }
+}
+
+TEST_CASE(SwapGroupClient_InitializeJoinsGroupAndBarrier)
+{
+    SimulatedClient simulated;
+    CHECK(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+    CHECK(simulated.api->GetCallCount(Call::SetupWorkstationSwapGroupFeature) == 1);
+}
+
+TEST_CASE(SwapGroupClient_InitializeWithoutSwapGroups)
+{
+    SimulatedSwapGroupApi::Config config = SimulatedClient::NoWaitConfig();
+    config.maxSwapGroups = 0;
+    SimulatedClient simulated(config);
+    CHECK(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::NoSwapGroupDetected);
+}
+
+TEST_CASE(SwapGroupClient_InitializeFailingToJoin)
+{
+    SimulatedClient simulated;
+    simulated.api->InjectFailure(Call::JoinSwapGroup, NVAPI_ERROR);
+    CHECK(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::FailedToJoinSwapGroup);
+}
+
+TEST_CASE(SwapGroupClient_RenderWarmsUpBarrierThenPresentsOnce)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    s_WarmupCallbackCount = 0;
+    s_RepeatsBeforeWarmedUp = 3;
+    simulated.client->SetBarrierWarmupCallback(&RepeatThenWarmedUp);
+
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.api->GetCallCount(Call::Present) == 4);
+    CHECK(simulated.device.initiatePresentRepeatsCount == 1);
+    CHECK(simulated.device.prepareSinglePresentRepeatCount == 3);
+    CHECK(simulated.device.concludePresentRepeatsCount == 1);
+
+    // Barrier is warmed up, next frames are presented once without calling the callback
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.api->GetCallCount(Call::Present) == 5);
+    CHECK(s_WarmupCallbackCount == 4);
+    CHECK(simulated.client->GetPresentSuccessCount() == 2);
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    PresentTiming timings[8];
+    REQUIRE(simulated.client->GetPresentTimings().Read(cursor, timings, 8, dropped) == 5);
+    CHECK(timings[0].flags == static_cast<uint32_t>(PresentTimingFlags::BarrierWarmup));
+    CHECK(timings[1].flags ==
+        static_cast<uint32_t>(PresentTimingFlags::BarrierWarmup | PresentTimingFlags::RepeatedPresent));
+    CHECK(timings[4].flags == 0);
+    CHECK(timings[4].presentEndTick >= timings[4].presentStartTick);
+}
+
+TEST_CASE(SwapGroupClient_RenderCountsFailures)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    simulated.api->InjectFailure(Call::Present, NVAPI_ERROR);
+
+    CHECK(!simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetPresentFailureCount() == 1);
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetPresentSuccessCount() == 1);
+}
+
+TEST_CASE(SwapGroupClient_SkipSynchronizedPresentOfNextFrame)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    simulated.client->SkipSynchronizedPresentOfNextFrame();
+    CHECK(!simulated.client->Render(&simulated.device));
+    CHECK(simulated.api->GetCallCount(Call::Present) == 0);
+
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    PresentTiming timing;
+    REQUIRE(simulated.client->GetPresentTimings().Read(cursor, &timing, 1, dropped) == 1);
+    CHECK(timing.flags == static_cast<uint32_t>(PresentTimingFlags::SkippedSynchronization));
+}
+
+TEST_CASE(SwapGroupClient_EnableSystemLeavesAndRejoins)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    simulated.client->EnableSystem(simulated.device.GetDevice(), simulated.device.GetSwapChain(), false);
+    CHECK(simulated.client->GetSwapGroupId() == 0);
+
+    simulated.client->EnableSystem(simulated.device.GetDevice(), simulated.device.GetSwapChain(), true);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+
+    simulated.client->Dispose(simulated.device.GetDevice(), simulated.device.GetSwapChain());
+    CHECK(simulated.client->GetSwapGroupId() == 0);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+}
+
+TEST_CASE(SwapGroupClient_QueryFrameCountIsThrottled)
+{
+    SimulatedSwapGroupApi::Config config = SimulatedClient::NoWaitConfig();
+    config.refreshRateHz = 1000;
+    SimulatedClient simulated(config);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    const auto queriesAfterInitialize = simulated.api->GetCallCount(Call::QueryFrameCount);
+
+    for (uint32_t i = 0; i < FrameCountService::k_DefaultSamplesBeforeThrottle * 2; ++i)
+    {
+        simulated.client->QueryFrameCountEstimate(simulated.device.GetDevice());
+    }
+    CHECK(simulated.api->GetCallCount(Call::QueryFrameCount) - queriesAfterInitialize ==
+        FrameCountService::k_DefaultSamplesBeforeThrottle);
+}
+
+TEST_CASE(SwapGroupClient_QueryFrameCountReturnsHardwareValue)
+{
+    SimulatedSwapGroupApi::Config config = SimulatedClient::NoWaitConfig();
+    config.refreshRateHz = 1000;
+    SimulatedClient simulated(config);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    // Past the point where QueryFrameCountEstimate stops sampling the hardware
+    for (uint32_t i = 0; i < FrameCountService::k_DefaultSamplesBeforeThrottle * 2; ++i)
+    {
+        simulated.client->QueryFrameCountEstimate(simulated.device.GetDevice());
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto queriesBefore = simulated.api->GetCallCount(Call::QueryFrameCount);
+        const auto hardwareBefore = simulated.api->GetFrameCount();
+        const auto frameCount = simulated.client->QueryFrameCount(simulated.device.GetDevice());
+        const auto hardwareAfter = simulated.api->GetFrameCount();
+        CHECK(simulated.api->GetCallCount(Call::QueryFrameCount) == queriesBefore + 1);
+        CHECK(hardwareBefore <= frameCount && frameCount <= hardwareAfter);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+TEST_CASE(SwapGroupClient_EnableSystemUnbindsBarrier)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    simulated.client->EnableSystem(simulated.device.GetDevice(), simulated.device.GetSwapChain(), false);
+    CHECK(simulated.client->GetSwapGroupId() == 0);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+}
+
+TEST_CASE(SwapGroupClient_ReconfigureOnlyMakesNeededCalls)
+{
+    SimulatedSwapGroupApi::Config config = SimulatedClient::NoWaitConfig();
+    config.maxSwapBarriers = 2;
+    SimulatedClient simulated(config);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    simulated.client->SetBarrierWarmupCallback(&RepeatThenWarmedUp);
+    s_WarmupCallbackCount = 0;
+    s_RepeatsBeforeWarmedUp = 0;
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+
+    auto target = simulated.client->GetConfiguration();
+    const auto joinCount = simulated.api->GetCallCount(Call::JoinSwapGroup);
+    const auto bindCount = simulated.api->GetCallCount(Call::BindSwapBarrier);
+
+    // Nothing to change: membership is queried but no join or bind, and the barrier stays warm
+    CHECK(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::Success);
+    simulated.client->EnableSwapGroup(simulated.device.GetDevice(), simulated.device.GetSwapChain(), true);
+    simulated.client->EnableSwapBarrier(simulated.device.GetDevice(), simulated.device.GetSwapChain(), true);
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount);
+    CHECK(simulated.api->GetCallCount(Call::BindSwapBarrier) == bindCount);
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+
+    // Changing barrier: unbind and bind to the new one (no join), barrier needs to be warmed up again
+    target.swapBarrierId = 2;
+    target.hardwareFrameCounter = false;
+    CHECK(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::Success);
+    CHECK(simulated.api->GetCallCount(Call::JoinSwapGroup) == joinCount);
+    CHECK(simulated.api->GetCallCount(Call::BindSwapBarrier) == bindCount + 2);
+    CHECK(simulated.client->GetSwapBarrierId() == 2);
+    CHECK(!simulated.client->GetConfiguration().hardwareFrameCounter);
+    CHECK(simulated.client->NeedsBarrierWarmup());
+
+    // Invalid
+    target.swapGroupId = 0;
+    CHECK(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::InvalidConfiguration);
+}
+
+TEST_CASE(SwapGroupClient_RenderWarmsUpBarrierFromPostedActions)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    s_WarmupCallbackCount = 0;
+    simulated.client->SetBarrierWarmupCallback(&RepeatThenWarmedUp);
+    simulated.client->SetBarrierWarmupActionSlotEnabled(true);
+
+    // Nothing posted: every frame is presented once and the warmup continues (repeats are only initiated once)
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetBarrierWarmupPresentSequence() == 2);
+    CHECK(simulated.device.initiatePresentRepeatsCount == 1);
+    CHECK(simulated.device.prepareSinglePresentRepeatCount == 0);
+    CHECK(simulated.client->NeedsBarrierWarmup());
+
+    // Repeats until an other thread, following the progress of the warmup, posts that the barrier is warmed up
+    simulated.client->PostBarrierWarmupAction(PluginCSwapGroupClient::BarrierWarmupAction::RepeatPresent);
+    std::thread poster([&simulated]
+    {
+        while (simulated.client->GetBarrierWarmupPresentSequence() < 10)
+        {
+            std::this_thread::yield();
+        }
+        simulated.client->PostBarrierWarmupAction(PluginCSwapGroupClient::BarrierWarmupAction::BarrierWarmedUp);
+    });
+    CHECK(simulated.client->Render(&simulated.device));
+    poster.join();
+    const auto warmupPresents = simulated.client->GetBarrierWarmupPresentSequence();
+    CHECK(warmupPresents >= 10);
+    CHECK(simulated.device.initiatePresentRepeatsCount == 1);
+    CHECK(simulated.device.prepareSinglePresentRepeatCount == warmupPresents - 3);
+    CHECK(simulated.device.concludePresentRepeatsCount == 1);
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+    CHECK(s_WarmupCallbackCount == 0);
+
+    // BarrierWarmedUp was consumed: the next warmup starts with nothing posted
+    simulated.client->EnableSwapBarrier(simulated.device.GetDevice(), simulated.device.GetSwapChain(), false);
+    simulated.client->EnableSwapBarrier(simulated.device.GetDevice(), simulated.device.GetSwapChain(), true);
+    REQUIRE(simulated.client->NeedsBarrierWarmup());
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.client->GetBarrierWarmupPresentSequence() == warmupPresents + 1);
+    CHECK(simulated.device.initiatePresentRepeatsCount == 2);
+    CHECK(simulated.client->NeedsBarrierWarmup());
+}
+
+TEST_CASE(SwapGroupClient_ReconfigureRollsBackOnFailure)
+{
+    SimulatedClient simulated;
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    s_WarmupCallbackCount = 0;
+    s_RepeatsBeforeWarmedUp = 0;
+    simulated.client->SetBarrierWarmupCallback(&RepeatThenWarmedUp);
+    REQUIRE(simulated.client->Render(&simulated.device));
+    REQUIRE(!simulated.client->NeedsBarrierWarmup());
+
+    // Barrier is unbound, then leaving the swap group fails: barrier is bound again (and has to be warmed up again)
+    simulated.api->InjectFailure(Call::JoinSwapGroup, NVAPI_ERROR);
+    SwapGroupConfiguration target;
+    CHECK(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::FailedToJoinSwapGroup);
+    CHECK(simulated.client->GetSwapGroupId() == 1);
+    CHECK(simulated.client->GetSwapBarrierId() == 1);
+    CHECK(simulated.client->NeedsBarrierWarmup());
+    CHECK(simulated.client->Render(&simulated.device));
+    CHECK(simulated.device.initiatePresentRepeatsCount == 2);
+    CHECK(!simulated.client->NeedsBarrierWarmup());
+
+    NvU32 groupId = 0;
+    NvU32 barrierId = 0;
+    REQUIRE(simulated.api->QuerySwapGroup(simulated.device.GetDevice(), simulated.device.GetSwapChain(), &groupId,
+        &barrierId) == NVAPI_OK);
+    CHECK(groupId == 1);
+    CHECK(barrierId == 1);
+
+    // Joining succeeds but binding fails: swap group is left again
+    REQUIRE(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::Success);
+    simulated.api->InjectFailure(Call::BindSwapBarrier, NVAPI_ERROR);
+    target.swapGroupId = 1;
+    target.swapBarrierId = 1;
+    CHECK(simulated.client->Reconfigure(simulated.device.GetDevice(), simulated.device.GetSwapChain(), target) ==
+        PluginCSwapGroupClient::ReconfigureStatus::FailedToBindSwapBarrier);
+    CHECK(simulated.client->GetSwapGroupId() == 0);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+}
+
+TEST_CASE(SwapGroupClient_JoinsSelectedSwapGroupAndBarrier)
+{
+    auto config = SimulatedClient::NoWaitConfig();
+    config.maxSwapGroups = 4;
+    config.maxSwapBarriers = 2;
+    SimulatedClient simulated(config);
+    CHECK(!simulated.client->SetSwapGroupIds(0, 1));
+    REQUIRE(simulated.client->SetSwapGroupIds(3, 2));
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    CHECK(simulated.client->GetSwapGroupId() == 3);
+    CHECK(simulated.client->GetSwapBarrierId() == 2);
+
+    // Validated against the maximums once initialized
+    CHECK(!simulated.client->SetSwapGroupIds(5, 1));
+    CHECK(!simulated.client->SetSwapGroupIds(2, 3));
+    CHECK(simulated.client->GetSelectedSwapGroupId() == 3);
+    CHECK(simulated.client->GetSelectedSwapBarrierId() == 2);
+
+    // Used by the next enable, without changing the current membership
+    REQUIRE(simulated.client->SetSwapGroupIds(2, 0));
+    CHECK(simulated.client->GetSwapGroupId() == 3);
+    simulated.client->EnableSystem(simulated.device.GetDevice(), simulated.device.GetSwapChain(), false);
+    simulated.client->EnableSystem(simulated.device.GetDevice(), simulated.device.GetSwapChain(), true);
+    CHECK(simulated.client->GetSwapGroupId() == 2);
+    CHECK(simulated.client->GetSwapBarrierId() == 0);
+}
+
+TEST_CASE(SwapGroupClient_InitializeRejectsSelectionAboveMaximums)
+{
+    SimulatedClient groupAboveMaximum;
+    REQUIRE(groupAboveMaximum.client->SetSwapGroupIds(2, 1));
+    CHECK(groupAboveMaximum.Initialize() == PluginCSwapGroupClient::InitializeStatus::SwapGroupMismatch);
+    CHECK(groupAboveMaximum.api->GetCallCount(Call::JoinSwapGroup) == 0);
+
+    SimulatedClient barrierAboveMaximum;
+    REQUIRE(barrierAboveMaximum.client->SetSwapGroupIds(1, 2));
+    CHECK(barrierAboveMaximum.Initialize() == PluginCSwapGroupClient::InitializeStatus::SwapBarrierIdMismatch);
+    CHECK(barrierAboveMaximum.api->GetCallCount(Call::BindSwapBarrier) == 0);
+}
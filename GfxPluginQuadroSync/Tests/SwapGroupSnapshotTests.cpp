@@ -0,0 +1,139 @@
+#include "TestFramework.h"
+#include "SimulatedClient.h"
+
+#include "QuadroSync.h"
+#include "SimulatedSwapGroupApi.h"
+#include "SwapGroupSnapshot.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace GfxQuadroSync;
+using QuadroSyncTests::BarrierWarmedUp;
+using QuadroSyncTests::SimulatedClient;
+
+namespace
+{
+    SwapGroupSnapshot HardwareSnapshot(const uint64_t frameCount, const uint64_t tick, const double refreshPeriodTicks)
+    {
+        SwapGroupSnapshot snapshot;
+        snapshot.frameCount = frameCount;
+        snapshot.frameCountTick = tick;
+        snapshot.refreshPeriodTicks = refreshPeriodTicks;
+        snapshot.flags = static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter);
+        snapshot.frameCountConfidence = static_cast<uint32_t>(FrameCountConfidence::Sampled);
+        return snapshot;
+    }
+}
+
+TEST_CASE(SwapGroupSnapshot_ExtrapolatesHardwareFrameCount)
+{
+    const auto snapshot = HardwareSnapshot(100, 1000, 10.5);
+    FrameCountConfidence confidence;
+    CHECK(ExtrapolateFrameCount(snapshot, 1000, &confidence) == 100);
+    CHECK(confidence == FrameCountConfidence::Sampled);
+    // Before the sample: not extrapolated backward
+    CHECK(ExtrapolateFrameCount(snapshot, 900, &confidence) == 100);
+    CHECK(confidence == FrameCountConfidence::Sampled);
+    CHECK(ExtrapolateFrameCount(snapshot, 1010, &confidence) == 100);
+    CHECK(confidence == FrameCountConfidence::Extrapolated);
+    CHECK(ExtrapolateFrameCount(snapshot, 1011) == 101);
+    CHECK(ExtrapolateFrameCount(snapshot, 2050) == 200);
+
+    // Refresh period unknown
+    CHECK(ExtrapolateFrameCount(HardwareSnapshot(100, 1000, 0), 2000, &confidence) == 100);
+    CHECK(confidence == FrameCountConfidence::Stale);
+
+    // Never sampled
+    auto neverSampled = HardwareSnapshot(0, 0, 0);
+    neverSampled.frameCountConfidence = static_cast<uint32_t>(FrameCountConfidence::None);
+    CHECK(ExtrapolateFrameCount(neverSampled, 2000, &confidence) == 0);
+    CHECK(confidence == FrameCountConfidence::None);
+}
+
+TEST_CASE(SwapGroupSnapshot_CustomFrameCountIsNotExtrapolated)
+{
+    SimulatedClient simulated;
+    simulated.client->PostConfigurationChange(PluginCSwapGroupClient::ConfigurationSetting::SyncCounter, false);
+    simulated.client->ApplyPendingConfiguration(simulated.device.GetDevice(), simulated.device.GetSwapChain());
+    CHECK(simulated.client->QueryFrameCount(simulated.device.GetDevice()) == 1);
+    CHECK(simulated.client->QueryFrameCount(simulated.device.GetDevice()) == 2);
+
+    const auto snapshot = simulated.client->GetSnapshot();
+    CHECK((snapshot.flags & static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter)) == 0);
+    FrameCountConfidence confidence;
+    CHECK(ExtrapolateFrameCount(snapshot, snapshot.frameCountTick + 1000000, &confidence) == 2);
+    CHECK(confidence == FrameCountConfidence::Sampled);
+}
+
+TEST_CASE(SwapGroupSnapshot_ClientPublishesMembershipAndPresentResult)
+{
+    SimulatedClient simulated;
+    auto snapshot = simulated.client->GetSnapshot();
+    CHECK(snapshot.presentCount == 0);
+    CHECK(snapshot.flags == 0);
+
+    simulated.client->SetBarrierWarmupCallback(&BarrierWarmedUp);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+    snapshot = simulated.client->GetSnapshot();
+    CHECK(snapshot.swapGroupId == 1);
+    CHECK(snapshot.swapBarrierId == 1);
+    CHECK(snapshot.flags == static_cast<uint32_t>(SwapGroupSnapshotFlags::HardwareFrameCounter));
+    CHECK(snapshot.frameCountConfidence == static_cast<uint32_t>(FrameCountConfidence::None));
+
+    // Presents do not sample the hardware frame counter (no driver round trip on the present path)
+    CHECK(simulated.client->Render(&simulated.device));
+    snapshot = simulated.client->GetSnapshot();
+    CHECK(snapshot.presentCount == 1);
+    CHECK(snapshot.lastPresentStatus == NVAPI_OK);
+    CHECK(snapshot.lastPresentEndTick > 0);
+    CHECK((snapshot.flags & static_cast<uint32_t>(SwapGroupSnapshotFlags::HasPresented)) != 0);
+    CHECK(snapshot.frameCountConfidence == static_cast<uint32_t>(FrameCountConfidence::None));
+    simulated.client->QueryFrameCount(simulated.device.GetDevice());
+    CHECK(simulated.client->GetSnapshot().frameCountConfidence ==
+        static_cast<uint32_t>(FrameCountConfidence::Sampled));
+
+    simulated.api->InjectFailure(SimulatedSwapGroupApi::Call::Present, NVAPI_ERROR);
+    CHECK(!simulated.client->Render(&simulated.device));
+    snapshot = simulated.client->GetSnapshot();
+    CHECK(snapshot.presentCount == 2);
+    CHECK(snapshot.lastPresentStatus == NVAPI_ERROR);
+
+    simulated.client->Dispose(simulated.device.GetDevice(), simulated.device.GetSwapChain());
+    snapshot = simulated.client->GetSnapshot();
+    CHECK(snapshot.swapGroupId == 0);
+    CHECK(snapshot.swapBarrierId == 0);
+    CHECK(snapshot.presentCount == 2);
+}
+
+TEST_CASE(SwapGroupSnapshot_ReadableWhilePresenting)
+{
+    SimulatedClient simulated;
+    simulated.client->SetBarrierWarmupCallback(&BarrierWarmedUp);
+    REQUIRE(simulated.Initialize() == PluginCSwapGroupClient::InitializeStatus::Success);
+
+    constexpr uint64_t presentCount = 2000;
+    std::atomic<bool> consistent{true};
+    std::thread reader([&simulated, &consistent]
+    {
+        uint64_t lastPresentCount = 0;
+        while (lastPresentCount < presentCount)
+        {
+            const auto snapshot = simulated.client->GetSnapshot();
+            if (snapshot.presentCount < lastPresentCount || snapshot.swapGroupId != 1 || snapshot.swapBarrierId != 1 ||
+                (snapshot.presentCount > 0 && snapshot.lastPresentEndTick == 0))
+            {
+                consistent = false;
+                break;
+            }
+            lastPresentCount = snapshot.presentCount;
+        }
+    });
+
+    for (uint64_t i = 0; i < presentCount; ++i)
+    {
+        simulated.client->Render(&simulated.device);
+    }
+    reader.join();
+    CHECK(consistent.load());
+}
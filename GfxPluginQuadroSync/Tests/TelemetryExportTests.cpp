@@ -0,0 +1,86 @@
+#include "TestFramework.h"
+
+#include "PerformanceCounter.h"
+#include "SharedMemory.h"
+#include "TelemetryExport.h"
+
+#include <string>
+
+using namespace GfxQuadroSync;
+
+namespace
+{
+    std::string GetUniqueName(const char* test)
+    {
+        return std::string("QuadroSyncTests.") + test + "." + std::to_string(GetCurrentPerformanceCounterTick());
+    }
+
+    PresentTiming MakeTiming(const uint64_t startTick, const uint32_t flags)
+    {
+        PresentTiming timing;
+        timing.presentStartTick = startTick;
+        timing.presentEndTick = startTick + 10;
+        timing.flags = flags;
+        return timing;
+    }
+}
+
+TEST_CASE(TelemetryExport_ReaderSeesStateAndTimings)
+{
+    const auto name = GetUniqueName("ReaderSeesStateAndTimings");
+    PresentTimingRing timings;
+    timings.Push(MakeTiming(100, 0));
+    timings.Push(MakeTiming(200, static_cast<uint32_t>(PresentTimingFlags::Stalled)));
+
+    TelemetryExport telemetryExport;
+    CHECK(!telemetryExport.IsOpen());
+    REQUIRE(telemetryExport.Open(name));
+    CHECK(telemetryExport.IsOpen());
+
+    QuadroSyncState state;
+    state.swapGroupId = 1;
+    state.presentedFramesSuccess = 2;
+    telemetryExport.Publish(state, timings);
+
+    SharedMemory reader;
+    REQUIRE(reader.OpenReadOnly(name, sizeof(TelemetryBlock)));
+    const auto block = TelemetryExport::Validate(reader.GetData(), reader.GetSize());
+    REQUIRE(block != nullptr);
+    CHECK(block->header.timingsCapacity == PresentTimingRing::k_Capacity);
+    CHECK(block->header.performanceCounterFrequency == GetPerformanceCounterFrequency());
+
+    auto readState = block->state.Read();
+    CHECK(readState.swapGroupId == 1);
+    CHECK(readState.presentedFramesSuccess == 2);
+
+    PresentTiming readTimings[4];
+    uint64_t cursor = 0;
+    uint64_t dropped = 0;
+    REQUIRE(block->timings.Read(cursor, readTimings, 4, dropped) == 2);
+    CHECK(readTimings[0].presentStartTick == 100);
+    CHECK(readTimings[1].presentStartTick == 200);
+    CHECK(readTimings[1].flags == static_cast<uint32_t>(PresentTimingFlags::Stalled));
+
+    // Only new timings are copied by the following publish
+    timings.Push(MakeTiming(300, 0));
+    state.presentedFramesSuccess = 3;
+    telemetryExport.Publish(state, timings);
+    readState = block->state.Read();
+    CHECK(readState.presentedFramesSuccess == 3);
+    REQUIRE(block->timings.Read(cursor, readTimings, 4, dropped) == 1);
+    CHECK(readTimings[0].presentStartTick == 300);
+    CHECK(dropped == 0);
+
+    telemetryExport.Close();
+    CHECK(!telemetryExport.IsOpen());
+}
+
+TEST_CASE(TelemetryExport_ValidateRejectsUninitializedMemory)
+{
+    TelemetryBlock block{};
+    CHECK(TelemetryExport::Validate(&block, sizeof(block)) == nullptr);
+    CHECK(TelemetryExport::Validate(nullptr, sizeof(block)) == nullptr);
+
+    SharedMemory reader;
+    CHECK(!reader.OpenReadOnly(GetUniqueName("Missing"), sizeof(TelemetryBlock)));
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * \brief Minimal self-registering test framework used by quadrosync_tests.
+ *
+ * Tests are declared with TEST_CASE(Name) { ... } and use CHECK (failure is reported and the test continues) or
+ * REQUIRE (failure is reported and the test stops).
+ */
+namespace QuadroSyncTests
+{
+    struct TestFailure {};
+
+    struct TestCase
+    {
+        const char* name;
+        void (*function)();
+    };
+
+    inline std::vector<TestCase>& GetTestCases()
+    {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    inline uint32_t& GetCurrentTestFailureCount()
+    {
+        static uint32_t failureCount = 0;
+        return failureCount;
+    }
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* name, void (*function)())
+        {
+            GetTestCases().push_back({name, function});
+        }
+    };
+
+    inline void ReportFailure(const char* file, const int line, const char* expression)
+    {
+        ++GetCurrentTestFailureCount();
+        std::cerr << file << '(' << line << "): check failed: " << expression << std::endl;
+    }
+}
+
+#define QUADROSYNC_TEST_CONCAT_INNER(a, b) a##b
+#define QUADROSYNC_TEST_CONCAT(a, b) QUADROSYNC_TEST_CONCAT_INNER(a, b)
+
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static QuadroSyncTests::TestRegistrar QUADROSYNC_TEST_CONCAT(s_Registrar, name)(#name, &name);                     \
+    static void name()
+
+#define CHECK(expression)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+            QuadroSyncTests::ReportFailure(__FILE__, __LINE__, #expression);                                           \
+    } while (false)
+
+#define REQUIRE(expression)                                                                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+        {                                                                                                              \
+            QuadroSyncTests::ReportFailure(__FILE__, __LINE__, #expression);                                           \
+            throw QuadroSyncTests::TestFailure();                                                                      \
+        }                                                                                                              \
+    } while (false)
@@ -0,0 +1,48 @@
+#include "TestFramework.h"
+
+#include <cstring>
+#include <exception>
+
+// Runs every registered test (or only the ones whose name contains the first command line argument).
+int main(int argc, char* argv[])
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    uint32_t executedCount = 0;
+    uint32_t failedCount = 0;
+    for (const auto& testCase: QuadroSyncTests::GetTestCases())
+    {
+        if (filter && std::strstr(testCase.name, filter) == nullptr)
+        {
+            continue;
+        }
+
+        QuadroSyncTests::GetCurrentTestFailureCount() = 0;
+        try
+        {
+            testCase.function();
+        }
+        catch (const QuadroSyncTests::TestFailure&)
+        {
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Unexpected exception: " << e.what() << std::endl;
+            ++QuadroSyncTests::GetCurrentTestFailureCount();
+        }
+
+        ++executedCount;
+        if (QuadroSyncTests::GetCurrentTestFailureCount() > 0)
+        {
+            ++failedCount;
+            std::cerr << "[FAILED] " << testCase.name << std::endl;
+        }
+        else
+        {
+            std::cout << "[PASSED] " << testCase.name << std::endl;
+        }
+    }
+
+    std::cout << executedCount - failedCount << " / " << executedCount << " tests passed" << std::endl;
+    return failedCount == 0 && executedCount > 0 ? 0 : 1;
+}
@@ -35,6 +35,7 @@ echo Prepare CMake project
 echo ************************************
 cmake .. ^
 	-A x64 ^
+    -DQUADROSYNC_BUILD_TESTS=OFF ^
     -DCMAKE_INSTALL_PREFIX=%INSTALLDIR%
 IF %ERRORLEVEL% NEQ 0 (
 	echo Failed to prepare CMake project
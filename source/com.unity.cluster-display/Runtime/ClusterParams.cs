@@ -113,6 +113,12 @@ public TimeSpan CommunicationTimeout
         [Tooltip("Synchronization method")]
         public FrameSyncFence Fence;
 
+        [Tooltip("Nvidia swap group joined when using the hardware fence (0 for the default: 1).")]
+        public int SwapGroupId;
+        [Tooltip("Nvidia swap barrier bound when using the hardware fence (0 for the default: 1). Independent " +
+            "walls sharing the same sync chain can use different barriers to not pace each other.")]
+        public int SwapBarrierId;
+
         [SerializeField]
         [Tooltip("Timeout for performing node registration (seconds)")]
         float m_HandshakeTimeoutSec;
@@ -206,6 +212,8 @@ public static ClusterParams ApplyCommandLine(ClusterParams clusterParams)
             ApplyArgument(ref clusterParams.HeadlessEmitter, CommandLineParser.headlessEmitter);
             ApplyArgument(ref clusterParams.AdapterName, CommandLineParser.adapterName);
             ApplyArgument(ref clusterParams.TargetFps, CommandLineParser.targetFps);
+            ApplyArgument(ref clusterParams.SwapGroupId, CommandLineParser.swapGroup);
+            ApplyArgument(ref clusterParams.SwapBarrierId, CommandLineParser.swapBarrier);
 
             if (CommandLineParser.handshakeTimeout.Defined)
             {
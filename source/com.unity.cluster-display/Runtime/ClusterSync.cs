@@ -140,7 +140,7 @@ public string GetDiagnostics()
                 return string.Empty;
             }
 
-            var quadroSyncState = GfxPluginQuadroSyncSystem.FetchState();
+            var quadroSyncState = GfxPluginQuadroSyncSystem.ReadState();
             return $"Cluster Sync Instance: {InstanceName},\r\n" +
 				   $"Frame Stats:\r\n{LocalNode.GetDebugString(LocalNode.UdpAgent.Stats)}" +
                    $"\r\n\r\n\tAverage Frame Time: {(m_FrameRatePerf.Average * 1000)} ms" +
@@ -365,6 +365,8 @@ bool TryInitialize(ClusterParams clusterParams)
                     CommunicationTimeout = clusterParams.CommunicationTimeout,
                     RepeatersDelayed = clusterParams.DelayRepeaters,
                     Fence = clusterParams.Fence,
+                    SwapGroupId = clusterParams.SwapGroupId,
+                    SwapBarrierId = clusterParams.SwapBarrierId,
                     InputSync = clusterParams.InputSync,
                     HasAtLeastOneBackupNode = clusterParams.BackupCount > 0
                 };
@@ -232,6 +232,8 @@ internal class Vector2IntArgument : BaseArgument<Vector2Int>
         internal static readonly IntArgument overscan                       = new IntArgument("-overscan");
 
         internal static readonly BoolArgument disableQuadroSync             = new BoolArgument("-disableQuadroSync");
+        internal static readonly IntArgument swapGroup                      = new IntArgument("-swapGroup");
+        internal static readonly IntArgument swapBarrier                    = new IntArgument("-swapBarrier");
 
         internal static readonly StringArgument adapterName                 = new StringArgument("-adapterName");
         internal static readonly StringArgument multicastAddress            = new StringArgument(GetNodeType, tryParse: TryParseMulticastAddress);
@@ -259,7 +261,9 @@ internal class Vector2IntArgument : BaseArgument<Vector2Int>
             port,
             handshakeTimeout,
             communicationTimeout,
-            disableQuadroSync
+            disableQuadroSync,
+            swapGroup,
+            swapBarrier
         };
 
         // Since this property is referenced by some arguments when this class is initialized, this will be one of the very first things called.
@@ -36,6 +36,13 @@ struct ClusterNodeConfig
         /// </summary>
         public FrameSyncFence Fence { get; set; }
 
+        /// <summary>
+        /// Swap group and barrier used by the <see cref="FrameSyncFence.Hardware"/> fence (0 for the default: 1).
+        /// </summary>
+        public int SwapGroupId { get; set; }
+        /// <inheritdoc cref="SwapGroupId"/>
+        public int SwapBarrierId { get; set; }
+
         /// <summary>
         /// The input subsystem synchronized by the cluster.
         /// </summary>
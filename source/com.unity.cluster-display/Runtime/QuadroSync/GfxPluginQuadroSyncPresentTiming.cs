@@ -0,0 +1,72 @@
+using System;
+using System.Runtime.InteropServices;
+// ReSharper disable UnassignedGetOnlyAutoProperty
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Flags describing the context in which a present was done.
+    /// </summary>
+    [Flags]
+    public enum GfxPluginQuadroSyncPresentTimingFlags : uint
+    {
+        /// <summary>
+        /// Normal synchronized present.
+        /// </summary>
+        None = 0,
+        /// <summary>
+        /// Present was done while the swap barrier was being warmed up.
+        /// </summary>
+        BarrierWarmup = 1 << 0,
+        /// <summary>
+        /// Present of a repeated frame (additional present done to warm up the swap barrier).
+        /// </summary>
+        RepeatedPresent = 1 << 1,
+        /// <summary>
+        /// Synchronized present was skipped for that frame (Unity did a normal present).
+        /// </summary>
+        SkippedSynchronization = 1 << 2,
+        /// <summary>
+        /// Present was blocked for longer than the stall watchdog threshold (see
+        /// <see cref="GfxPluginQuadroSyncSystem.SetPresentStallWatchdog"/>).
+        /// </summary>
+        Stalled = 1 << 3,
+    }
+
+    /// <summary>
+    /// Timing of a present done by the QuadroSync plugin as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.ReadPresentTimings"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::PresentTiming in PresentTimings.h.
+    /// </remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncPresentTiming
+    {
+        /// <summary>
+        /// Index of the present (incremented for every present, including repeats done to warm up the barrier).
+        /// </summary>
+        public ulong PresentIndex { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp just before calling present.
+        /// </summary>
+        public ulong PresentStartTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp just after present returned.
+        /// </summary>
+        public ulong PresentEndTimestamp { get; }
+        /// <summary>
+        /// NvAPI_Status returned by present (0 is success).
+        /// </summary>
+        public int Status { get; }
+        /// <summary>
+        /// Context in which the present was done.
+        /// </summary>
+        public GfxPluginQuadroSyncPresentTimingFlags Flags { get; }
+
+        /// <summary>
+        /// Time spent in the present call (including the time waiting for the swap barrier).
+        /// </summary>
+        public TimeSpan PresentDuration => TimeSpan.FromSeconds(
+            (double)(PresentEndTimestamp - PresentStartTimestamp) / System.Diagnostics.Stopwatch.Frequency);
+    }
+}
@@ -1,4 +1,5 @@
-﻿using System.Runtime.InteropServices;
+﻿using System;
+using System.Runtime.InteropServices;
 // ReSharper disable UnassignedGetOnlyAutoProperty
 
 namespace Unity.ClusterDisplay
@@ -117,11 +118,62 @@ enumValue switch
     }
 
     /// <summary>
-    /// Status of the QuadroSync plugin as returned by <see cref="GfxPluginQuadroSyncSystem.FetchState"/>.
+    /// Groups of fields of <see cref="GfxPluginQuadroSyncState"/> filled by the plugin.
     /// </summary>
+    [Flags]
+    public enum GfxPluginQuadroSyncStateCapabilities : ulong
+    {
+        None = 0,
+        /// <summary>
+        /// <see cref="GfxPluginQuadroSyncState.InitializationState"/>, <see cref="GfxPluginQuadroSyncState.SwapGroupId"/>,
+        /// <see cref="GfxPluginQuadroSyncState.SwapBarrierId"/>, <see cref="GfxPluginQuadroSyncState.PresentedFramesSuccess"/>
+        /// and <see cref="GfxPluginQuadroSyncState.PresentedFramesFailure"/>.
+        /// </summary>
+        PresentCounters = 1 << 0,
+        /// <summary>
+        /// <see cref="GfxPluginQuadroSyncState.SuppressedLogMessages"/> and
+        /// <see cref="GfxPluginQuadroSyncState.DroppedLogMessages"/>.
+        /// </summary>
+        LogCounters = 1 << 1,
+        /// <summary>
+        /// <see cref="GfxPluginQuadroSyncState.PresentStallCount"/>,
+        /// <see cref="GfxPluginQuadroSyncState.LastPresentStallDurationNs"/> and
+        /// <see cref="GfxPluginQuadroSyncState.IsPresentStalled"/>.
+        /// </summary>
+        PresentStallWatchdog = 1 << 2,
+    }
+
+    /// <summary>
+    /// Status of the QuadroSync plugin as returned by <see cref="GfxPluginQuadroSyncSystem.FetchState"/> and
+    /// <see cref="GfxPluginQuadroSyncSystem.ReadState"/>.
+    /// </summary>
+    /// <remarks>Mirrors QuadroSyncState in QuadroSyncState.h.  Fields are only ever appended (with a new version and
+    /// capability bit), so <see cref="Size"/> and <see cref="Capabilities"/> tell which fields were filled.</remarks>
     [StructLayout(LayoutKind.Sequential)]
     public readonly struct GfxPluginQuadroSyncState
     {
+        /// <summary>
+        /// Version of the struct as known by this code.
+        /// </summary>
+        public const uint CurrentVersion = 1;
+
+        internal GfxPluginQuadroSyncState(uint size) : this()
+        {
+            Size = size;
+        }
+
+        /// <summary>
+        /// Size of the struct (in bytes) filled by the plugin
+        /// </summary>
+        public uint Size { get; }
+        /// <summary>
+        /// Version of the struct filled by the plugin
+        /// </summary>
+        public uint Version { get; }
+        /// <summary>
+        /// Groups of fields filled by the plugin
+        /// </summary>
+        public GfxPluginQuadroSyncStateCapabilities Capabilities { get; }
         /// <summary>
         /// Initialization status of the QuadroSync system
         /// </summary>
@@ -134,6 +186,8 @@ enumValue switch
         /// Swap barrier identifier
         /// </summary>
         public uint SwapBarrierId { get; }
+        // Not using a bool so that the struct stays blittable (it is copied directly from the plugin's memory)
+        readonly uint m_PresentStalled;
         /// <summary>
         ///  Number of frames successfully presented using QuadroSync's present call
         /// </summary>
@@ -142,5 +196,361 @@ enumValue switch
         /// Number of frames that failed to be presented using QuadroSync's present call
         /// </summary>
         public ulong PresentedFramesFailure { get; }
+        /// <summary>
+        /// Number of log messages of the plugin suppressed because they were repeated too often
+        /// </summary>
+        public ulong SuppressedLogMessages { get; }
+        /// <summary>
+        /// Number of log messages of the plugin dropped because they were produced faster than they were delivered
+        /// </summary>
+        public ulong DroppedLogMessages { get; }
+        /// <summary>
+        /// Number of presents blocked for longer than the stall watchdog threshold
+        /// </summary>
+        public ulong PresentStallCount { get; }
+        /// <summary>
+        /// Duration (in nanoseconds) of the last stalled present that completed
+        /// </summary>
+        public ulong LastPresentStallDurationNs { get; }
+        /// <summary>
+        /// Is the present in progress blocked for longer than the stall watchdog threshold
+        /// </summary>
+        public bool IsPresentStalled => m_PresentStalled != 0;
+    }
+
+    /// <summary>
+    /// How much a frame count returned by the plugin can be trusted.
+    /// </summary>
+    public enum GfxPluginQuadroSyncFrameCountConfidence : uint
+    {
+        /// <summary>
+        /// The frame counter was never sampled, the frame count is meaningless.
+        /// </summary>
+        None = 0,
+        /// <summary>
+        /// Value of the last sample of the hardware frame counter, the refresh period is not yet known so it could not
+        /// be extrapolated.
+        /// </summary>
+        Stale = 1,
+        /// <summary>
+        /// Extrapolated from the last sample of the hardware frame counter using the measured refresh period.
+        /// </summary>
+        Extrapolated = 2,
+        /// <summary>
+        /// Value directly sampled from the frame counter.
+        /// </summary>
+        Sampled = 3,
+    }
+
+    /// <summary>
+    /// Flags of <see cref="GfxPluginQuadroSyncSnapshot"/>.
+    /// </summary>
+    [Flags]
+    public enum GfxPluginQuadroSyncSnapshotFlags : uint
+    {
+        None = 0,
+        /// <summary>
+        /// The frame count is the hardware frame counter (shared by every node of the swap group) as opposed to the
+        /// custom frame counter (incremented every time it is queried).
+        /// </summary>
+        HardwareFrameCounter = 1 << 0,
+        /// <summary>
+        /// At least one frame was presented through NvAPI (last present properties are meaningful).
+        /// </summary>
+        HasPresented = 1 << 1,
+    }
+
+    /// <summary>
+    /// Frame count, swap group and barrier membership and last present result as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.GetSwapGroupSnapshot"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::SwapGroupSnapshot in
+    /// SwapGroupSnapshot.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncSnapshot
+    {
+        /// <summary>
+        /// Frame count at <see cref="FrameCountTimestamp"/>.
+        /// </summary>
+        public ulong FrameCount { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which <see cref="FrameCount"/> was valid.
+        /// </summary>
+        public ulong FrameCountTimestamp { get; }
+        /// <summary>
+        /// Measured refresh period (in <see cref="System.Diagnostics.Stopwatch"/> ticks), 0 if unknown or if the frame
+        /// count is not the hardware frame counter.
+        /// </summary>
+        public double RefreshPeriodTicks { get; }
+        /// <summary>
+        /// Number of presents done through NvAPI (successful or not).
+        /// </summary>
+        public ulong PresentCount { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the last present through NvAPI returned.
+        /// </summary>
+        public ulong LastPresentEndTimestamp { get; }
+        /// <summary>
+        /// NvAPI_Status returned by the last present through NvAPI (0 is NVAPI_OK).
+        /// </summary>
+        public int LastPresentStatus { get; }
+        /// <summary>
+        /// Swap group joined (0 if none).
+        /// </summary>
+        public uint SwapGroupId { get; }
+        /// <summary>
+        /// Swap barrier bound (0 if none).
+        /// </summary>
+        public uint SwapBarrierId { get; }
+        /// <summary>
+        /// Flags qualifying the other properties.
+        /// </summary>
+        public GfxPluginQuadroSyncSnapshotFlags Flags { get; }
+        /// <summary>
+        /// How much <see cref="FrameCount"/> can be trusted at <see cref="FrameCountTimestamp"/>.
+        /// </summary>
+        public GfxPluginQuadroSyncFrameCountConfidence FrameCountConfidence { get; }
+        // Followed by 4 bytes of padding (added by the sequential layout)
+    }
+
+    /// <summary>
+    /// Tolerances used by the plugin to decide by itself when the swap barrier is warmed up (see
+    /// <see cref="GfxPluginQuadroSyncSystem.SetBarrierWarmupPolicy"/>).
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::BarrierWarmupPolicy::Settings in
+    /// BarrierWarmupPolicy.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct GfxPluginQuadroSyncBarrierWarmupSettings
+    {
+        /// <summary>
+        /// Number of consecutive stable presents (one frame of the hardware frame counter per present, at a steady
+        /// interval) after which the barrier is warmed up.
+        /// </summary>
+        public uint StablePresents { get; set; }
+        /// <summary>
+        /// Number of presents after which the plugin gives up (and concludes the warmup anyway).
+        /// </summary>
+        public uint MaxPresents { get; set; }
+        /// <summary>
+        /// Maximum deviation of a present interval from the average interval of the stable presents (as a fraction of
+        /// the average).
+        /// </summary>
+        public double IntervalTolerance { get; set; }
+        /// <summary>
+        /// Maximum deviation of the number of frames between two presents from one frame.
+        /// </summary>
+        public uint FrameCountTolerance { get; set; }
+        // Followed by 4 bytes of padding (added by the sequential layout)
+
+        /// <summary>
+        /// Default settings (same as GfxQuadroSync::BarrierWarmupPolicy::Settings).
+        /// </summary>
+        public static GfxPluginQuadroSyncBarrierWarmupSettings Default { get; } = new()
+        {
+            StablePresents = 8,
+            MaxPresents = 600,
+            IntervalTolerance = 0.1,
+            FrameCountTolerance = 0
+        };
+    }
+
+    /// <summary>
+    /// Outcome of a barrier warmup decided by the plugin.
+    /// </summary>
+    public enum GfxPluginQuadroSyncBarrierWarmupOutcome : uint
+    {
+        /// <summary>
+        /// No warmup decided by the plugin (never started or decided by the barrier warmup callback).
+        /// </summary>
+        None = 0,
+        /// <summary>
+        /// Presents are being repeated.
+        /// </summary>
+        InProgress = 1,
+        /// <summary>
+        /// The frame counter and the present interval stabilized.
+        /// </summary>
+        Converged = 2,
+        /// <summary>
+        /// The maximum number of presents was reached without stabilizing (warmup was concluded anyway).
+        /// </summary>
+        GaveUp = 3,
+    }
+
+    /// <summary>
+    /// Progress and outcome of the last barrier warmup decided by the plugin as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.GetBarrierWarmupReport"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::BarrierWarmupReport in
+    /// BarrierWarmupPolicy.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncBarrierWarmupReport
+    {
+        /// <summary>
+        /// Outcome of the warmup.
+        /// </summary>
+        public GfxPluginQuadroSyncBarrierWarmupOutcome Outcome { get; }
+        /// <summary>
+        /// Number of presents done (including the first one, that is not a repeat).
+        /// </summary>
+        public uint PresentCount { get; }
+        /// <summary>
+        /// Number of consecutive stable presents at the end of the warmup (or so far).
+        /// </summary>
+        public uint StablePresentCount { get; }
+        // Followed by 4 bytes of padding (added by the sequential layout)
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the first present returned.
+        /// </summary>
+        public ulong StartTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the last present returned.
+        /// </summary>
+        public ulong EndTimestamp { get; }
+        /// <summary>
+        /// Average present interval (in <see cref="System.Diagnostics.Stopwatch"/> ticks) of the stable presents (0
+        /// if none).
+        /// </summary>
+        public double PresentIntervalTicks { get; }
+    }
+
+    /// <summary>
+    /// What changed in the swap chain presented by Unity (flags).
+    /// </summary>
+    [Flags]
+    public enum GfxPluginQuadroSyncSwapChainChange : uint
+    {
+        None = 0,
+        /// <summary>
+        /// Unity presents through a new swap chain.
+        /// </summary>
+        Recreated = 1 << 0,
+        /// <summary>
+        /// Description of the swap chain changed (resolution, format, fullscreen, ...).
+        /// </summary>
+        Resized = 1 << 1
+    }
+
+    /// <summary>
+    /// Swap chain changes detected by the plugin (that rejoins the swap group and barrier after each of them) and how
+    /// long the node was out of sync because of them, as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.GetSwapChainChangeReport"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::SwapChainChangeReport in
+    /// SwapChainMonitor.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncSwapChainReport
+    {
+        /// <summary>
+        /// Number of swap chain changes detected.
+        /// </summary>
+        public uint ChangeCount { get; }
+        /// <summary>
+        /// What changed the last time.
+        /// </summary>
+        public GfxPluginQuadroSyncSwapChainChange LastChange { get; }
+        /// <summary>
+        /// Status of rejoining the swap group and barrier after the last change (0 on success).
+        /// </summary>
+        public uint LastRejoinStatus { get; }
+        readonly uint m_OutOfSync;
+        /// <summary>
+        /// Is the node out of sync (rejoining the swap group and barrier or warming up the barrier again).
+        /// </summary>
+        public bool OutOfSync => m_OutOfSync != 0;
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the node got out of sync.
+        /// </summary>
+        public ulong LastChangeTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the node was synchronized again after the
+        /// last change (0 if not yet).
+        /// </summary>
+        public ulong LastResynchronizedTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> ticks the node was out of sync after the last change (0 if still
+        /// out of sync).
+        /// </summary>
+        public ulong LastOutOfSyncTicks { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> ticks the node was out of sync after all the changes (not
+        /// counting the current one).
+        /// </summary>
+        public ulong TotalOutOfSyncTicks { get; }
+    }
+
+    /// <summary>
+    /// State of the recovery from failed presents.
+    /// </summary>
+    public enum GfxPluginQuadroSyncDeviceRecoveryState : uint
+    {
+        /// <summary>
+        /// Presents are succeeding.
+        /// </summary>
+        Healthy = 0,
+        /// <summary>
+        /// Last presents failed with transient failures (like a barrier waiting on a node that left the cluster).
+        /// </summary>
+        Degraded = 1,
+        /// <summary>
+        /// Waiting for a usable device (Unity creates a new one after a TDR) to join the swap group and barrier again.
+        /// </summary>
+        Lost = 2,
+        /// <summary>
+        /// Swap group and barrier joined again, waiting for the barrier to be warmed up.
+        /// </summary>
+        WarmingUp = 3
+    }
+
+    /// <summary>
+    /// Progress of the recovery from failed presents and how long recoveries took, as returned by
+    /// <see cref="GfxPluginQuadroSyncSystem.GetDeviceRecoveryReport"/>.
+    /// </summary>
+    /// <remarks>Any change to this struct must be matched in GfxQuadroSync::DeviceRecoveryReport in
+    /// DeviceRecovery.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct GfxPluginQuadroSyncDeviceRecoveryReport
+    {
+        /// <summary>
+        /// State of the recovery.
+        /// </summary>
+        public GfxPluginQuadroSyncDeviceRecoveryState State { get; }
+        /// <summary>
+        /// Number of completed recoveries.
+        /// </summary>
+        public uint RecoveryCount { get; }
+        /// <summary>
+        /// Number of presents that failed in a row.
+        /// </summary>
+        public uint ConsecutiveFailures { get; }
+        /// <summary>
+        /// NvAPI_Status of the last failed present.
+        /// </summary>
+        public int LastFailureStatus { get; }
+        /// <summary>
+        /// HRESULT returned by GetDeviceRemovedReason after the last failed present (0 if the device was usable).
+        /// </summary>
+        public int LastDeviceRemovedReason { get; }
+        readonly uint m_LastFailureFatal;
+        /// <summary>
+        /// Did the last failed present require to join the swap group again (as opposed to a transient failure)?
+        /// </summary>
+        public bool IsLastFailureFatal => m_LastFailureFatal != 0;
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the last recovery started.
+        /// </summary>
+        public ulong LostTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> timestamp at which the last recovery completed (0 if not yet).
+        /// </summary>
+        public ulong RecoveredTimestamp { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> ticks the last recovery took (0 if not completed yet).
+        /// </summary>
+        public ulong LastRecoveryTicks { get; }
+        /// <summary>
+        /// <see cref="System.Diagnostics.Stopwatch"/> ticks all the completed recoveries took.
+        /// </summary>
+        public ulong TotalRecoveryTicks { get; }
     }
 }
@@ -1,6 +1,7 @@
 using System;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Threading;
 using UnityEngine;
 using UnityEngine.Rendering;
 
@@ -65,7 +66,43 @@ public enum EQuadroSyncRenderEvent
             /// <summary>
             /// Indicate to QuadroSync that the next frame should be presented without performing any synchronization.
             /// </summary>
-            QuadroSyncSkipSyncForNextFrame
+            QuadroSyncSkipSyncForNextFrame,
+
+            /// <summary>
+            /// Executes, in order, every command of a command packet in a single render event.  Data is the address of
+            /// the packet (see <see cref="QuadroSyncCommandPacket"/>).
+            /// </summary>
+            QuadroSyncExecuteCommandPacket,
+
+            /// <summary>
+            /// Changes the swap group and barrier membership and the frame counter used with as few NvAPI calls as
+            /// possible, rolling back on failure.  Data is the value returned by
+            /// <see cref="GetReconfigureArgument"/>.
+            /// </summary>
+            QuadroSyncReconfigure
+        }
+
+        /// <summary>
+        /// Settings that can be changed from any thread with <see cref="PostConfigurationChange"/>.
+        /// </summary>
+        public enum ConfigurationSetting
+        {
+            /// <summary>
+            /// Same as <see cref="EQuadroSyncRenderEvent.QuadroSyncEnableSystem"/>.
+            /// </summary>
+            System = 0,
+            /// <summary>
+            /// Same as <see cref="EQuadroSyncRenderEvent.QuadroSyncEnableSwapGroup"/>.
+            /// </summary>
+            SwapGroup = 1,
+            /// <summary>
+            /// Same as <see cref="EQuadroSyncRenderEvent.QuadroSyncEnableSwapBarrier"/>.
+            /// </summary>
+            SwapBarrier = 2,
+            /// <summary>
+            /// Same as <see cref="EQuadroSyncRenderEvent.QuadroSyncEnableSyncCounter"/>.
+            /// </summary>
+            SyncCounter = 3,
         }
 
         /// <summary>
@@ -88,6 +125,84 @@ public enum BarrierWarmupAction
             BarrierWarmedUp
         }
 
+        /// <summary>
+        /// How log messages of the plugin are delivered to the log callback.
+        /// </summary>
+        public enum LogDeliveryMode
+        {
+            /// <summary>
+            /// A background thread of the plugin delivers the log messages every few milliseconds.
+            /// </summary>
+            DrainThread = 0,
+            /// <summary>
+            /// Log messages are only delivered when <see cref="FlushLogs"/> is called.
+            /// </summary>
+            Polled = 1
+        }
+
+        /// <summary>
+        /// Severity of the log messages of the plugin.
+        /// </summary>
+        public enum LogLevel
+        {
+            /// <summary>
+            /// Detailed messages only useful when investigating a problem.
+            /// </summary>
+            Debug = 0,
+            /// <summary>
+            /// Regular log messages.
+            /// </summary>
+            Info = 1,
+            /// <summary>
+            /// Something unexpected that the plugin recovered from.
+            /// </summary>
+            Warning = 2,
+            /// <summary>
+            /// Something failed.
+            /// </summary>
+            Error = 3,
+            /// <summary>
+            /// No message at all.
+            /// </summary>
+            None = 4
+        }
+
+        /// <summary>
+        /// Subsystems of the plugin producing log messages.
+        /// </summary>
+        [Flags]
+        public enum LogCategories
+        {
+            /// <summary>
+            /// No category.
+            /// </summary>
+            None = 0,
+            /// <summary>
+            /// Initialization, joining / leaving swap groups and barriers and shutdown.
+            /// </summary>
+            Init = 1 << 0,
+            /// <summary>
+            /// Presenting frames.
+            /// </summary>
+            Present = 1 << 1,
+            /// <summary>
+            /// Swap barrier warmup.
+            /// </summary>
+            Warmup = 1 << 2,
+            /// <summary>
+            /// Graphics device and swap chain.
+            /// </summary>
+            Device = 1 << 3,
+            /// <summary>
+            /// Result of NvAPI calls.
+            /// </summary>
+            NvApi = 1 << 4,
+            /// <summary>
+            /// Every category.
+            /// </summary>
+            All = Init | Present | Warmup | Device | NvApi
+        }
+
         internal static class GfxPluginQuadroSyncUtilities
         {
 #if UNITY_EDITOR_WIN
@@ -108,11 +223,83 @@ internal static class GfxPluginQuadroSyncUtilities
             public static extern void SetLogCallback(
                 [MarshalAs(UnmanagedType.FunctionPtr)] NewLogMessageCallback newLogMessageCallback);
 
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void SetLogDeliveryMode(LogDeliveryMode deliveryMode);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern uint FlushLogs();
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void SetLogLevel(LogLevel level);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void SetLogCategoryMask(LogCategories mask);
+
             [DllImport(k_DLLPath, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.StdCall)]
             public static extern void SetBarrierWarmupCallback(IntPtr barrierWarmupCallback);
 
             [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
-            public static extern void GetState(ref GfxPluginQuadroSyncState state);
+            public static extern void SetPresentStallWatchdog(uint thresholdMs, uint skipSynchronizationOnStall);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void SetBarrierWarmupPolicy(ref GfxPluginQuadroSyncBarrierWarmupSettings settings);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall, EntryPoint = "SetBarrierWarmupPolicy")]
+            public static extern void ClearBarrierWarmupPolicy(IntPtr settings);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool GetBarrierWarmupReport(out GfxPluginQuadroSyncBarrierWarmupReport report);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool GetSwapChainChangeReport(out GfxPluginQuadroSyncSwapChainReport report);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool GetDeviceRecoveryReport(out GfxPluginQuadroSyncDeviceRecoveryReport report);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern void SetBarrierWarmupActionSlot(uint enable);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool PostBarrierWarmupAction(uint action);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern ulong GetBarrierWarmupPresentSequence();
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool SetSwapGroupIds(uint swapGroupId, uint swapBarrierId);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern uint PostConfigurationChange(ConfigurationSetting setting, uint enable);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern uint GetAppliedConfigurationEpoch();
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool GetState(ref GfxPluginQuadroSyncState state);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern IntPtr GetStateMirror();
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool GetSwapGroupSnapshot(out GfxPluginQuadroSyncSnapshot snapshot);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern ulong GetFrameCount(out GfxPluginQuadroSyncFrameCountConfidence confidence);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            public static extern bool SetTelemetryExport([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+            [DllImport(k_DLLPath, CallingConvention = CallingConvention.StdCall)]
+            public static extern unsafe uint ReadPresentTimings(GfxPluginQuadroSyncPresentTiming* buffer, uint capacity,
+                out ulong dropped);
         }
 
         static GfxPluginQuadroSyncSystem()
@@ -136,12 +323,61 @@ public static void DisableLogging()
             GfxPluginQuadroSyncUtilities.SetLogCallback(null);
         }
 
+        /// <summary>
+        /// Sets how log messages of the plugin are delivered.
+        /// </summary>
+        /// <param name="deliveryMode">The delivery mode.</param>
+        /// <remarks>Log messages are queued by the thread producing them (often the render thread) and delivered later
+        /// to avoid calling managed code from the middle of a present.</remarks>
+        public static void SetLogDeliveryMode(LogDeliveryMode deliveryMode)
+        {
+            GfxPluginQuadroSyncUtilities.SetLogDeliveryMode(deliveryMode);
+        }
+
+        /// <summary>
+        /// Delivers the queued log messages of the plugin from the calling thread.
+        /// </summary>
+        /// <returns>Number of messages delivered.</returns>
+        /// <remarks>Needs to be called regularly when using <see cref="LogDeliveryMode.Polled"/> (messages produced
+        /// while the queue is full are dropped).</remarks>
+        public static int FlushLogs()
+        {
+            return (int)GfxPluginQuadroSyncUtilities.FlushLogs();
+        }
+
+        /// <summary>
+        /// Sets the minimum level of the log messages produced by the plugin.
+        /// </summary>
+        /// <param name="level">The minimum level.</param>
+        /// <remarks>Messages with a lower level are not even produced.  Levels lower than the one the plugin was built
+        /// with are always filtered out.</remarks>
+        public static void SetLogLevel(LogLevel level)
+        {
+            GfxPluginQuadroSyncUtilities.SetLogLevel(level);
+        }
+
+        /// <summary>
+        /// Sets the subsystems of the plugin for which log messages are produced.
+        /// </summary>
+        /// <param name="categories">The categories of log messages to produce.</param>
+        public static void SetLogCategories(LogCategories categories)
+        {
+            GfxPluginQuadroSyncUtilities.SetLogCategoryMask(categories);
+        }
+
         static void ClearCallbacks()
         {
             GfxPluginQuadroSyncUtilities.SetLogCallback(null);
             GfxPluginQuadroSyncUtilities.SetBarrierWarmupCallback(IntPtr.Zero);
         }
 
+        /// <summary>
+        /// Is QuadroSync supported by the graphics device (are QuadroSync commands executed).
+        /// </summary>
+        internal static bool IsGraphicsDeviceSupported =>
+            SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D11 ||
+            SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D12;
+
         /// <summary>
         /// Executes a CommandBuffer related to the EQuadroSyncRenderEvent.
         /// </summary>
@@ -149,15 +385,66 @@ static void ClearCallbacks()
         /// <param name="data"> Data bound to the executed command.</param>
         public static void ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent id, IntPtr data)
         {
-            var cmdBuffer = new CommandBuffer();
-
-            if (SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D11 ||
-                SystemInfo.graphicsDeviceType == GraphicsDeviceType.Direct3D12)
+            if (!IsGraphicsDeviceSupported)
             {
-                cmdBuffer.IssuePluginEventAndData(GfxPluginQuadroSyncUtilities.GetRenderEventFunc(), (int)id, data);
+                return;
             }
 
-            Graphics.ExecuteCommandBuffer(cmdBuffer);
+            // Graphics.ExecuteCommandBuffer copies the commands, so the same CommandBuffer can be reused for every
+            // command.
+            s_CommandBuffer ??= new CommandBuffer {name = "QuadroSync"};
+            s_CommandBuffer.Clear();
+            s_CommandBuffer.IssuePluginEventAndData(GfxPluginQuadroSyncUtilities.GetRenderEventFunc(), (int)id, data);
+            Graphics.ExecuteCommandBuffer(s_CommandBuffer);
+        }
+        static CommandBuffer s_CommandBuffer;
+
+        /// <summary>
+        /// Packs the argument of <see cref="EQuadroSyncRenderEvent.QuadroSyncReconfigure"/>.
+        /// </summary>
+        /// <param name="swapGroupId">Swap group to join (0 to leave the swap group).</param>
+        /// <param name="swapBarrierId">Swap barrier to bind the swap group to (0 to unbind).</param>
+        /// <param name="useHardwareFrameCounter">Use the hardware frame counter (as opposed to the custom frame
+        /// counter).</param>
+        /// <returns>The argument (to pass to <see cref="QuadroSyncCommandPacket.Add(EQuadroSyncRenderEvent, ulong)"/>
+        /// or <see cref="Reconfigure"/>).</returns>
+        public static ulong GetReconfigureArgument(ushort swapGroupId, ushort swapBarrierId,
+            bool useHardwareFrameCounter)
+        {
+            // Must match SwapGroupConfiguration::Unpack in QuadroSync.h
+            return swapGroupId | ((ulong)swapBarrierId << 16) | (useHardwareFrameCounter ? 1ul << 32 : 0);
+        }
+
+        /// <summary>
+        /// Changes the swap group and barrier membership and the frame counter used with as few NvAPI calls as
+        /// possible.
+        /// </summary>
+        /// <param name="swapGroupId">Swap group to join (0 to leave the swap group).</param>
+        /// <param name="swapBarrierId">Swap barrier to bind the swap group to (0 to unbind).</param>
+        /// <param name="useHardwareFrameCounter">Use the hardware frame counter (as opposed to the custom frame
+        /// counter).</param>
+        /// <remarks>Only the changes from the current membership are made and the swap barrier is only warmed up again
+        /// if it is bound by the call.  Changes made are rolled back if one fails.</remarks>
+        public static void Reconfigure(ushort swapGroupId, ushort swapBarrierId, bool useHardwareFrameCounter)
+        {
+            ExecuteQuadroSyncCommand(EQuadroSyncRenderEvent.QuadroSyncReconfigure,
+                new IntPtr((long)GetReconfigureArgument(swapGroupId, swapBarrierId, useHardwareFrameCounter)));
+        }
+
+        /// <summary>
+        /// Selects the swap group and barrier joined by <see cref="EQuadroSyncRenderEvent.QuadroSyncInitialize"/> and
+        /// the enable commands (1 and 1 by default).
+        /// </summary>
+        /// <param name="swapGroupId">Swap group to join (&gt; 0).</param>
+        /// <param name="swapBarrierId">Swap barrier to bind the swap group to (0 to only join the swap group).</param>
+        /// <returns>Were the ids accepted (they are validated against the maximums reported by the driver once
+        /// initialized).</returns>
+        /// <remarks>Nodes of independent walls sharing the same sync chain can use different barriers so that they
+        /// are not paced by each other.  Does not change the swap group and barrier already joined, see
+        /// <see cref="Reconfigure"/> for that.</remarks>
+        public static bool SetSwapGroupIds(ushort swapGroupId, ushort swapBarrierId)
+        {
+            return GfxPluginQuadroSyncUtilities.SetSwapGroupIds(swapGroupId, swapBarrierId);
         }
 
         /// <summary>
@@ -177,6 +464,137 @@ public static void SetBarrierWarmupCallback(Func<BarrierWarmupAction> func)
         // ReSharper disable once NotAccessedField.Local -> See comment in SetBarrierWarmupCallback
         static Func<BarrierWarmupAction> s_SetBarrierWarmupCallback;
 
+        /// <summary>
+        /// Lets the plugin decide by itself when the swap barrier is warmed up: presents are repeated until the
+        /// hardware frame counter advances by one frame per present at a steady interval, without calling the
+        /// callback set with <see cref="SetBarrierWarmupCallback"/>.
+        /// </summary>
+        /// <param name="settings">Tolerances of the decision (<see langword="null"/> to go back to the
+        /// callback).</param>
+        /// <remarks>Used by the next warmup.  Its outcome can be followed with
+        /// <see cref="GetBarrierWarmupReport"/>.</remarks>
+        public static void SetBarrierWarmupPolicy(GfxPluginQuadroSyncBarrierWarmupSettings? settings)
+        {
+            if (settings.HasValue)
+            {
+                var value = settings.Value;
+                GfxPluginQuadroSyncUtilities.SetBarrierWarmupPolicy(ref value);
+            }
+            else
+            {
+                GfxPluginQuadroSyncUtilities.ClearBarrierWarmupPolicy(IntPtr.Zero);
+            }
+        }
+
+        /// <summary>
+        /// Gets the progress and outcome of the last barrier warmup decided by the plugin (see
+        /// <see cref="SetBarrierWarmupPolicy"/>).
+        /// </summary>
+        /// <remarks>Can be called from any thread and returns immediately.</remarks>
+        public static GfxPluginQuadroSyncBarrierWarmupReport GetBarrierWarmupReport()
+        {
+            GfxPluginQuadroSyncUtilities.GetBarrierWarmupReport(out var report);
+            return report;
+        }
+
+        /// <summary>
+        /// Gets the swap chain changes (on resolution or fullscreen changes) detected by the plugin and how long the
+        /// node was out of sync because of them.
+        /// </summary>
+        /// <remarks>Can be called from any thread and returns immediately.</remarks>
+        public static GfxPluginQuadroSyncSwapChainReport GetSwapChainChangeReport()
+        {
+            GfxPluginQuadroSyncUtilities.GetSwapChainChangeReport(out var report);
+            return report;
+        }
+
+        /// <summary>
+        /// Gets the progress of the recovery from failed presents (like after a TDR, the plugin joins the swap group and
+        /// barrier again on its own) and how long recoveries took.
+        /// </summary>
+        /// <remarks>Can be called from any thread and returns immediately.</remarks>
+        public static GfxPluginQuadroSyncDeviceRecoveryReport GetDeviceRecoveryReport()
+        {
+            GfxPluginQuadroSyncUtilities.GetDeviceRecoveryReport(out var report);
+            return report;
+        }
+
+        /// <summary>
+        /// Makes the plugin read warmup decisions posted with <see cref="PostBarrierWarmupAction"/> instead of calling
+        /// the callback set with <see cref="SetBarrierWarmupCallback"/>, so that the rendering thread never waits on
+        /// managed code during the warmup.
+        /// </summary>
+        /// <param name="enable">Read posted actions (<see langword="false"/> to go back to the callback).</param>
+        /// <remarks>Ignored while a policy is set with <see cref="SetBarrierWarmupPolicy"/>.  Until something is
+        /// posted, warmup presents behave as <see cref="BarrierWarmupAction.ContinueToNextFrame"/>.</remarks>
+        public static void SetBarrierWarmupActionSlot(bool enable)
+        {
+            GfxPluginQuadroSyncUtilities.SetBarrierWarmupActionSlot(enable ? 1u : 0u);
+        }
+
+        /// <summary>
+        /// Posts what the plugin must do after the next warmup presents.
+        /// </summary>
+        /// <param name="action">The action, <see cref="BarrierWarmupAction.RepeatPresent"/> and
+        /// <see cref="BarrierWarmupAction.ContinueToNextFrame"/> stay posted until replaced while
+        /// <see cref="BarrierWarmupAction.BarrierWarmedUp"/> is consumed by the warmup it concludes.</param>
+        /// <remarks>Can be called from any thread and returns immediately.</remarks>
+        public static void PostBarrierWarmupAction(BarrierWarmupAction action)
+        {
+            GfxPluginQuadroSyncUtilities.PostBarrierWarmupAction((uint)action);
+        }
+
+        /// <summary>
+        /// Number of warmup presents done so far (to follow the progress of the warmup).
+        /// </summary>
+        /// <remarks>Can be called from any thread and returns immediately.</remarks>
+        public static ulong GetBarrierWarmupPresentSequence()
+        {
+            return GfxPluginQuadroSyncUtilities.GetBarrierWarmupPresentSequence();
+        }
+
+        /// <summary>
+        /// Starts (or stops) watching for presents blocked in the swap barrier for too long (typically because a node
+        /// of the cluster stopped presenting).
+        /// </summary>
+        /// <param name="thresholdMilliseconds">Presents blocked for longer than this are stalled (0 to stop
+        /// watching).</param>
+        /// <param name="skipSynchronizationOnStall">Skip the synchronized present of the frame following a stalled
+        /// present (Unity presents it normally, without waiting on the other nodes).</param>
+        /// <remarks>Stalls are counted in <see cref="GfxPluginQuadroSyncState.PresentStallCount"/> and flagged with
+        /// <see cref="GfxPluginQuadroSyncPresentTimingFlags.Stalled"/> in the present timings.</remarks>
+        public static void SetPresentStallWatchdog(int thresholdMilliseconds, bool skipSynchronizationOnStall)
+        {
+            GfxPluginQuadroSyncUtilities.SetPresentStallWatchdog((uint)Math.Max(thresholdMilliseconds, 0),
+                skipSynchronizationOnStall ? 1u : 0u);
+        }
+
+        /// <summary>
+        /// Changes a setting of QuadroSync from any thread, without going through a render event.
+        /// </summary>
+        /// <param name="setting">The setting to change.</param>
+        /// <param name="enable">New value of the setting.</param>
+        /// <returns>Epoch of the change, applied once <see cref="IsConfigurationChangeApplied"/> returns true for
+        /// it.</returns>
+        /// <remarks>Changes are applied by the render thread before presenting the next frame (or while executing the
+        /// next enable command, like <see cref="EQuadroSyncRenderEvent.QuadroSyncEnableSystem"/>), in the order they
+        /// were posted.</remarks>
+        public static uint PostConfigurationChange(ConfigurationSetting setting, bool enable)
+        {
+            return GfxPluginQuadroSyncUtilities.PostConfigurationChange(setting, enable ? 1u : 0u);
+        }
+
+        /// <summary>
+        /// Is the change returned by <see cref="PostConfigurationChange"/> (or a later change of the same setting)
+        /// in effect.
+        /// </summary>
+        /// <param name="epoch">Value returned by <see cref="PostConfigurationChange"/>.</param>
+        public static bool IsConfigurationChangeApplied(uint epoch)
+        {
+            // Epochs wrap around
+            return unchecked((int)(GfxPluginQuadroSyncUtilities.GetAppliedConfigurationEpoch() - epoch)) >= 0;
+        }
+
         /// <summary>
         /// Fetch the state of GfxPluginQuadroSync.
         /// </summary>
@@ -185,9 +603,132 @@ public static void SetBarrierWarmupCallback(Func<BarrierWarmupAction> func)
         /// latest value is done every time the method is called.</remarks>
         public static GfxPluginQuadroSyncState FetchState()
         {
-            var toReturn = new GfxPluginQuadroSyncState();
+            var toReturn = new GfxPluginQuadroSyncState((uint)Marshal.SizeOf<GfxPluginQuadroSyncState>());
             GfxPluginQuadroSyncUtilities.GetState(ref toReturn);
             return toReturn;
         }
+
+        /// <summary>
+        /// Read the state of GfxPluginQuadroSync from the state mirror published by the plugin.
+        /// </summary>
+        /// <returns>The state of GfxPluginQuadroSync</returns>
+        /// <remarks>Does not call into the plugin (except the first time, to get the address of the mirror), so it is
+        /// cheap enough to be called every frame from any thread.  The mirror is updated by the plugin after every
+        /// present and every QuadroSync command, so it can be slightly older than what <see cref="FetchState"/>
+        /// returns.</remarks>
+        public static GfxPluginQuadroSyncState ReadState()
+        {
+            unsafe
+            {
+                if (s_StateMirror == null)
+                {
+                    var stateMirror = (ulong*)GfxPluginQuadroSyncUtilities.GetStateMirror();
+                    // Layout: 64 bits sequence number followed by the state.  A plugin publishing a smaller (older)
+                    // state cannot be read directly.
+                    if (stateMirror == null ||
+                        ((GfxPluginQuadroSyncState*)(stateMirror + 1))->Size < sizeof(GfxPluginQuadroSyncState))
+                    {
+                        return FetchState();
+                    }
+                    s_StateMirror = stateMirror;
+                }
+
+                var statePtr = (GfxPluginQuadroSyncState*)(s_StateMirror + 1);
+                for (;;)
+                {
+                    // Odd sequence number: the plugin is modifying the state
+                    var sequence = Volatile.Read(ref *s_StateMirror);
+                    if ((sequence & 1) == 0)
+                    {
+                        var toReturn = *statePtr;
+                        Interlocked.MemoryBarrier();
+                        if (Volatile.Read(ref *s_StateMirror) == sequence)
+                        {
+                            return toReturn;
+                        }
+                    }
+                    Thread.Yield();
+                }
+            }
+        }
+        static unsafe ulong* s_StateMirror;
+
+        /// <summary>
+        /// Gets the frame count, the swap group and barrier membership and the result of the last present.
+        /// </summary>
+        /// <returns>The last values published by the plugin.</returns>
+        /// <remarks>Can be called from any thread and returns immediately (does not go through a render event as
+        /// <see cref="EQuadroSyncRenderEvent.QuadroSyncQueryFrameCount"/> does).</remarks>
+        public static GfxPluginQuadroSyncSnapshot GetSwapGroupSnapshot()
+        {
+            GfxPluginQuadroSyncUtilities.GetSwapGroupSnapshot(out var snapshot);
+            return snapshot;
+        }
+
+        /// <summary>
+        /// Gets the frame count (hardware frame counter or custom frame counter) at the time of the call.
+        /// </summary>
+        /// <param name="confidence">How much the returned value can be trusted.</param>
+        /// <returns>The frame count.</returns>
+        /// <remarks>Can be called from any thread and returns immediately (does not go through a render event as
+        /// <see cref="EQuadroSyncRenderEvent.QuadroSyncQueryFrameCount"/> does).  The hardware frame counter is
+        /// extrapolated from its last sample and, unlike the render event, the custom frame counter is not
+        /// incremented.</remarks>
+        public static ulong GetFrameCount(out GfxPluginQuadroSyncFrameCountConfidence confidence)
+        {
+            return GfxPluginQuadroSyncUtilities.GetFrameCount(out confidence);
+        }
+
+        /// <summary>
+        /// Default name of the shared memory in which <see cref="EnableTelemetryExport"/> publishes.
+        /// </summary>
+        public const string DefaultTelemetryExportName = "Local\\UnityClusterDisplayQuadroSync";
+
+        /// <summary>
+        /// Starts publishing the state of the plugin and the timing of the recent presents in a named shared memory, so
+        /// that monitoring processes on the same computer can follow the health of the swap barrier without querying
+        /// Unity.
+        /// </summary>
+        /// <param name="name">Name of the shared memory.</param>
+        /// <returns>Success.</returns>
+        /// <remarks>The layout of the shared memory is documented with TelemetryHeader in the plugin's
+        /// TelemetryExport.h.  It is updated after every present.</remarks>
+        public static bool EnableTelemetryExport(string name = DefaultTelemetryExportName)
+        {
+            if (string.IsNullOrEmpty(name))
+            {
+                throw new ArgumentException("Name of the shared memory cannot be empty.", nameof(name));
+            }
+            return GfxPluginQuadroSyncUtilities.SetTelemetryExport(name);
+        }
+
+        /// <summary>
+        /// Stops publishing in the shared memory started by <see cref="EnableTelemetryExport"/>.
+        /// </summary>
+        public static void DisableTelemetryExport()
+        {
+            GfxPluginQuadroSyncUtilities.SetTelemetryExport(null);
+        }
+
+        /// <summary>
+        /// Read the timing of the presents done since the last call to this method.
+        /// </summary>
+        /// <param name="timings">Where to store the timings.</param>
+        /// <param name="dropped">Total number of timings that were overwritten before being read (because this method
+        /// was not called often enough).</param>
+        /// <returns>Number of timings stored in <paramref name="timings"/>.</returns>
+        /// <remarks>The plugin keeps the timing of the last 512 presents.  This method is expected to always be called
+        /// from the same thread.</remarks>
+        public static int ReadPresentTimings(Span<GfxPluginQuadroSyncPresentTiming> timings, out ulong dropped)
+        {
+            unsafe
+            {
+                fixed (GfxPluginQuadroSyncPresentTiming* timingsPtr = timings)
+                {
+                    return (int)GfxPluginQuadroSyncUtilities.ReadPresentTimings(timingsPtr, (uint)timings.Length,
+                        out dropped);
+                }
+            }
+        }
     }
 }
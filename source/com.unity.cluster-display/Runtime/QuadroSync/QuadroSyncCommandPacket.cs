@@ -0,0 +1,288 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Unity.ClusterDisplay
+{
+    /// <summary>
+    /// Status of a command of a <see cref="QuadroSyncCommandPacket"/>.
+    /// </summary>
+    public enum QuadroSyncCommandStatus : uint
+    {
+        /// <summary>
+        /// Not executed yet.
+        /// </summary>
+        Pending = 0,
+        /// <summary>
+        /// Command executed successfully.
+        /// </summary>
+        Succeeded = 1,
+        /// <summary>
+        /// Command failed.
+        /// </summary>
+        Failed = 2,
+        /// <summary>
+        /// Command unknown to the plugin (or not allowed in a command packet).
+        /// </summary>
+        UnknownCommand = 3,
+        /// <summary>
+        /// Not executed because a previous command of the packet failed.
+        /// </summary>
+        Skipped = 4,
+    }
+
+    /// <summary>
+    /// Sequence of QuadroSync commands (with their argument and result) executed in order by the plugin in a single
+    /// render event.
+    /// </summary>
+    /// <remarks>The packet lives in native memory that is reused every time it is executed: commands cannot be added
+    /// and the packet cannot be executed again while <see cref="IsPending"/>.</remarks>
+    public sealed class QuadroSyncCommandPacket : IDisposable
+    {
+        /// <summary>
+        /// Creates an empty packet.
+        /// </summary>
+        /// <param name="capacity">Maximum number of commands in the packet.</param>
+        /// <param name="stopOnFailure">Skip the commands following a command that failed.</param>
+        public QuadroSyncCommandPacket(int capacity = 16, bool stopOnFailure = true)
+        {
+            if (capacity <= 0 || capacity > k_MaxCommandCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+            }
+
+            Capacity = capacity;
+            m_StopOnFailure = stopOnFailure;
+            unsafe
+            {
+                m_Packet = Marshal.AllocHGlobal(sizeof(Header) + capacity * sizeof(Command));
+            }
+            Clear();
+        }
+
+        /// <summary>
+        /// Maximum number of commands in the packet.
+        /// </summary>
+        public int Capacity { get; }
+
+        /// <summary>
+        /// Number of commands in the packet.
+        /// </summary>
+        public int Count { get; private set; }
+
+        /// <summary>
+        /// Has the packet been executed but not yet processed by the plugin.
+        /// </summary>
+        public bool IsPending
+        {
+            get
+            {
+                unsafe
+                {
+                    return m_Packet != IntPtr.Zero &&
+                        Volatile.Read(ref ((Header*)m_Packet)->ProcessedCount) == k_NotProcessed && m_Executed;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Adds a command to the packet.
+        /// </summary>
+        /// <param name="id">The command.</param>
+        /// <param name="argument">Argument of the command (the data of the equivalent render event).</param>
+        /// <returns>Index of the command in the packet (to get its status and result).</returns>
+        public int Add(GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent id, ulong argument = 0)
+        {
+            ThrowIfPendingOrDisposed();
+            if (id == GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent.QuadroSyncExecuteCommandPacket)
+            {
+                throw new ArgumentException("Command packets cannot be nested.", nameof(id));
+            }
+            if (Count == Capacity)
+            {
+                throw new InvalidOperationException("Command packet is full.");
+            }
+
+            unsafe
+            {
+                var header = (Header*)m_Packet;
+                var command = (Command*)(header + 1) + Count;
+                command->Id = (uint)id;
+                command->Status = QuadroSyncCommandStatus.Pending;
+                command->Argument = argument;
+                command->Result = 0;
+                header->CommandCount = (uint)(Count + 1);
+            }
+            return Count++;
+        }
+
+        /// <summary>
+        /// Adds a command with a boolean argument to the packet.
+        /// </summary>
+        /// <param name="id">The command.</param>
+        /// <param name="value">Argument of the command.</param>
+        /// <returns>Index of the command in the packet (to get its status and result).</returns>
+        public int Add(GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent id, bool value) => Add(id, value ? 1ul : 0ul);
+
+        /// <summary>
+        /// Removes every command from the packet.
+        /// </summary>
+        public void Clear()
+        {
+            ThrowIfPendingOrDisposed();
+            unsafe
+            {
+                var header = (Header*)m_Packet;
+                header->Version = k_Version;
+                header->Flags = m_StopOnFailure ? k_StopOnFailureFlag : 0;
+                header->CommandCount = 0;
+                header->ProcessedCount = k_NotProcessed;
+            }
+            Count = 0;
+            m_Executed = false;
+        }
+
+        /// <summary>
+        /// Asks the plugin to execute the commands of the packet (from the render thread, in a single render event).
+        /// </summary>
+        /// <returns>False if QuadroSync is not supported by the graphics device (the packet is then not executed).
+        /// </returns>
+        public bool Execute()
+        {
+            ThrowIfPendingOrDisposed();
+            if (!GfxPluginQuadroSyncSystem.IsGraphicsDeviceSupported)
+            {
+                return false;
+            }
+
+            unsafe
+            {
+                var header = (Header*)m_Packet;
+                var commands = (Command*)(header + 1);
+                for (int i = 0; i < Count; ++i)
+                {
+                    commands[i].Status = QuadroSyncCommandStatus.Pending;
+                    commands[i].Result = 0;
+                }
+                Volatile.Write(ref header->ProcessedCount, k_NotProcessed);
+            }
+            m_Executed = true;
+            GfxPluginQuadroSyncSystem.ExecuteQuadroSyncCommand(
+                GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent.QuadroSyncExecuteCommandPacket, m_Packet);
+            return true;
+        }
+
+        /// <summary>
+        /// Status of a command.
+        /// </summary>
+        /// <param name="index">Index of the command (as returned by Add).</param>
+        /// <returns>Status of the command (<see cref="QuadroSyncCommandStatus.Pending"/> while
+        /// <see cref="IsPending"/>).</returns>
+        public QuadroSyncCommandStatus GetStatus(int index)
+        {
+            if (IsPending)
+            {
+                return QuadroSyncCommandStatus.Pending;
+            }
+            unsafe
+            {
+                return GetCommand(index)->Status;
+            }
+        }
+
+        /// <summary>
+        /// Result of a command (for commands producing one, like
+        /// <see cref="GfxPluginQuadroSyncSystem.EQuadroSyncRenderEvent.QuadroSyncQueryFrameCount"/>).
+        /// </summary>
+        /// <param name="index">Index of the command (as returned by Add).</param>
+        /// <returns>Result of the command (0 while <see cref="IsPending"/>).</returns>
+        public long GetResult(int index)
+        {
+            if (IsPending)
+            {
+                return 0;
+            }
+            unsafe
+            {
+                return GetCommand(index)->Result;
+            }
+        }
+
+        /// <summary>
+        /// Frees the native memory of the packet.
+        /// </summary>
+        /// <remarks>If the packet is still pending its memory is never freed (the plugin will still access it).
+        /// </remarks>
+        public void Dispose()
+        {
+            if (m_Packet == IntPtr.Zero)
+            {
+                return;
+            }
+
+            if (IsPending)
+            {
+                ClusterDebug.LogWarning("QuadroSyncCommandPacket disposed while pending, leaking its memory.");
+            }
+            else
+            {
+                Marshal.FreeHGlobal(m_Packet);
+            }
+            m_Packet = IntPtr.Zero;
+        }
+
+        unsafe Command* GetCommand(int index)
+        {
+            if (m_Packet == IntPtr.Zero)
+            {
+                throw new ObjectDisposedException(nameof(QuadroSyncCommandPacket));
+            }
+            if (index < 0 || index >= Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+            return (Command*)((Header*)m_Packet + 1) + index;
+        }
+
+        void ThrowIfPendingOrDisposed()
+        {
+            if (m_Packet == IntPtr.Zero)
+            {
+                throw new ObjectDisposedException(nameof(QuadroSyncCommandPacket));
+            }
+            if (IsPending)
+            {
+                throw new InvalidOperationException("Command packet is still being executed.");
+            }
+        }
+
+        // Mirrors CommandPacketHeader in CommandPacket.h
+        [StructLayout(LayoutKind.Sequential)]
+        struct Header
+        {
+            public uint Version;
+            public uint Flags;
+            public uint CommandCount;
+            public uint ProcessedCount;
+        }
+
+        // Mirrors QuadroSyncCommand in CommandPacket.h
+        [StructLayout(LayoutKind.Sequential)]
+        struct Command
+        {
+            public uint Id;
+            public QuadroSyncCommandStatus Status;
+            public ulong Argument;
+            public long Result;
+        }
+
+        const uint k_Version = 1;
+        const uint k_StopOnFailureFlag = 1;
+        const uint k_NotProcessed = uint.MaxValue;
+        const int k_MaxCommandCount = 1024;
+
+        readonly bool m_StopOnFailure;
+        IntPtr m_Packet;
+        bool m_Executed;
+    }
+}
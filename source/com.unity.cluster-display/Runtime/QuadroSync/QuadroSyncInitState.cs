@@ -22,7 +22,15 @@ protected override (NodeState, DoFrameResult?) DoFrameImplementation()
                 QualitySettings.vSyncCount = 1;
                 QualitySettings.maxQueuedFrames = 1;
 
-                ClusterDebug.Log("Initializing Quadro Sync.");
+                var swapGroupId = Node.Config.SwapGroupId > 0 ? Node.Config.SwapGroupId : 1;
+                var swapBarrierId = Node.Config.SwapBarrierId > 0 ? Node.Config.SwapBarrierId : 1;
+                if (swapGroupId > ushort.MaxValue || swapBarrierId > ushort.MaxValue ||
+                    !GfxPluginQuadroSyncSystem.SetSwapGroupIds((ushort)swapGroupId, (ushort)swapBarrierId))
+                {
+                    ClusterDebug.LogError($"Invalid swap group / barrier: {swapGroupId} / {swapBarrierId}.");
+                }
+
+                ClusterDebug.Log($"Initializing Quadro Sync (swap group {swapGroupId} / barrier {swapBarrierId}).");
 #if UNITY_EDITOR
                 ClusterDebug.Log("You are attempting to initialize Quadro Sync swap barriers in the Editor. This will likely fail.");
 #endif
@@ -95,7 +103,7 @@ protected void SetBarrierWarmupCallback(Func<GfxPluginQuadroSyncSystem.BarrierWa
 
         void ProcessQuadroSyncInitResult()
         {
-            InitializationState = GfxPluginQuadroSyncSystem.FetchState().InitializationState;
+            InitializationState = GfxPluginQuadroSyncSystem.ReadState().InitializationState;
             if (InitializationState != GfxPluginQuadroSyncInitializationState.NotInitialized)
             {
                 Node.UsingNetworkSync = (InitializationState != GfxPluginQuadroSyncInitializationState.Initialized);